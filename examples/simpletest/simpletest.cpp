@@ -163,6 +163,10 @@ int main(void)
     window = xtract_init_window(BLOCKSIZE, XTRACT_HANN);
     window_subframe = xtract_init_window(HALF_BLOCKSIZE, XTRACT_HANN);
     xtract_init_wavelet_f0_state();
+
+    /* set up the FFTs for both block sizes once, up front */
+    xtract_init_fft(BLOCKSIZE, XTRACT_SPECTRUM);
+    xtract_init_fft(HALF_BLOCKSIZE, XTRACT_SPECTRUM);
     
     // fill_wavetable(344.53125f, NOISE); // 344.53125f = 128 samples @ 44100 Hz
     // fill_wavetable(344.53125f, SINE); // 344.53125f = 128 samples @ 44100 Hz
@@ -198,9 +202,7 @@ int main(void)
         argd[2] = 0.f; /* DC component - we expect this to zero for square wave */
         argd[3] = 0.f; /* No Normalisation */
 
-        xtract_init_fft(BLOCKSIZE, XTRACT_SPECTRUM);
         xtract[XTRACT_SPECTRUM](windowed, BLOCKSIZE, &argd[0], spectrum);
-        xtract_free_fft();
 
         xtract[XTRACT_SPECTRAL_CENTROID](spectrum, BLOCKSIZE, NULL, &centroid);
 
@@ -246,9 +248,7 @@ int main(void)
         argd[3] = 1.f; /* Yes Normalisation */
         
         xtract_features_from_subframes(gated, BLOCKSIZE, XTRACT_WINDOWED, window_subframe, subframes_windowed);
-        xtract_init_fft(HALF_BLOCKSIZE, XTRACT_SPECTRUM);
         xtract_features_from_subframes(subframes_windowed, BLOCKSIZE, XTRACT_SPECTRUM, argd, subframes_spectrum);
-        xtract_free_fft();
         
         argd[0] = 0.5; /* smoothing factor */
         
@@ -293,6 +293,7 @@ int main(void)
 
     xtract_free_window(window);
     xtract_free_window(window_subframe);
+    xtract_free_fft();
     
     return 0;
 
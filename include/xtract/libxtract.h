@@ -64,6 +64,13 @@ extern "C" {
 #include "xtract_types.h"
 #include "xtract_macros.h"
 #include "xtract_helper.h"
+#include "xtract_context.h"
+#include "xtract_plan.h"
+#include "xtract_stream.h"
+#include "xtract_engine.h"
+#include "xtract_pipeline.h"
+#include "xtract_multichannel.h"
+#include "xtract_float.h"
 
 /** \defgroup libxtract API
   *
@@ -118,6 +125,7 @@ enum xtract_features_ {
     XTRACT_FAILSAFE_F0,
     XTRACT_WAVELET_F0,
     XTRACT_MCLEOD_F0,
+    XTRACT_YIN_F0,
     XTRACT_MIDICENT,
     XTRACT_LNORM,
     XTRACT_FLUX,
@@ -186,6 +194,14 @@ enum xtract_return_codes_ {
     XTRACT_ARGUMENT_ERROR
 };
 
+/** \brief Enumeration of FFT backends */
+enum xtract_fft_backends_ {
+    XTRACT_FFT_BACKEND_DEFAULT, /* The backend chosen at build time */
+    XTRACT_FFT_BACKEND_OOURA,   /* Ooura's fftsg, portable scalar C */
+    XTRACT_FFT_BACKEND_VDSP,    /* Apple's vDSP, only available on Apple platforms */
+    XTRACT_FFT_BACKEND_NATIVE   /* LibXtract's own FFT, vectorised for the CPU it runs on */
+};
+
 /** \brief Enumeration of spectrum types */
 enum xtract_spectrum_ {
     XTRACT_MAGNITUDE_SPECTRUM,
@@ -238,7 +254,8 @@ enum xtract_window_types_ {
     XTRACT_BARTLETT_HANN,
     XTRACT_BLACKMAN,
     XTRACT_KAISER,
-    XTRACT_BLACKMAN_HARRIS
+    XTRACT_BLACKMAN_HARRIS,
+    XTRACT_RECTANGULAR
 };
 
 /** \brief Enumeration of vector format types*/
@@ -377,10 +394,45 @@ extern int(*xtract[XTRACT_FEATURES])(const double *data, const int N, const void
 /** \brief A function to initialise wavelet f0 detector state */
 int xtract_init_wavelet_f0_state(void);
 
-/** \brief A structure to store a set of n_filters Mel filters */
+/** \brief Wavelet f0 tracker for a single stream, see xtract_wavelet_f0_state_new() */
+typedef struct xtract_wavelet_f0_state_ xtract_wavelet_f0_state;
+
+/** \brief Create a wavelet f0 tracker with its own tracking history and buffers
+ *
+ * The buffers for blocks of up to max_N samples are allocated here, so xtract_wavelet_f0_state_compute() makes no allocations. The wavelet levels and the highest frequency searched are set for the given sample rate rather than assuming 44100 Hz. Any number of states can be used from one thread, but a state must not be used by more than one thread at a time.
+ *
+ * \param max_N: the largest block size that will be passed to xtract_wavelet_f0_state_compute()
+ * \param samplerate: the audio sample rate
+ * \return a pointer to the new state, or NULL if the arguments are invalid or memory could not be allocated
+ */
+xtract_wavelet_f0_state *xtract_wavelet_f0_state_new(int max_N, double samplerate);
+
+/** \brief Free a state created by xtract_wavelet_f0_state_new() */
+void xtract_wavelet_f0_state_delete(xtract_wavelet_f0_state *state);
+
+/** \brief Forget the pitch history of a state, e.g. at the start of a new note or stream */
+void xtract_wavelet_f0_state_reset(xtract_wavelet_f0_state *state);
+
+/** \brief Track the fundamental frequency of the next block of a stream, as xtract_wavelet_f0()
+ *
+ * \param *state: a state as returned by xtract_wavelet_f0_state_new()
+ * \param *data: a pointer to N time domain samples
+ * \param N: the block size, which must not exceed the state's max_N
+ * \param *argv: a pointer to NULL
+ * \param *result: the pitch of the block, or 0 with XTRACT_NO_RESULT if no pitch was found
+ */
+int xtract_wavelet_f0_state_compute(xtract_wavelet_f0_state *state, const double *data, const int N, const void *argv, double *result);
+
+/** \brief A structure to store a set of n_filters Mel filters
+ *
+ * A filterbank is either dense or sparse. A dense filterbank has filters pointing to n_filters arrays of N coefficients, as populated by xtract_init_mfcc() or xtract_init_gfcc(). A sparse filterbank has filters set to NULL and stores filter k as length[k] coefficients in weights[k], applying to the bins from start[k]. Sparse filterbanks are created by xtract_init_mfcc_sparse() and xtract_init_gfcc_sparse() and only hold the bins where each filter is non-zero. The sparse fields are ignored when filters is not NULL.
+ */
 typedef struct xtract_mel_filter_ {
     int n_filters;
     double **filters;
+    int *start;
+    int *length;
+    double **weights;
 } xtract_mel_filter;
 
 /** \brief A function to initialise a mel filter bank 
@@ -402,6 +454,67 @@ int xtract_init_mfcc(int N, double nyquist, int style, double freq_min, double f
  */
 int xtract_init_gfcc(int N, double nyquist, double freq_min, double freq_max, int freq_bands, double **fft_tables);
 
+/** \brief Initialise a sparse mel filter bank
+ *
+ * Takes the same arguments as xtract_init_mfcc(), but allocates and populates filter in the sparse form described for xtract_mel_filter. The result must be released with xtract_free_mel_filter().
+ *
+ * \param *filter: a pointer to the filterbank to populate
+ */
+int xtract_init_mfcc_sparse(int N, double nyquist, int style, double freq_min, double freq_max, int freq_bands, xtract_mel_filter *filter);
+
+/** \brief Initialise a sparse gammatone filter bank
+ *
+ * Takes the same arguments as xtract_init_gfcc(), but allocates and populates filter in the sparse form described for xtract_mel_filter. Gammatone responses never reach zero, so each filter is cut off where its gain falls below 1e-6 of the peak. The result must be released with xtract_free_mel_filter().
+ *
+ * \param *filter: a pointer to the filterbank to populate
+ */
+int xtract_init_gfcc_sparse(int N, double nyquist, double freq_min, double freq_max, int freq_bands, xtract_mel_filter *filter);
+
+/** \brief Free the memory of a sparse filterbank created by xtract_init_mfcc_sparse() or xtract_init_gfcc_sparse() */
+void xtract_free_mel_filter(xtract_mel_filter *filter);
+
+/** \brief Precompiled MFCC/GFCC pipeline, see xtract_cepstrum_state_new() */
+typedef struct xtract_cepstrum_state_ xtract_cepstrum_state;
+
+/** \brief Compile a fused window, FFT, spectrum, filterbank, log and DCT pipeline
+ *
+ * The state holds the window, a sparse copy of the filterbank, the FFT and DCT plans and all scratch memory, so xtract_cepstrum() makes no allocations. Its result equals xtract_windowed(), then xtract_spectrum() with the given spectrum type and no DC or normalisation, then xtract_mfcc() over the first N/2 values. A state must not be used by more than one thread at a time.
+ *
+ * \param N: the frame size, which must be even
+ * \param window_type: the window, e.g. XTRACT_HANN
+ * \param spectrum_type: the spectrum the filterbank is applied to, e.g. XTRACT_MAGNITUDE_SPECTRUM or XTRACT_POWER_SPECTRUM
+ * \param *filter: a mel or gammatone filterbank of N/2 bins, in dense or sparse form. It is copied, so it may be freed afterwards
+ * \return a pointer to the new state, or NULL if the arguments are invalid or memory could not be allocated
+ */
+xtract_cepstrum_state *xtract_cepstrum_state_new(int N, int window_type, int spectrum_type, const xtract_mel_filter *filter);
+
+/** \brief Free a state created by xtract_cepstrum_state_new() */
+void xtract_cepstrum_state_delete(xtract_cepstrum_state *state);
+
+/** \brief Compute the cepstral coefficients of one frame with a precompiled pipeline
+ *
+ * \param *state: a state as returned by xtract_cepstrum_state_new()
+ * \param *data: a pointer to N time domain samples
+ * \param N: the frame size, which must match the state
+ * \param *argv: a pointer to NULL
+ * \param *result: a pointer to an array of n_filters doubles for the coefficients
+ */
+int xtract_cepstrum(xtract_cepstrum_state *state, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Compute the cepstral coefficients of many frames with a precompiled pipeline
+ *
+ * Frame f starts at data + f * hop, and its n_filters coefficients are written to result + f * n_filters.
+ *
+ * \param *state: a state as returned by xtract_cepstrum_state_new()
+ * \param *data: a pointer to the first sample of the first frame
+ * \param N: the frame size, which must match the state
+ * \param frames: the number of frames
+ * \param hop: the number of samples between the starts of successive frames
+ * \param *argv: a pointer to NULL
+ * \param *result: a pointer to an array of frames * n_filters doubles
+ */
+int xtract_cepstrum_batch(xtract_cepstrum_state *state, const double *data, const int N, const int frames, const int hop, const void *argv, double *result);
+
 /** \brief A function to initialise bark filter bounds
  * 
  * A pointer to an array of BARK_BANDS ints most be passed in, and is populated with BARK_BANDS fft bin numbers representing the limits of each band 
@@ -414,7 +527,7 @@ int xtract_init_bark(int N, double sr, int *band_limits);
 
 /** \brief An initialisation function for functions using FFT
  *
- * This function initialises global data structures used by functions requiring FFT functionality. It can be called multiple times with different feature names. Calling it more than once with the same feature name is not a valid operation and will result in a memory leak.
+ * This function prepares the FFT used by a given feature in the calling thread. It can be called multiple times with different feature names and with different sizes. Plans are kept in a process wide cache keyed by size and transform type, so each size is only set up once and its tables are shared by all threads. Once a feature has been initialised it may also be used with other sizes, which are added to the cache on first use. Any even size is supported: sizes other than powers of two use mixed radix (2, 3, 4 and 5) passes, or Bluestein's algorithm for sizes with larger prime factors, and always use the native backend.
  *
  * \param N: the size of the FFT
  * \param feature_name: the name of the feature the FFT is being used for, 
@@ -425,10 +538,28 @@ int xtract_init_fft(int N, int feature_name);
 
 /** \brief Free memory used for fft plans
  *
- * This function should be used to explicitly free memory allocated for ffts by xtract_init_fft(). It is primarily intended for use if a new FFT needs to be taken with a different blocksize. If only one fft size is required then there is no need to call this function since it will be called when the program exits. 
+ * This function releases the calling thread's references to FFT plans set up by xtract_init_fft() together with its work memory. There is no need to call it in order to change blocksize. Cached plans are freed when the program exits.
  * */
 void xtract_free_fft(void);
 
+/** \brief Select the FFT implementation used by all features
+ *
+ * The default is chosen at build time with the FFT_BACKEND make variable: vDSP on Apple platforms and the native backend elsewhere. The native backend picks SSE2, AVX2 or AVX-512 code for the CPU it runs on. All backends give the same results to within rounding error.
+ *
+ * Plans created for the previous backend stay in the cache and are picked up again if it is reselected. This function may be called while other threads compute features: each transform uses either the previous or the new backend, so frames computed around the change may differ by rounding error.
+ *
+ * \param backend: one of the values in the enumeration xtract_fft_backends_
+ *
+ * \return XTRACT_SUCCESS, or XTRACT_FEATURE_NOT_IMPLEMENTED if the backend isn't available on this platform
+ */
+int xtract_set_fft_backend(int backend);
+
+/** \brief Return the FFT backend currently in use, as given in the enumeration xtract_fft_backends_ */
+int xtract_get_fft_backend(void);
+
+/** \brief Return a human readable name for the FFT backend currently in use, e.g. "native (avx2)" */
+const char *xtract_get_fft_backend_name(void);
+
 /** \brief Make a window of a given type and return a pointer to it
  *
  * \param N: the size of the window
@@ -444,7 +575,25 @@ double *xtract_init_window(const int N, const int type);
  */
 void xtract_free_window(double *window);
 
-/* \brief A function to build an array of function descriptors */
+/** \brief Get the descriptor of a feature
+ *
+ * The descriptors are constant and shared, so this costs nothing and the result must not be freed.
+ *
+ * \param feature the feature to describe, e.g. XTRACT_MEAN
+ * \return a pointer to the descriptor, or NULL if feature is out of range
+ */
+const xtract_function_descriptor_t *xtract_get_descriptor(int feature);
+
+/** \brief Look up a feature by the name in its descriptor, e.g. "spectral_centroid"
+ *
+ * \param *name the name of the feature
+ * \return the feature, or XTRACT_ANY if no feature has that name
+ */
+int xtract_feature_from_name(const char *name);
+
+/* \brief A function to build an array of function descriptors
+ *
+ * The array is a copy of the descriptors returned by xtract_get_descriptor(), for callers that need to modify them */
 xtract_function_descriptor_t *xtract_make_descriptors(void);
 
 /* \brief A function to free an array of function descriptors */
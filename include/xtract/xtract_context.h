@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/** \file xtract_context.h: declares an explicit context object for features that need FFT plans, lookup tables or tracking state */
+
+#ifndef XTRACT_CONTEXT_H
+#define XTRACT_CONTEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * \defgroup context reentrant context API
+  *
+  * An xtract_context owns everything that the FFT-based and pitch tracking
+  * features keep between calls: FFT and DCT plans, the wavelet f0 tracker and
+  * work buffers. Each of the functions below takes the context as its first
+  * argument and otherwise follows the usual LibXtract prototype.
+  *
+  * Work buffers are sized by xtract_context_init_fft() and grown only when a
+  * larger N is seen, so a frame loop with a fixed set of sizes makes no heap
+  * allocations.
+  *
+  * The functions without a context argument (e.g. xtract_spectrum()) operate
+  * on a per-thread default context, which is what xtract_init_fft(),
+  * xtract_free_fft() and xtract_init_wavelet_f0_state() configure. Creating
+  * one context per stream allows a single thread to process many streams with
+  * different block sizes without re-initialising anything between calls.
+  *
+  * A context must not be used by more than one thread at a time.
+  *
+  * @{
+  */
+
+typedef struct xtract_context_ xtract_context;
+
+/** \brief Allocate a new context with no FFT plans initialised
+ *
+ * \return a pointer to the new context, or NULL if memory could not be allocated
+ */
+xtract_context *xtract_context_new(void);
+
+/** \brief Free a context and everything it owns
+ *
+ * \param *ctx a pointer to a context as returned by xtract_context_new()
+ */
+void xtract_context_delete(xtract_context *ctx);
+
+/** \brief Initialise the FFT plan used by a given feature in a context
+ *
+ * Plans come from a process wide cache shared with every other context, so
+ * initialising several contexts with the same N only sets up the FFT tables
+ * once. After initialisation the feature may also be computed at any other
+ * even size; switching between sizes doesn't re-initialise anything.
+ *
+ * \param *ctx a pointer to a context as returned by xtract_context_new()
+ * \param N the size of the FFT
+ * \param feature_name the name of the feature the FFT is being used for, e.g. XTRACT_SPECTRUM
+ */
+int xtract_context_init_fft(xtract_context *ctx, int N, int feature_name);
+
+/** \brief Release the FFT plans and work buffers used by a context
+ *
+ * \param *ctx a pointer to a context as returned by xtract_context_new()
+ */
+void xtract_context_free_fft(xtract_context *ctx);
+
+/** \brief Reset the wavelet f0 tracker owned by a context */
+int xtract_context_init_wavelet_f0_state(xtract_context *ctx);
+
+/** \brief Context taking variant of xtract_spectrum() */
+int xtract_spectrum_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_spectrum_batch() */
+int xtract_spectrum_batch_ctx(xtract_context *ctx, const double *data, const int N, const int frames, const int hop, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_autocorrelation_fft() */
+int xtract_autocorrelation_fft_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_autocorrelation_lags() */
+int xtract_autocorrelation_lags_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_asdf_lags() */
+int xtract_asdf_lags_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_asdf_fft() */
+int xtract_asdf_fft_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_dct() */
+int xtract_dct_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_mfcc() */
+int xtract_mfcc_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_gfcc() */
+int xtract_gfcc_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_failsafe_f0()
+ *
+ * The spectrum fallback requires an FFT plan of size N to have been initialised for XTRACT_SPECTRUM in ctx
+ */
+int xtract_failsafe_f0_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_wavelet_f0() */
+int xtract_wavelet_f0_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_mcleod_f0() with an optional lag bound
+ *
+ * *argv points to two doubles: the sample rate and the lowest f0 to search for. Only lags up to the period of that f0 are computed, which reduces the FFT size. A lowest f0 of 0 searches all lags below N, as xtract_mcleod_f0() does.
+ */
+int xtract_mcleod_f0_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** \brief Context taking variant of xtract_yin_f0() with a configurable threshold
+ *
+ * *argv points to two doubles: the sample rate and the absolute threshold on the normalised difference function. A threshold of 0 uses the default of 0.1. The buffers used are owned by ctx and reused from one frame to the next.
+ */
+int xtract_yin_f0_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/** \file xtract_engine.h: declares extraction engines, which compute a feature plan over every frame of a signal in parallel */
+
+#ifndef XTRACT_ENGINE_H
+#define XTRACT_ENGINE_H
+
+#include "xtract_plan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * \defgroup engine extraction engines
+  *
+  * An engine computes a compiled xtract_plan for every frame of a signal,
+  * spread across a number of threads. Each thread has its own copy of the
+  * plan, made with xtract_plan_copy(), so no FFT initialisation or other
+  * setup is needed in the threads. The frames are first divided evenly
+  * between the threads, and a thread that runs out takes half of the frames
+  * left to another, so all threads stay busy when frames differ in cost.
+  *
+  * The results are written to a matrix with one row per frame and one
+  * column per element of each requested feature's result, in the order of
+  * the features' enumeration. Every frame is computed independently, so the
+  * matrix doesn't depend on the number of threads or which thread computed
+  * which frame. For that reason a plan that requests XTRACT_WAVELET_F0,
+  * which tracks pitch from one frame to the next, is rejected.
+  *
+  * @{
+  */
+
+typedef struct xtract_engine_ xtract_engine;
+
+/** \brief Allocate a new engine for a compiled plan
+ *
+ * \param *plan a pointer to a plan compiled by xtract_plan_compile(), which may be deleted once the engine has been made
+ * \param threads the number of threads to compute frames in, or 0 for one per processor
+ * \return a pointer to the new engine, or NULL if the plan isn't compiled, requests XTRACT_WAVELET_F0 or memory could not be allocated
+ */
+xtract_engine *xtract_engine_new(const xtract_plan *plan, int threads);
+
+/** \brief Free an engine and its copies of the plan */
+void xtract_engine_delete(xtract_engine *engine);
+
+/** \brief Get the number of columns of the result matrix, i.e. the total size of the requested features' results */
+int xtract_engine_columns(const xtract_engine *engine);
+
+/** \brief Get the first column of a feature's result in the result matrix
+ *
+ * \param *engine a pointer to an engine as returned by xtract_engine_new()
+ * \param feature a feature requested by the engine's plan
+ * \param *N if not NULL, set to the number of columns of the feature's result
+ * \return the column, or -1 if feature wasn't requested
+ */
+int xtract_engine_column(const xtract_engine *engine, int feature, int *N);
+
+/** \brief Compute the engine's plan for every frame of a signal
+ *
+ * Frame f is the N samples from data[f * hop], as for xtract_spectrum_batch(). The threads are started when this is called and have finished when it returns.
+ *
+ * \param *engine a pointer to an engine as returned by xtract_engine_new()
+ * \param *data a pointer to at least (frames - 1) * hop + N samples
+ * \param frames the number of frames to compute
+ * \param hop the number of samples from the start of one frame to the start of the next
+ * \param *result a pointer to frames * xtract_engine_columns() doubles for the result matrix, frame by frame
+ * \return XTRACT_SUCCESS if every frame succeeded, otherwise the first code other than XTRACT_SUCCESS returned by xtract_plan_compute() for the earliest frame that failed
+ */
+int xtract_engine_compute(xtract_engine *engine, const double *data, int frames, int hop, double *result);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
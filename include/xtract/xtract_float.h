@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/** \file xtract_float.h: declares single precision versions of the most commonly used features */
+
+#ifndef XTRACT_FLOAT_H
+#define XTRACT_FLOAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "xtract_context.h"
+
+/**
+  * \defgroup float single precision functions
+  *
+  * Functions with an xtractf_ prefix take and return float rather than
+  * double, so 32-bit audio can be processed without conversion. Each one
+  * computes the same feature as the xtract_ function of the same name and
+  * takes the same arguments, except that any arrays of doubles passed via
+  * argv (e.g. a mean, or a window) become arrays of floats.
+  *
+  * xtractf_spectrum() uses a single precision FFT. It shares its plan with
+  * xtract_spectrum(), so xtract_init_fft(N, XTRACT_SPECTRUM) prepares both.
+  *
+  * xtractf_mfcc() and xtractf_mel_spectrogram() take the same xtract_mel_filter
+  * as their double precision counterparts.
+  *
+  * @{
+  */
+
+/** \brief Single precision feature function table
+ *
+ * xtractf[] has XTRACT_FEATURES entries indexed by the same enumeration as
+ * xtract[], so the descriptors returned by xtract_make_descriptors() describe
+ * both. Entries for features with no single precision version are NULL.
+ */
+#ifndef SWIG
+extern int(*xtractf[])(const float *data, const int N, const void *argv, float *result);
+#endif
+
+/** \brief Single precision version of xtract_mean() */
+int xtractf_mean(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_variance(), *argv points to the mean as a float */
+int xtractf_variance(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_standard_deviation(), *argv points to the variance as a float */
+int xtractf_standard_deviation(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_average_deviation(), *argv points to the mean as a float */
+int xtractf_average_deviation(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_skewness(), *argv points to an array of floats holding the mean and standard deviation */
+int xtractf_skewness(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_kurtosis(), *argv points to an array of floats holding the mean and standard deviation */
+int xtractf_kurtosis(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_zcr() */
+int xtractf_zcr(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_rms_amplitude() */
+int xtractf_rms_amplitude(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_lowest_value(), *argv points to the lower limit as a float */
+int xtractf_lowest_value(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_highest_value() */
+int xtractf_highest_value(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_sum() */
+int xtractf_sum(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_spectrum()
+ *
+ * *argv points to an array of four floats with the same meaning as for xtract_spectrum()
+ *
+ * \note Before calling xtractf_spectrum(), the FFT must be initialised by calling xtract_init_fft(N, XTRACT_SPECTRUM)
+ */
+int xtractf_spectrum(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_dct() */
+int xtractf_dct(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_mel_spectrogram() */
+int xtractf_mel_spectrogram(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_mfcc() */
+int xtractf_mfcc(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_windowed(), *argv points to a window as returned by xtractf_init_window() */
+int xtractf_windowed(const float *data, const int N, const void *argv, float *result);
+
+/** \brief Context taking variant of xtractf_spectrum() */
+int xtractf_spectrum_ctx(xtract_context *ctx, const float *data, const int N, const void *argv, float *result);
+
+/** \brief Context taking variant of xtractf_dct() */
+int xtractf_dct_ctx(xtract_context *ctx, const float *data, const int N, const void *argv, float *result);
+
+/** \brief Context taking variant of xtractf_mfcc() */
+int xtractf_mfcc_ctx(xtract_context *ctx, const float *data, const int N, const void *argv, float *result);
+
+/** \brief Single precision version of xtract_init_window()
+ *
+ * \return a pointer to N floats, to be freed with xtractf_free_window(), or NULL if memory could not be allocated
+ */
+float *xtractf_init_window(const int N, const int type);
+
+/** \brief Free a window as allocated by xtractf_init_window() */
+void xtractf_free_window(float *window);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
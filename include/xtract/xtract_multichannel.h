@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/** \file xtract_multichannel.h: declares features computed on every channel of an interleaved multichannel block at once */
+
+#ifndef XTRACT_MULTICHANNEL_H
+#define XTRACT_MULTICHANNEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * \defgroup multichannel multichannel features
+  *
+  * These functions take a block of N frames of interleaved channels, with
+  * sample n of channel c at data[n * channels + c], as delivered by most
+  * audio interfaces and file formats. Each is computed with the channels in
+  * the innermost loop, so that one vector instruction handles a sample of
+  * several channels and even the simplest features keep every SIMD lane
+  * busy. A scalar feature gives one value per channel, in result[c]. A
+  * vector feature gives its values interleaved in the same way, with value
+  * k of channel c in result[k * channels + c].
+  *
+  * Apart from the order in which sums are taken, each result equals that
+  * of the named single channel function applied to one channel.
+  *
+  * @{
+  */
+
+/** \brief Multiply every channel by a window, as xtract_windowed()
+ *
+ * \param *data a pointer to N frames of interleaved channels
+ * \param N the number of frames
+ * \param channels the number of channels
+ * \param *argv a pointer to the N values of a window, as returned by xtract_init_window()
+ * \param *result a pointer to an array of N * channels doubles, which may be data
+ */
+int xtract_multichannel_windowed(const double *data, const int N, const int channels, const void *argv, double *result);
+
+/** \brief The mean of each channel, as xtract_mean()
+ *
+ * \param *argv a pointer to NULL
+ * \param *result a pointer to an array of channels doubles
+ */
+int xtract_multichannel_mean(const double *data, const int N, const int channels, const void *argv, double *result);
+
+/** \brief The variance of each channel, as xtract_variance()
+ *
+ * \param *argv a pointer to an array of channels doubles holding the mean of each channel, e.g. from xtract_multichannel_mean()
+ * \param *result a pointer to an array of channels doubles
+ */
+int xtract_multichannel_variance(const double *data, const int N, const int channels, const void *argv, double *result);
+
+/** \brief The RMS amplitude of each channel, as xtract_rms_amplitude()
+ *
+ * \param *argv a pointer to NULL
+ * \param *result a pointer to an array of channels doubles
+ */
+int xtract_multichannel_rms_amplitude(const double *data, const int N, const int channels, const void *argv, double *result);
+
+/** \brief The zero crossing rate of each channel, as xtract_zcr()
+ *
+ * \param *argv a pointer to NULL
+ * \param *result a pointer to an array of channels doubles
+ */
+int xtract_multichannel_zcr(const double *data, const int N, const int channels, const void *argv, double *result);
+
+/** \brief The highest sample of each channel, as xtract_highest_value()
+ *
+ * \param *argv a pointer to NULL
+ * \param *result a pointer to an array of channels doubles
+ */
+int xtract_multichannel_highest_value(const double *data, const int N, const int channels, const void *argv, double *result);
+
+/** \brief The log mel energies of each channel, as xtract_mel_spectrogram()
+ *
+ * \param *data a pointer to N bins of interleaved channels, e.g. the first half of the result of xtract_multichannel_spectrum()
+ * \param N the number of bins
+ * \param channels the number of channels
+ * \param *argv a pointer to an xtract_mel_filter of n_filters filters, in dense or sparse form
+ * \param *result a pointer to an array of n_filters * channels doubles
+ */
+int xtract_multichannel_mel_spectrogram(const double *data, const int N, const int channels, const void *argv, double *result);
+
+/** \brief Tables and buffers for the spectra of interleaved multichannel frames, see xtract_multichannel_fft_new() */
+typedef struct xtract_multichannel_fft_ xtract_multichannel_fft;
+
+/** \brief Allocate a multichannel FFT
+ *
+ * Each butterfly of the FFT works on the same bin of every channel, so the
+ * channels are transformed together without being copied apart. A state
+ * must not be used by more than one thread at a time.
+ *
+ * \param N the number of frames in each block, which must be a power of two of at least 2
+ * \param channels the number of channels
+ * \param window_type the window applied to each channel, as given in the enumeration xtract_window_types_, e.g. XTRACT_RECTANGULAR for none
+ * \return a pointer to the new state, or NULL if the arguments are invalid or memory could not be allocated
+ */
+xtract_multichannel_fft *xtract_multichannel_fft_new(int N, int channels, int window_type);
+
+/** \brief Free a state created by xtract_multichannel_fft_new() */
+void xtract_multichannel_fft_delete(xtract_multichannel_fft *fft);
+
+/** \brief The windowed spectrum of each channel, as xtract_windowed() followed by xtract_spectrum()
+ *
+ * xtract_init_fft() is not needed.
+ *
+ * \param *fft a state as returned by xtract_multichannel_fft_new()
+ * \param *data a pointer to N frames of interleaved channels
+ * \param N the number of frames, which must match the state
+ * \param *argv the arguments to xtract_spectrum()
+ * \param *result a pointer to an array of N * channels doubles, holding the N values given by xtract_spectrum() for each channel, interleaved
+ */
+int xtract_multichannel_spectrum(xtract_multichannel_fft *fft, const double *data, const int N, const void *argv, double *result);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/** \file xtract_pipeline.h: declares extraction pipelines, which read, transform and extract features from a signal in overlapping stages */
+
+#ifndef XTRACT_PIPELINE_H
+#define XTRACT_PIPELINE_H
+
+#include "xtract_plan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * \defgroup pipeline extraction pipelines
+  *
+  * A pipeline runs the extraction of a long signal in three stages, each on
+  * its own thread, so that reading and decoding the signal overlaps with the
+  * FFTs and both overlap with the features:
+  *
+  * - the read stage calls a function that supplies blocks of samples, e.g.
+  *   from a file decoder
+  * - the transform stage cuts the samples into windowed frames and computes
+  *   their spectra with an xtract_stft_stream
+  * - the feature stage computes an xtract_plan whose input is set to
+  *   XTRACT_SPECTRAL from each spectrum, and passes the plan to a function
+  *   that collects the results
+  *
+  * The stages are connected by bounded single producer, single consumer
+  * queues of preallocated slots that don't take locks. A stage waits by
+  * yielding its thread when its input queue is empty or its output queue is
+  * full. The statistics of each queue show which stage is the bottleneck:
+  * a queue that is usually full is waiting on the stage that reads it.
+  *
+  * @{
+  */
+
+/** \brief The queues of a pipeline */
+enum xtract_pipeline_queues_ {
+    XTRACT_PIPELINE_SAMPLES,    /* blocks of samples from the read stage to the transform stage */
+    XTRACT_PIPELINE_SPECTRA,    /* spectra from the transform stage to the feature stage */
+    XTRACT_PIPELINE_QUEUES
+};
+
+/** \brief Statistics of a pipeline queue over the last xtract_pipeline_run() */
+typedef struct xtract_pipeline_stats_ {
+    int capacity;               /* number of slots */
+    int max_depth;              /* largest number of slots filled */
+    double mean_depth;          /* mean number of slots filled, sampled as each slot is filled */
+    long pushes;                /* number of slots filled */
+    long full_waits;            /* number of times the producer waited for a free slot */
+    long empty_waits;           /* number of times the consumer waited for a filled slot */
+} xtract_pipeline_stats;
+
+/** \brief Supplies the samples of the signal to the read stage
+ *
+ * \param *user the pointer given to xtract_pipeline_run()
+ * \param *samples a pointer to an array for up to n samples
+ * \param n the largest number of samples to supply, the pipeline's hop
+ * \return the number of samples written to samples, or 0 or less at the end of the signal
+ */
+typedef int (*xtract_pipeline_read_fn)(void *user, double *samples, int n);
+
+/** \brief Receives the features of a frame in the feature stage
+ *
+ * \param *user the pointer given to xtract_pipeline_run()
+ * \param frame the index of the frame, counting from 0
+ * \param *plan the plan computed from the frame's spectrum, to be read with xtract_plan_result()
+ */
+typedef void (*xtract_pipeline_frame_fn)(void *user, int frame, const xtract_plan *plan);
+
+typedef struct xtract_pipeline_ xtract_pipeline;
+
+/** \brief Allocate a new pipeline
+ *
+ * \param *plan a pointer to a plan compiled by xtract_plan_compile() with its input set to XTRACT_SPECTRAL, which may be deleted once the pipeline has been made
+ * \param hop the number of samples from the start of one frame to the start of the next, from 1 to the plan's N
+ * \param window_type the window applied to each frame, as given in the enumeration xtract_window_types_
+ * \param *spectrum_argv the arguments to xtract_spectrum() for each frame
+ * \param depth the number of slots in each queue
+ * \return a pointer to the new pipeline, or NULL if an argument is invalid or memory could not be allocated
+ */
+xtract_pipeline *xtract_pipeline_new(const xtract_plan *plan, int hop, int window_type, const double *spectrum_argv, int depth);
+
+/** \brief Free a pipeline and everything it owns */
+void xtract_pipeline_delete(xtract_pipeline *pipeline);
+
+/** \brief Extract the features of a whole signal
+ *
+ * The read and transform stages run on threads started by this call, and the feature stage on the calling thread, so frame is called on the calling thread in order of frame index.
+ *
+ * \param *pipeline a pointer to a pipeline as returned by xtract_pipeline_new()
+ * \param read the function supplying the samples
+ * \param frame the function receiving the features of each frame
+ * \param *user a pointer passed to read and frame
+ * If the spectrum of a frame can't be computed, the stream ends before that frame, and the rest of the signal isn't read.
+ *
+ * \return XTRACT_SUCCESS if every frame succeeded, otherwise the first code other than XTRACT_SUCCESS returned by xtract_spectrum(), or failing that by xtract_plan_compute(), or XTRACT_MALLOC_FAILED if a thread could not be started
+ */
+int xtract_pipeline_run(xtract_pipeline *pipeline, xtract_pipeline_read_fn read, xtract_pipeline_frame_fn frame, void *user);
+
+/** \brief Get the statistics of a queue over the last xtract_pipeline_run()
+ *
+ * \param *pipeline a pointer to a pipeline as returned by xtract_pipeline_new()
+ * \param queue the queue, as given in the enumeration xtract_pipeline_queues_
+ * \param *stats a pointer to a structure for the statistics
+ * \return XTRACT_BAD_ARGV if queue is out of range
+ */
+int xtract_pipeline_get_stats(const xtract_pipeline *pipeline, int queue, xtract_pipeline_stats *stats);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/** \file xtract_plan.h: declares feature plans, which compute a set of features and everything they depend on from each frame */
+
+#ifndef XTRACT_PLAN_H
+#define XTRACT_PLAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * \defgroup plan feature plans
+  *
+  * A plan computes a set of features from frames of N audio samples. The
+  * data each feature reads and the features that supply its argv are taken
+  * from its descriptor (see xtract_get_descriptor()), so requesting
+  * XTRACT_SKEWNESS also schedules XTRACT_MEAN, XTRACT_VARIANCE and
+  * XTRACT_STANDARD_DEVIATION, and requesting XTRACT_SPECTRAL_CENTROID
+  * schedules XTRACT_SPECTRUM. xtract_plan_compile() orders the features so
+  * that each runs after everything it depends on, and gives every result its
+  * own slot, so each intermediate is computed once per frame however many
+  * features use it.
+  *
+  * A feature whose data is XTRACT_ARBITRARY_SERIES reads the plan's input
+  * when it is requested, and the data of the feature it supplies an argument
+  * to otherwise: the XTRACT_HIGHEST_VALUE and XTRACT_MEAN donors of
+  * XTRACT_CREST are computed from the spectral magnitudes, separately from
+  * an XTRACT_MEAN of the input.
+  *
+  * A plan owns an xtract_context, so the FFT based features don't need
+  * xtract_init_fft(), and XTRACT_WAVELET_F0 tracks pitch for the plan's
+  * stream only. A plan must not be used by more than one thread at a time.
+  *
+  * @{
+  */
+
+typedef struct xtract_plan_ xtract_plan;
+
+/** \brief Allocate a new, empty plan for frames of N samples
+ *
+ * \param N the number of samples in each frame passed to xtract_plan_compute()
+ * \return a pointer to the new plan, or NULL if N is less than 2 or memory could not be allocated
+ */
+xtract_plan *xtract_plan_new(int N);
+
+/** \brief Free a plan and everything it owns
+ *
+ * \param *plan a pointer to a plan as returned by xtract_plan_new()
+ */
+void xtract_plan_delete(xtract_plan *plan);
+
+/** \brief Set what the frames passed to xtract_plan_compute() hold
+ *
+ * With XTRACT_SPECTRAL each frame is a spectrum of N values as written by xtract_spectrum(), e.g. from an xtract_stft_stream, and features that read a spectrum or its magnitudes read it directly. Features that read audio samples can't then be planned.
+ *
+ * \param *plan a pointer to a plan as returned by xtract_plan_new()
+ * \param format XTRACT_AUDIO_SAMPLES, the default, or XTRACT_SPECTRAL
+ * \return XTRACT_BAD_ARGV if format is neither or the plan has already been compiled
+ */
+int xtract_plan_set_input(xtract_plan *plan, int format);
+
+/** \brief Get the input format of a plan, as set by xtract_plan_set_input() */
+int xtract_plan_get_input(const xtract_plan *plan);
+
+/** \brief Get the number of elements in each frame of a plan's input */
+int xtract_plan_get_N(const xtract_plan *plan);
+
+/** \brief Request a feature, or set the arguments of a feature that another depends on
+ *
+ * When argv is NULL the defaults from the feature's descriptor are used. If the feature's argv is at most XTRACT_MAXARGS doubles, they are copied by xtract_plan_compile(). Otherwise the pointer itself is kept, e.g. the filterbank for XTRACT_MFCC or the window for XTRACT_WINDOWED, and must remain valid while the plan is in use. Arguments that have a donor feature in the descriptor are always filled from the donor's result.
+ *
+ * \param *plan a pointer to a plan as returned by xtract_plan_new()
+ * \param feature the feature to compute, e.g. XTRACT_SKEWNESS
+ * \param *argv the arguments for the feature, or NULL
+ * \return XTRACT_BAD_ARGV if feature is out of range or the plan has already been compiled
+ */
+int xtract_plan_add(xtract_plan *plan, int feature, const void *argv);
+
+/** \brief Order the features of a plan and allocate memory for their results
+ *
+ * \param *plan a pointer to a plan as returned by xtract_plan_new()
+ * \return XTRACT_BAD_ARGV if a feature that needs an argv pointer wasn't given one, XTRACT_FEATURE_NOT_IMPLEMENTED if a feature needs data that a plan can't produce (delta features and those reading subframes or LPC coefficients), or XTRACT_MALLOC_FAILED
+ */
+int xtract_plan_compile(xtract_plan *plan);
+
+/** \brief Make an independent copy of a compiled plan
+ *
+ * The copy has its own results and xtract_context, so it can be computed in another thread. It shares any argv pointers kept by xtract_plan_add().
+ *
+ * \param *plan a pointer to a plan compiled by xtract_plan_compile()
+ * \return a pointer to the copy, to be freed with xtract_plan_delete(), or NULL if plan isn't compiled or memory could not be allocated
+ */
+xtract_plan *xtract_plan_copy(const xtract_plan *plan);
+
+/** \brief Compute every feature of a compiled plan from one frame
+ *
+ * Every feature is computed even if one of them fails.
+ *
+ * \param *plan a pointer to a plan compiled by xtract_plan_compile()
+ * \param *data a pointer to a frame of N samples
+ * \return XTRACT_SUCCESS if every feature succeeded, otherwise the first code other than XTRACT_SUCCESS returned by one of them
+ */
+int xtract_plan_compute(xtract_plan *plan, const double *data);
+
+/** \brief Get the result of a requested feature from the last xtract_plan_compute()
+ *
+ * \param *plan a pointer to a compiled plan
+ * \param feature a feature passed to xtract_plan_add()
+ * \param *N if not NULL, set to the number of elements in the result
+ * \return a pointer to the result, valid until the plan is deleted, or NULL if feature wasn't requested
+ */
+const double *xtract_plan_result(const xtract_plan *plan, int feature, int *N);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
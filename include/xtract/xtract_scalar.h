@@ -93,6 +93,28 @@ int xtract_skewness(const double *data, const int N, const void *argv,  double *
  */
 int xtract_kurtosis(const double *data, const int N, const void *argv,  double *result);
 
+/** \brief The statistical moments of a vector, as computed by xtract_moments() */
+typedef struct xtract_moments_t_ {
+    double mean;                /**< as xtract_mean() */
+    double variance;            /**< as xtract_variance(), with the N - 1 denominator */
+    double standard_deviation;  /**< as xtract_standard_deviation() */
+    double average_deviation;   /**< as xtract_average_deviation() */
+    double skewness;            /**< as xtract_skewness() */
+    double kurtosis;            /**< as xtract_kurtosis(), i.e. the excess kurtosis */
+} xtract_moments_t;
+
+/** \brief Extract the mean, variance, standard deviation, average deviation, skewness and kurtosis of an input vector together
+ *
+ * Equivalent to chaining xtract_mean(), xtract_variance(), xtract_standard_deviation(), xtract_average_deviation(), xtract_skewness() and xtract_kurtosis() through argv, but reads the data twice rather than six times. The variance is computed with the corrected two-pass algorithm, which cancels most of the rounding error in the mean.
+ *
+ * \param *data: a pointer to the first element in an array of doubles
+ * \param N: the number of elements to be considered
+ * \param *moments: a pointer to a structure to store the results in
+ *
+ * \return XTRACT_NO_RESULT if the standard deviation is 0, in which case the skewness and kurtosis are set to 0 as with xtract_skewness() and xtract_kurtosis(), or XTRACT_BAD_VECTOR_SIZE if N is less than 1
+ */
+int xtract_moments(const double *data, const int N, xtract_moments_t *moments);
+
 /** \brief Extract the mean of an input spectrum
  * 
  * \param *data: a pointer to the first element in an array of doubles representing the spectrum of an audio vector, (e.g. the array pointed to by *result from xtract_spectrum(), xtract_peak_spectrum() or xtract_harmonic_spectrum()).
@@ -349,6 +371,30 @@ int xtract_sharpness(const double *data, const int N, const void *argv, double *
  */
 int xtract_spectral_slope(const double *data, const int N, const void *argv, double *result);
 
+/** \brief The spectral shape descriptors of a spectrum, as computed by xtract_spectral_shape() */
+typedef struct xtract_spectral_shape_t_ {
+    double centroid;            /**< as xtract_spectral_centroid() */
+    double variance;            /**< as xtract_spectral_variance() */
+    double standard_deviation;  /**< as xtract_spectral_standard_deviation() */
+    double skewness;            /**< as xtract_spectral_skewness() */
+    double kurtosis;            /**< as xtract_spectral_kurtosis() */
+    double slope;               /**< as xtract_spectral_slope() */
+    double rolloff;             /**< as xtract_rolloff() of the N/2 magnitude coefficients */
+} xtract_spectral_shape_t;
+
+/** \brief Extract the spectral centroid, variance, standard deviation, skewness, kurtosis, slope and rolloff of a spectrum together
+ *
+ * Equivalent to calling each of the functions listed in xtract_spectral_shape_t, with the results of the centroid and standard deviation passed on through argv, but the magnitudes and frequencies are read in two passes, and the sum of the magnitudes is only computed once. The first pass gives the centroid and slope, the second the moments about the centroid, and the rolloff is found from the magnitudes while they are still in the cache.
+ *
+ * \param *data: a pointer to the first element in an array of doubles representing the spectrum of an audio vector, (e.g. the array pointed to by *result from xtract_spectrum(), xtract_peak_spectrum() or xtract_harmonic_spectrum()).
+ * \param N: the number of elements to be considered
+ * \param *argv: a pointer to an array of two doubles, as for xtract_rolloff(): the frequency resolution and the rolloff threshold as a percentage
+ * \param *shape: a pointer to a structure to store the results in
+ *
+ * \return XTRACT_NO_RESULT if any of the descriptors is undefined for the spectrum (e.g. all magnitudes are 0), in which case it is set to 0
+ */
+int xtract_spectral_shape(const double *data, const int N, const void *argv, xtract_spectral_shape_t *shape);
+
 /** \brief Extract the value of the lowest value in an input vector
  * 
  * \param *data: a pointer to the first element in an array of doubles
@@ -431,6 +477,9 @@ int xtract_failsafe_f0(const double *data, const int N, const void *argv, double
  *  
  * xtract_init_wavelet_f0_state() must be called exactly once prior to calling xtract_wavelet_f0()
  *
+ * xtract_wavelet_f0() tracks a single stream per thread. Use xtract_wavelet_f0_state_new() to track
+ * several streams from one thread
+ *
  */
 int xtract_wavelet_f0(const double *data, const int N, const void *argv, double *result);
 
@@ -440,6 +489,10 @@ int xtract_wavelet_f0(const double *data, const int N, const void *argv, double
  * interpolation for sub-sample accuracy. Based on McLeod and Wyvill (2005)
  * "A Smarter Way to Find Pitch".
  *
+ * The autocorrelation term of the NSDF is computed with an FFT of size 2N
+ * and the normalisation term with a running sum of squares, so the cost is
+ * O(N log N). See xtract_mcleod_f0_ctx() to bound the lags searched.
+ *
  * \param *data: a pointer to the first element in an array of doubles representing an audio vector
  * \param N: the number of elements to be considered
  * \param *argv: a pointer to a double representing the audio sample rate
@@ -447,6 +500,25 @@ int xtract_wavelet_f0(const double *data, const int N, const void *argv, double
  */
 int xtract_mcleod_f0(const double *data, const int N, const void *argv, double *result);
 
+/** \brief Extract the fundamental frequency using the YIN method
+ *
+ * Finds the first dip of the cumulative mean normalised difference function
+ * below an absolute threshold of 0.1 and refines it with parabolic
+ * interpolation, as described in de Cheveigne and Kawahara (2002) "YIN, a
+ * fundamental frequency estimator for speech and music". Lags and the
+ * integration window are both N/2, so the lowest f0 found is 2 * samplerate / N.
+ *
+ * The difference function is computed from a cross-correlation by FFT and a
+ * running sum of the window energy, so the cost is O(N log N). See
+ * xtract_yin_f0_ctx() to set the threshold.
+ *
+ * \param *data: a pointer to the first element in an array of doubles representing an audio vector
+ * \param N: the number of elements to be considered
+ * \param *argv: a pointer to a double representing the audio sample rate
+ * \param *result: the pitch of N values from the array pointed to by *data, or 0 with XTRACT_NO_RESULT if no dip is below the threshold
+ */
+int xtract_yin_f0(const double *data, const int N, const void *argv, double *result);
+
     
 /** \brief Convenience function to convert a frequency in Hertz to a "pitch" value in MIDI cents
  *
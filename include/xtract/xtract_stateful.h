@@ -58,7 +58,119 @@ void xtract_last_n_state_delete(xtract_last_n_state *last_n_state);
  *
  */
 int xtract_last_n(const xtract_last_n_state *state, const double *data, const int N, const void *argv, double *result);
-    
+
+/*
+ * Running statistics over the last `capacity` values written to a state,
+ * e.g. one value per sample or one feature value per frame. Each value
+ * written updates the statistic in constant time, amortised over the window,
+ * rather than rescanning the window. Until the window is full the statistic
+ * is taken over every value written so far.
+ *
+ * Adding and removing values leaves rounding error behind, so the sums are
+ * recomputed from the window each time it has been filled again, which
+ * keeps e.g. the RMS of silence after a loud passage at zero.
+ *
+ * A state must not be used by more than one thread at a time.
+ */
+
+typedef struct xtract_running_moments_state_ xtract_running_moments_state;
+typedef struct xtract_running_extrema_state_ xtract_running_extrema_state;
+typedef struct xtract_running_rms_state_ xtract_running_rms_state;
+
+/** \brief Allocate a running mean and variance over the last capacity values, or return NULL if capacity is 0 or memory could not be allocated */
+xtract_running_moments_state *xtract_running_moments_state_new(size_t capacity);
+void xtract_running_moments_state_delete(xtract_running_moments_state *state);
+
+/** \brief Allocate a running minimum and maximum over the last capacity values, or return NULL if capacity is 0 or memory could not be allocated */
+xtract_running_extrema_state *xtract_running_extrema_state_new(size_t capacity);
+void xtract_running_extrema_state_delete(xtract_running_extrema_state *state);
+
+/** \brief Allocate a running RMS over the last capacity values, or return NULL if capacity is 0 or memory could not be allocated */
+xtract_running_rms_state *xtract_running_rms_state_new(size_t capacity);
+void xtract_running_rms_state_delete(xtract_running_rms_state *state);
+
+/**
+ *  Write N values to the window of `state` and get the mean and variance of the window
+ *
+ *  The mean and variance are updated with Welford's method, removing each value as it leaves the window.
+ *
+ *  @param state  a pointer to an xtract_running_moments_state struct as allocated by xtract_running_moments_state_new()
+ *  @param data   a pointer to the N new values, oldest first
+ *  @param N      the number of new values, which may be 0 to read the current statistics
+ *  @param argv   a pointer to NULL
+ *  @param result a pointer to an array of 2 doubles for the mean and the variance, as given by xtract_mean() and xtract_variance() for the values in the window, with a variance of 0 for a single value
+ *  @return XTRACT_SUCCESS, or XTRACT_NO_RESULT with a result of 0 if no value has been written
+ */
+int xtract_running_moments(xtract_running_moments_state *state, const double *data, const int N, const void *argv, double *result);
+
+/**
+ *  Write N values to the window of `state` and get the smallest and largest value in the window
+ *
+ *  The candidates for the minimum and maximum are kept in monotonic queues, so the result is read from the front of each queue.
+ *
+ *  @param state  a pointer to an xtract_running_extrema_state struct as allocated by xtract_running_extrema_state_new()
+ *  @param data   a pointer to the N new values, oldest first
+ *  @param N      the number of new values, which may be 0 to read the current statistics
+ *  @param argv   a pointer to NULL
+ *  @param result a pointer to an array of 2 doubles for the minimum and the maximum
+ *  @return XTRACT_SUCCESS, or XTRACT_NO_RESULT with a result of 0 if no value has been written
+ */
+int xtract_running_extrema(xtract_running_extrema_state *state, const double *data, const int N, const void *argv, double *result);
+
+/**
+ *  Write N values to the window of `state` and get the RMS of the window, as given by xtract_rms_amplitude()
+ *
+ *  @param state  a pointer to an xtract_running_rms_state struct as allocated by xtract_running_rms_state_new()
+ *  @param data   a pointer to the N new values, oldest first
+ *  @param N      the number of new values, which may be 0 to read the current statistics
+ *  @param argv   a pointer to NULL
+ *  @param result a pointer to a double for the RMS
+ *  @return XTRACT_SUCCESS, or XTRACT_NO_RESULT with a result of 0 if no value has been written
+ */
+int xtract_running_rms(xtract_running_rms_state *state, const double *data, const int N, const void *argv, double *result);
+
+/*
+ * A sliding DFT gives the spectrum of the last N samples after every sample
+ * written, updating each bin it tracks in constant time per sample rather
+ * than running an FFT of the whole frame. For hops much shorter than N this
+ * is the cheaper way to follow a spectrum, e.g. for onset detection.
+ *
+ * The recursive update accumulates rounding error, so the bins are
+ * recomputed from the last N samples each time N samples have been written,
+ * at an amortised cost that is also constant per sample and bin.
+ *
+ * The frames are not windowed.
+ */
+
+typedef struct xtract_sliding_dft_state_ xtract_sliding_dft_state;
+
+/** \brief Allocate a sliding DFT over the last N samples
+ *
+ *  @param N      the number of samples in each frame, which must be even and at least 2
+ *  @param bins   a pointer to n_bins bin numbers from 0 to N/2 to track, or NULL to track every bin
+ *  @param n_bins the number of bins, ignored if bins is NULL
+ *  @return a pointer to the new state, or NULL if the arguments are invalid or memory could not be allocated
+ */
+xtract_sliding_dft_state *xtract_sliding_dft_state_new(int N, const int *bins, int n_bins);
+void xtract_sliding_dft_state_delete(xtract_sliding_dft_state *state);
+
+/** \brief Drop every sample written, so that the next frame starts with the next sample */
+void xtract_sliding_dft_state_reset(xtract_sliding_dft_state *state);
+
+/**
+ *  Write N samples to `state` and get the spectrum of the last frame
+ *
+ *  If every bin is tracked, the result is laid out as that of xtract_spectrum() for the last frame, with N/2 values followed by N/2 frequencies, or N/2 interleaved coefficients. Otherwise it holds the n_bins values of the tracked bins in the order given to xtract_sliding_dft_state_new(), followed by their n_bins frequencies, or n_bins interleaved coefficients, so that it can be passed to the spectral features as a spectrum of 2 * n_bins values. The DC argument of argv is ignored in that case.
+ *
+ *  @param state  a pointer to an xtract_sliding_dft_state struct as allocated by xtract_sliding_dft_state_new()
+ *  @param data   a pointer to the N new samples, oldest first
+ *  @param N      the number of new samples, which may be 0 to read the current spectrum
+ *  @param argv   the arguments to xtract_spectrum()
+ *  @param result a pointer to an array of the frame size, or 2 * n_bins, doubles
+ *  @return XTRACT_SUCCESS, or XTRACT_NO_RESULT without writing result if fewer samples than the frame size have been written
+ */
+int xtract_sliding_dft(xtract_sliding_dft_state *state, const double *data, const int N, const void *argv, double *result);
+
 #ifdef __cplusplus
 }
 #endif
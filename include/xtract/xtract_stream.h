@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/** \file xtract_stream.h: declares STFT streams, which cut audio arriving in blocks of any size into overlapping windowed frames */
+
+#ifndef XTRACT_STREAM_H
+#define XTRACT_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * \defgroup stream STFT streams
+  *
+  * An STFT stream buffers samples written in blocks of any size, e.g. those
+  * of an audio callback, and gives back frames of N samples every hop
+  * samples, multiplied by a window. The samples are kept in a ring buffer
+  * and each frame is windowed straight out of it, so nothing is moved as
+  * samples arrive. With an XTRACT_RECTANGULAR window a frame that doesn't
+  * wrap around the end of the ring buffer is returned in place.
+  *
+  * A typical callback writes its block and then takes every frame that has
+  * become available:
+  *
+  * \code
+  * while(n > 0)
+  * {
+  *     written = xtract_stft_stream_write(stream, data, n);
+  *     data += written;
+  *     n -= written;
+  *
+  *     while(xtract_stft_stream_spectrum(stream, argv, spectrum) == XTRACT_SUCCESS)
+  *         ...
+  * }
+  * \endcode
+  *
+  * A stream must not be used by more than one thread at a time.
+  *
+  * @{
+  */
+
+typedef struct xtract_stft_stream_ xtract_stft_stream;
+
+/** \brief Allocate a new STFT stream
+ *
+ * \param N the number of samples in each frame
+ * \param hop the number of samples from the start of one frame to the start of the next, from 1 to N
+ * \param window_type the window applied to each frame, as given in the enumeration xtract_window_types_
+ * \return a pointer to the new stream, or NULL if N is less than 2, hop is out of range or memory could not be allocated
+ */
+xtract_stft_stream *xtract_stft_stream_new(int N, int hop, int window_type);
+
+/** \brief Free an STFT stream and everything it owns */
+void xtract_stft_stream_delete(xtract_stft_stream *stream);
+
+/** \brief Drop every buffered sample, so that the next frame starts with the next sample written */
+void xtract_stft_stream_reset(xtract_stft_stream *stream);
+
+/** \brief Buffer samples for the frames that follow
+ *
+ * The stream holds up to 4N - 1 samples, so a block of up to 3N samples is always taken whole once the available frames have been read.
+ *
+ * \param *stream a pointer to a stream as returned by xtract_stft_stream_new()
+ * \param *data a pointer to n samples
+ * \param n the number of samples to write
+ * \return the number of samples buffered, which is less than n if the stream is full
+ */
+int xtract_stft_stream_write(xtract_stft_stream *stream, const double *data, int n);
+
+/** \brief Get the next windowed frame, if enough samples have been written
+ *
+ * \param *stream a pointer to a stream as returned by xtract_stft_stream_new()
+ * \param **frame set to a pointer to the N samples of the frame, valid until the next call to any xtract_stft_stream function
+ * \return XTRACT_SUCCESS, or XTRACT_NO_RESULT if fewer than N samples are buffered
+ */
+int xtract_stft_stream_frame(xtract_stft_stream *stream, const double **frame);
+
+/** \brief Compute the spectrum of the next windowed frame, if enough samples have been written
+ *
+ * The stream owns the FFT plan, so xtract_init_fft() is not needed.
+ *
+ * \param *stream a pointer to a stream as returned by xtract_stft_stream_new()
+ * \param *argv the arguments to xtract_spectrum()
+ * \param *result a pointer to an array of N doubles for the spectrum, as written by xtract_spectrum()
+ * \return XTRACT_NO_RESULT if fewer than N samples are buffered, otherwise the return value of xtract_spectrum()
+ */
+int xtract_stft_stream_spectrum(xtract_stft_stream *stream, const void *argv, double *result);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -52,6 +52,22 @@ extern "C" {
  */
 int xtract_spectrum(const double *data, const int N, const void *argv, double *result);
 
+/** \brief Extract frequency domain spectra from a sequence of equally sized frames
+ *
+ * This gives the same results as calling xtract_spectrum() once per frame, but the arguments are checked and the FFT plan looked up only once per call.
+ *
+ * \param *data: a pointer to the first element of the first frame. Frame k starts at data + k * hop
+ * \param N: the number of samples in each frame
+ * \param frames: the number of frames to process
+ * \param hop: the distance in samples between the starts of successive frames, e.g. N for contiguous frames or N / 2 for 50% overlap
+ * \param *argv: as for xtract_spectrum(), applied to every frame
+ * \param *result: a pointer to an array of size frames * N. The spectrum of frame k is written to result + k * N in the format used by xtract_spectrum()
+ *
+ * \note Before calling xtract_spectrum_batch(), the FFT must be initialised by calling xtract_init_fft(N, XTRACT_SPECTRUM)
+ *
+ */
+int xtract_spectrum_batch(const double *data, const int N, const int frames, const int hop, const void *argv, double *result);
+
 /** \brief Extract autocorrelation from time domain signal using FFT based method
  * 
  * \param *data: a pointer to the first element in an array of doubles representing an audio vector
@@ -65,10 +81,10 @@ int xtract_autocorrelation_fft(const double *data, const int N, const void *argv
  * 
  * \param *data: a pointer to the first element in an array of spectral magnitudes, e.g. the first half of the array pointed to by *resul from xtract_spectrum()
  * \param N: the number of array elements to be considered
- * \param *argv: a pointer to a data structure of type xtract_mel_filter, containing n_filters coefficient tables to make up a mel-spaced filterbank
+ * \param *argv: a pointer to a data structure of type xtract_mel_filter, in dense or sparse form, containing n_filters filters to make up a mel-spaced filterbank
  * \param *result: a pointer to an array containing the resultant MFCC
  * 
- * The data structure pointed to by *argv must be obtained by first calling xtract_init_mfcc
+ * The data structure pointed to by *argv must be obtained by first calling xtract_init_mfcc or xtract_init_mfcc_sparse
  */
 int xtract_mfcc(const double *data, const int N, const void *argv, double *result);
 
@@ -79,10 +95,10 @@ int xtract_mfcc(const double *data, const int N, const void *argv, double *resul
  *
  * \param *data: a pointer to the first element in an array of spectral magnitudes, e.g. the first half of the array pointed to by *result from xtract_spectrum()
  * \param N: the number of array elements to be considered
- * \param *argv: a pointer to a data structure of type xtract_mel_filter, containing n_filters coefficient tables to make up a mel-spaced filterbank
+ * \param *argv: a pointer to a data structure of type xtract_mel_filter, in dense or sparse form, containing n_filters filters to make up a mel-spaced filterbank
  * \param *result: a pointer to an array containing the resultant log mel energies (one per filter)
  *
- * The data structure pointed to by *argv must be obtained by first calling xtract_init_mfcc
+ * The data structure pointed to by *argv must be obtained by first calling xtract_init_mfcc or xtract_init_mfcc_sparse
  */
 int xtract_mel_spectrogram(const double *data, const int N, const void *argv, double *result);
 
@@ -93,10 +109,10 @@ int xtract_mel_spectrogram(const double *data, const int N, const void *argv, do
  *
  * \param *data: a pointer to the first element in an array of spectral magnitudes, e.g. the first half of the array pointed to by *result from xtract_spectrum()
  * \param N: the number of array elements to be considered
- * \param *argv: a pointer to a data structure of type xtract_mel_filter, containing n_filters coefficient tables to make up a gammatone filterbank
+ * \param *argv: a pointer to a data structure of type xtract_mel_filter, in dense or sparse form, containing n_filters filters to make up a gammatone filterbank
  * \param *result: a pointer to an array containing the resultant GFCC
  *
- * The data structure pointed to by *argv must be obtained by first calling xtract_init_gfcc
+ * The data structure pointed to by *argv must be obtained by first calling xtract_init_gfcc or xtract_init_gfcc_sparse
  */
 int xtract_gfcc(const double *data, const int N, const void *argv, double *result);
 
@@ -107,10 +123,10 @@ int xtract_gfcc(const double *data, const int N, const void *argv, double *resul
  *
  * \param *data: a pointer to the first element in an array of spectral magnitudes, e.g. the first half of the array pointed to by *result from xtract_spectrum()
  * \param N: the number of array elements to be considered
- * \param *argv: a pointer to a data structure of type xtract_mel_filter, containing n_filters coefficient tables to make up a gammatone filterbank
+ * \param *argv: a pointer to a data structure of type xtract_mel_filter, in dense or sparse form, containing n_filters filters to make up a gammatone filterbank
  * \param *result: a pointer to an array containing the resultant log gammatone energies (one per filter)
  *
- * The data structure pointed to by *argv must be obtained by first calling xtract_init_gfcc
+ * The data structure pointed to by *argv must be obtained by first calling xtract_init_gfcc or xtract_init_gfcc_sparse
  */
 int xtract_gammatone_spectrogram(const double *data, const int N, const void *argv, double *result);
 
@@ -118,10 +134,10 @@ int xtract_gammatone_spectrogram(const double *data, const int N, const void *ar
  *
  * \param *data: a pointer to an array of spectral coefficients, the result from xtract_spectrum() by XTRACT_SPECTRUM_COEFFICIENTS
  * \param N: the number of array elements to be considered
- * \param *argv: a pointer to a data structure of type xtract_mel_filter, containing n_filters coefficient tables to make up a mel-spaced filterbank
+ * \param *argv: a pointer to a data structure of type xtract_mel_filter, in dense or sparse form, containing n_filters filters to make up a mel-spaced filterbank
  * \param *result: a pointer to an array containing the resultant MEL-MBSES
  *
- * The data structure pointed to by *argv must be obtained by first calling xtract_init_mfcc.
+ * The data structure pointed to by *argv must be obtained by first calling xtract_init_mfcc or xtract_init_mfcc_sparse.
  * The method is described by: Rincon et al: A Context-Aware Baby Monitor for the Automatic Selective Archiving of the Language of Infants (2013)
  */
 int xtract_mmbses(const double *data, const int N, const void *argv, double *result);
@@ -130,7 +146,7 @@ int xtract_mmbses(const double *data, const int N, const void *argv, double *res
  *
  * \param *data: a pointer to the first element in an array of doubles representing the spectrum of an audio vector, (e.g. the array pointed to by *result from xtract_spectrum(), xtract_peak_spectrum() or xtract_harmonic_spectrum()).
  * \param N: the number of array elements to be considered
- * \param *argv: a pointer to a data structure of type xtract_mel_filter, containing n_filters coefficient tables to make up a mel-spaced filterbank
+ * \param *argv: a pointer to a data structure of type xtract_mel_filter, in dense or sparse form, containing n_filters filters to make up a mel-spaced filterbank
  * \param *result: a pointer to an array containing the spectral band centroids
  *
  * Note: for a more 'accurate' result *result from xtract_peak_spectrum() can be passed in. This gives the interpolated peak frequency locations.
@@ -138,6 +154,9 @@ int xtract_mmbses(const double *data, const int N, const void *argv, double *res
 int xtract_spectral_subband_centroids(const double *data, const int N, const void *argv, double *result);
 
 /** \brief Extract the Discrete Cosine transform of a time domain signal
+ *
+ * Computes the unnormalised DCT-II, result[k] = sum_n data[n] cos(pi k (n + 1/2) / N), in O(N log N) time for any N. Plans are cached per size, so DCTs of different sizes can be mixed freely.
+ *
  * \param *data: a pointer to the first element in an array of doubles representing an audio vector
  * \param N: the number of array elements to be considered
  * \param *argv: a pointer to NULL 
@@ -171,6 +190,50 @@ int xtract_amdf(const double *data, const int N, const void *argv, double *resul
  * \param *result: the ASDF of N values from the array pointed to by *data 
  */
 int xtract_asdf(const double *data, const int N, const void *argv, double *result);
+
+/** \brief Extract the time-domain autocorrelation for a range of lags
+ *
+ * result[k] equals result[min_lag + k] from xtract_autocorrelation(). Only the requested lags are computed, e.g. up to samplerate / lowest f0 for pitch detection. The lags are computed directly or with an FFT of at least N + max_lag + 1 samples, whichever is cheaper for N and the range.
+ *
+ * \param *data: a pointer to the first element in an array of doubles representing an audio vector
+ * \param N: the number of array elements to be considered
+ * \param *argv: a pointer to an array of two doubles, the lowest and highest lag as whole numbers, with 0 <= min_lag <= max_lag < N
+ * \param *result: a pointer to an array of max_lag - min_lag + 1 doubles
+ */
+int xtract_autocorrelation_lags(const double *data, const int N, const void *argv, double *result);
+
+/** \brief Extract the Average Magnitude Difference Function for a range of lags
+ *
+ * result[k] equals result[min_lag + k] from xtract_amdf()
+ *
+ * \param *data: a pointer to the first element in an array of doubles representing an audio vector
+ * \param N: the number of array elements to be considered
+ * \param *argv: a pointer to an array of two doubles, the lowest and highest lag as whole numbers, with 0 <= min_lag <= max_lag < N
+ * \param *result: a pointer to an array of max_lag - min_lag + 1 doubles
+ */
+int xtract_amdf_lags(const double *data, const int N, const void *argv, double *result);
+
+/** \brief Extract the Average Squared Difference Function for a range of lags
+ *
+ * result[k] equals result[min_lag + k] from xtract_asdf(), up to rounding when the FFT method of xtract_asdf_fft() is chosen, which happens as for xtract_autocorrelation_lags()
+ *
+ * \param *data: a pointer to the first element in an array of doubles representing an audio vector
+ * \param N: the number of array elements to be considered
+ * \param *argv: a pointer to an array of two doubles, the lowest and highest lag as whole numbers, with 0 <= min_lag <= max_lag < N
+ * \param *result: a pointer to an array of max_lag - min_lag + 1 doubles
+ */
+int xtract_asdf_lags(const double *data, const int N, const void *argv, double *result);
+
+/** \brief Extract the Average Squared Difference Function using an FFT based method
+ *
+ * The squared difference at each lag is expanded into the energies of the two overlapping segments, kept as running sums, minus twice the autocorrelation, which is computed with an FFT. The cost is O(N log N) rather than the O(N^2) of xtract_asdf()
+ *
+ * \param *data: a pointer to the first element in an array of doubles representing an audio vector
+ * \param N: the number of array elements to be considered
+ * \param *argv: a pointer to NULL
+ * \param *result: the ASDF of N values from the array pointed to by *data
+ */
+int xtract_asdf_fft(const double *data, const int N, const void *argv, double *result);
     
 /** \brief Extract Bark band coefficients based on a method   
  * \param *data: a pointer to the first element in an array of doubles representing the magnitude coefficients from the magnitude spectrum of an audio vector, (e.g. the first half of the array pointed to by *result from xtract_spectrum().
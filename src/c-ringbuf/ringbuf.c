@@ -134,6 +134,25 @@ ringbuf_head(const struct ringbuf_t *rb)
     return rb->head;
 }
 
+size_t
+ringbuf_bytes_contiguous(const struct ringbuf_t *rb)
+{
+    if (rb->head >= rb->tail)
+        return rb->head - rb->tail;
+    else
+        return ringbuf_end(rb) - rb->tail;
+}
+
+void
+ringbuf_discard(ringbuf_t rb, size_t count)
+{
+    size_t bytes_used = ringbuf_bytes_used(rb);
+    if (count > bytes_used)
+        count = bytes_used;
+
+    rb->tail = rb->buf + (((rb->tail - rb->buf) + count) % ringbuf_buffer_size(rb));
+}
+
 /*
  * Given a ring buffer rb and a pointer to a location within its
  * contiguous buffer, return the a pointer to the next logical
@@ -103,6 +103,21 @@ ringbuf_tail(const struct ringbuf_t *rb);
 const void *
 ringbuf_head(const struct ringbuf_t *rb);
 
+/*
+ * The number of used bytes that can be read from the ring buffer's
+ * tail pointer before the data wraps to the start of the buffer.
+ */
+size_t
+ringbuf_bytes_contiguous(const struct ringbuf_t *rb);
+
+/*
+ * Drop count bytes from the ring buffer's tail without copying them.
+ * If count is greater than the number of bytes used, the ring buffer
+ * is emptied.
+ */
+void
+ringbuf_discard(ringbuf_t rb, size_t count);
+
 /*
  * Locate the first occurrence of character c (converted to an
  * unsigned char) in ring buffer rb, beginning the search at offset
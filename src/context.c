@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* context.c: defines functions for allocating and freeing xtract_context objects */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_context.h"
+#include "xtract_context_private.h"
+#include "xtract_macros_private.h"
+
+xtract_context *xtract_context_new(void)
+{
+    xtract_context *ctx = calloc(1, sizeof(xtract_context));
+
+    if (ctx == NULL)
+    {
+        perror("could not allocate memory for xtract_context");
+        return NULL;
+    }
+
+    dywapitch_inittracking(&ctx->wavelet_f0_state);
+
+    return ctx;
+}
+
+void xtract_context_delete(xtract_context *ctx)
+{
+    if (ctx == NULL)
+    {
+        return;
+    }
+
+    xtract_context_release(ctx);
+    free(ctx);
+}
+
+void xtract_context_release(xtract_context *ctx)
+{
+    xtract_context_free_fft(ctx);
+}
+
+double *xtract_context_work(xtract_context *ctx, int slot, size_t n)
+{
+    double *work;
+
+    if (n <= ctx->work_size[slot])
+    {
+        return ctx->work[slot];
+    }
+
+    work = realloc(ctx->work[slot], n * sizeof(double));
+
+    if (work == NULL)
+    {
+        return NULL;
+    }
+
+    ctx->work[slot] = work;
+    ctx->work_size[slot] = n;
+
+    return work;
+}
+
+float *xtract_context_workf(xtract_context *ctx, int slot, size_t n)
+{
+    return (float *)xtract_context_work(ctx, slot, (n + 1) / 2);
+}
+
+int *xtract_context_worki(xtract_context *ctx, int slot, size_t n)
+{
+    return (int *)xtract_context_work(ctx, slot, (n * sizeof(int) + sizeof(double) - 1) / sizeof(double));
+}
+
+const xtract_fft_plan *xtract_context_fft_plan(xtract_context *ctx, xtract_fft_data *fft_data, int N, int kind)
+{
+    const xtract_fft_backend *backend = xtract_fft_backend_for(N, kind);
+    const xtract_fft_plan *plan = fft_data->plan;
+    int n;
+
+    if (plan != NULL && plan->N == N && plan->kind == kind && plan->backend == backend)
+    {
+        return plan;
+    }
+
+    for (n = 0; n < XTRACT_CONTEXT_RECENT_PLANS; ++n)
+    {
+        plan = ctx->recent_plans[n];
+
+        if (plan != NULL && plan->N == N && plan->kind == kind && plan->backend == backend)
+        {
+            fft_data->plan = plan;
+            return plan;
+        }
+    }
+
+    plan = xtract_fft_plan_get(N, kind);
+
+    if (plan == NULL)
+    {
+        return NULL;
+    }
+
+    ctx->recent_plans[ctx->recent_plans_next] = plan;
+    ctx->recent_plans_next = (ctx->recent_plans_next + 1) % XTRACT_CONTEXT_RECENT_PLANS;
+    fft_data->plan = plan;
+
+    return plan;
+}
+
+int xtract_context_rdft(xtract_context *ctx, const xtract_fft_plan *plan, int isgn, double *a)
+{
+    double *work = NULL;
+
+    if (plan->work_size > 0)
+    {
+        work = xtract_context_work(ctx, XTRACT_WORK_FFT_BACKEND, plan->work_size);
+
+        if (work == NULL)
+        {
+            return XTRACT_MALLOC_FAILED;
+        }
+    }
+
+    plan->backend->rdft(plan, isgn, a, work);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_context_rdftf(xtract_context *ctx, const xtract_fft_plan *plan, int isgn, float *a)
+{
+    float *work = NULL;
+
+    if (plan->work_size > 0)
+    {
+        work = xtract_context_workf(ctx, XTRACT_WORK_FFT_BACKEND, plan->work_size);
+
+        if (work == NULL)
+        {
+            return XTRACT_MALLOC_FAILED;
+        }
+    }
+
+    plan->backend->rdftf(plan, isgn, a, work);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_context_dct(xtract_context *ctx, const xtract_fft_plan *plan, double *a)
+{
+    double *work = NULL;
+
+    if (plan->work_size > 0)
+    {
+        work = xtract_context_work(ctx, XTRACT_WORK_FFT_BACKEND, plan->work_size);
+
+        if (work == NULL)
+        {
+            return XTRACT_MALLOC_FAILED;
+        }
+    }
+
+    plan->backend->dct(plan, a, work);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_context_autocorrelation(xtract_context *ctx, const double *data, int N, int lags, double **r)
+{
+    const xtract_fft_plan *plan;
+    double *a, scale;
+    int M, n;
+
+    /* Zero pad so that the lags below lags don't wrap around */
+    M = xtract_fft_fast_size(N + lags);
+
+    plan = xtract_context_fft_plan(ctx, &ctx->fft_data_autocorrelation_fft, M, XTRACT_FFT_REAL);
+    if (plan == NULL)
+    {
+        return XTRACT_BAD_VECTOR_SIZE;
+    }
+
+    a = xtract_context_work(ctx, XTRACT_WORK_FFT, M);
+    if (a == NULL)
+    {
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    memcpy(a, data, N * sizeof(double));
+    memset(a + N, 0, (M - N) * sizeof(double));
+
+    if (xtract_context_rdft(ctx, plan, 1, a) != XTRACT_SUCCESS)
+    {
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    /* The inverse FFT of the power spectrum, scaled by M / 2 */
+    a[0] = XTRACT_SQ(a[0]);
+    a[1] = XTRACT_SQ(a[1]);
+    for (n = 2; n < M; n += 2)
+    {
+        a[n] = XTRACT_SQ(a[n]) + XTRACT_SQ(a[n + 1]);
+        a[n + 1] = 0.0;
+    }
+
+    if (xtract_context_rdft(ctx, plan, -1, a) != XTRACT_SUCCESS)
+    {
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    scale = 2.0 / M;
+    for (n = 0; n < lags; ++n)
+    {
+        a[n] *= scale;
+    }
+
+    *r = a;
+
+    return XTRACT_SUCCESS;
+}
@@ -27,1443 +27,1551 @@
 #include <string.h>
 #define XTRACT
 
-xtract_function_descriptor_t *xtract_make_descriptors(void)
-{
-
-    int f , F;
-    char *name, *p_name, *desc, *p_desc, *author;
-    double *argv_min, *argv_max, *argv_def, *result_min, *result_max;
-    int *argc, *year, *argv_donor;
-    xtract_vector_t *data_format, *result_format;
-    xtract_unit_t *data_unit, *argv_unit, *result_unit;
-    xtract_bool_t *is_scalar, *is_delta;
-    xtract_function_descriptor_t *fd, *d;
-    xtract_type_t *argv_type;
+/* The descriptors are a constant table indexed by feature, so that they live
+ * in read-only memory and cost nothing to set up. Argument fields beyond
+ * argc are left 0 and unused donors are XTRACT_ANY. The name lookup tables
+ * below must be regenerated with descriptors_hash.py when a name changes. */
+static const xtract_function_descriptor_t xtract_descriptors[XTRACT_FEATURES] = {
+    [XTRACT_MEAN] = {
+        .id = XTRACT_MEAN,
+        .algo = {
+            .name = "mean",
+            .p_name = "Mean",
+            .desc = "Extract the mean of an input vector",
+            .p_desc = "Extract the mean of a range of values",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_VARIANCE] = {
+        .id = XTRACT_VARIANCE,
+        .algo = {
+            .name = "variance",
+            .p_name = "Variance",
+            .desc = "Extract the variance of an input vector",
+            .p_desc = "Extract the variance of a range of values",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_MEAN, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_STANDARD_DEVIATION] = {
+        .id = XTRACT_STANDARD_DEVIATION,
+        .algo = {
+            .name = "standard_deviation",
+            .p_name = "Standard Deviation",
+            .desc = "Extract the standard deviation of an input vector",
+            .p_desc = "Extract the standard deviation of a range of values",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_VARIANCE, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_AVERAGE_DEVIATION] = {
+        .id = XTRACT_AVERAGE_DEVIATION,
+        .algo = {
+            .name = "average_deviation",
+            .p_name = "Average Deviation",
+            .desc = "Extract the average deviation of an input vector",
+            .p_desc = "Extract the average deviation of a range of values",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_MEAN, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_SKEWNESS] = {
+        .id = XTRACT_SKEWNESS,
+        .algo = {
+            .name = "skewness",
+            .p_name = "Skewness",
+            .desc = "Extract the skewness of an input vector",
+            .p_desc = "Extract the skewness of a range of values",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0, 0.0},
+            .max = {0.0, 0.0},
+            .def = {0.0, 0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_MEAN, XTRACT_STANDARD_DEVIATION, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_KURTOSIS] = {
+        .id = XTRACT_KURTOSIS,
+        .algo = {
+            .name = "kurtosis",
+            .p_name = "Kurtosis",
+            .desc = "Extract the kurtosis of an input vector",
+            .p_desc = "Extract the kurtosis of a range of values",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0, 0.0},
+            .max = {0.0, 0.0},
+            .def = {0.0, 0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_MEAN, XTRACT_STANDARD_DEVIATION, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_SPECTRAL_MEAN] = {
+        .id = XTRACT_SPECTRAL_MEAN,
+        .algo = {
+            .name = "spectral_mean",
+            .p_name = "Spectral Mean",
+            .desc = "Extract the mean of an input spectrum",
+            .p_desc = "Extract the mean of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_SPECTRAL_VARIANCE] = {
+        .id = XTRACT_SPECTRAL_VARIANCE,
+        .algo = {
+            .name = "spectral_variance",
+            .p_name = "Spectral Variance",
+            .desc = "Extract the variance of an input spectrum",
+            .p_desc = "Extract the variance of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_SPECTRAL_MEAN, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_SPECTRAL_STANDARD_DEVIATION] = {
+        .id = XTRACT_SPECTRAL_STANDARD_DEVIATION,
+        .algo = {
+            .name = "spectral_standard_deviation",
+            .p_name = "Spectral Standard Deviation",
+            .desc = "Extract the standard deviation of an input spectrum",
+            .p_desc = "Extract the standard deviation of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_SPECTRAL_VARIANCE, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_SPECTRAL_SKEWNESS] = {
+        .id = XTRACT_SPECTRAL_SKEWNESS,
+        .algo = {
+            .name = "spectral_skewness",
+            .p_name = "Spectral Skewness",
+            .desc = "Extract the skewness of an input spectrum",
+            .p_desc = "Extract the skewness of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0, 0.0},
+            .max = {0.0, 0.0},
+            .def = {0.0, 0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_SPECTRAL_MEAN, XTRACT_SPECTRAL_STANDARD_DEVIATION, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_SPECTRAL_KURTOSIS] = {
+        .id = XTRACT_SPECTRAL_KURTOSIS,
+        .algo = {
+            .name = "spectral_kurtosis",
+            .p_name = "Spectral Kurtosis",
+            .desc = "Extract the kurtosis of an input spectrum",
+            .p_desc = "Extract the kurtosis of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0, 0.0},
+            .max = {0.0, 0.0},
+            .def = {0.0, 0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_SPECTRAL_MEAN, XTRACT_SPECTRAL_STANDARD_DEVIATION, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_SPECTRAL_CENTROID] = {
+        .id = XTRACT_SPECTRAL_CENTROID,
+        .algo = {
+            .name = "spectral_centroid",
+            .p_name = "Spectral Centroid",
+            .desc = "Extract the spectral centroid of a spectrum",
+            .p_desc = "Extract the spectral centroid of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_IRREGULARITY_K] = {
+        .id = XTRACT_IRREGULARITY_K,
+        .algo = {
+            .name = "irregularity_k",
+            .p_name = "Irregularity I",
+            .desc = "Extract the irregularity (type I) of a spectrum",
+            .p_desc = "Extract the irregularity (type I) of an audio spectrum",
+            .author = "Krimphoff",
+            .year = 1994
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_IRREGULARITY_J] = {
+        .id = XTRACT_IRREGULARITY_J,
+        .algo = {
+            .name = "irregularity_j",
+            .p_name = "Irregularity II",
+            .desc = "Extract the irregularity (type II) of a spectrum",
+            .p_desc = "Extract the irregularity (type II) of an audio spectrum",
+            .author = "Jensen",
+            .year = 1999
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_TRISTIMULUS_1] = {
+        .id = XTRACT_TRISTIMULUS_1,
+        .algo = {
+            .name = "tristimulus_1",
+            .p_name = "Tristimulus I",
+            .desc = "Extract the tristimulus (type I) of a spectrum",
+            .p_desc = "Extract the tristimulus (type I) of an audio spectrum",
+            .author = "Pollard and Jansson",
+            .year = 1982
+        },
+        .data = {XTRACT_SPECTRAL_HARMONICS, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {XTRACT_SR_UPPER_LIMIT / 2.0},
+            .def = {XTRACT_FUNDAMENTAL_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_FAILSAFE_F0, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_TRISTIMULUS_2] = {
+        .id = XTRACT_TRISTIMULUS_2,
+        .algo = {
+            .name = "tristimulus_2",
+            .p_name = "Tristimulus II",
+            .desc = "Extract the tristimulus (type II) of a spectrum",
+            .p_desc = "Extract the tristimulus (type II) of an audio spectrum",
+            .author = "Pollard and Jansson",
+            .year = 1982
+        },
+        .data = {XTRACT_SPECTRAL_HARMONICS, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {XTRACT_SR_UPPER_LIMIT / 2.0},
+            .def = {XTRACT_FUNDAMENTAL_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_FAILSAFE_F0, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_TRISTIMULUS_3] = {
+        .id = XTRACT_TRISTIMULUS_3,
+        .algo = {
+            .name = "tristimulus_3",
+            .p_name = "Tristimulus III",
+            .desc = "Extract the tristimulus (type III) of a spectrum",
+            .p_desc = "Extract the tristimulus (type III) of an audio spectrum",
+            .author = "Pollard and Jansson",
+            .year = 1982
+        },
+        .data = {XTRACT_SPECTRAL_HARMONICS, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {XTRACT_SR_UPPER_LIMIT / 2.0},
+            .def = {XTRACT_FUNDAMENTAL_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_FAILSAFE_F0, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_SMOOTHNESS] = {
+        .id = XTRACT_SMOOTHNESS,
+        .algo = {
+            .name = "smoothness",
+            .p_name = "Spectral Smoothness",
+            .desc = "Extract the spectral smoothness of a spectrum",
+            .p_desc = "Extract the spectral smoothness of an audio spectrum",
+            .author = "McAdams",
+            .year = 1999
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_SPREAD] = {
+        .id = XTRACT_SPREAD,
+        .algo = {
+            .name = "spread",
+            .p_name = "Spectral Spread",
+            .desc = "Extract the spectral spread of a spectrum",
+            .p_desc = "Extract the spectral spread of an audio spectrum",
+            .author = "Norman Casagrande",
+            .year = 2005
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_ZCR] = {
+        .id = XTRACT_ZCR,
+        .algo = {
+            .name = "zcr",
+            .p_name = "Zero Crossing Rate",
+            .desc = "Extract the zero crossing rate of a vector",
+            .p_desc = "Extract the zero crossing rate of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, XTRACT_UNBOUNDED_MAX, XTRACT_HERTZ}
+    },
+    [XTRACT_ROLLOFF] = {
+        .id = XTRACT_ROLLOFF,
+        .algo = {
+            .name = "rolloff",
+            .p_name = "Spectral Rolloff",
+            .desc = "Extract the rolloff point of a spectrum",
+            .p_desc = "Extract the rolloff point of an audio spectrum",
+            .author = "Bee Suan Ong",
+            .year = 2005
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_FFT_BANDS_MIN, 0.0},
+            .max = {XTRACT_FFT_BANDS_MAX, 100.0},
+            .def = {XTRACT_SPEC_BW_DEF, 95.0},
+            .unit = {XTRACT_HERTZ, XTRACT_PERCENT},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_LOUDNESS] = {
+        .id = XTRACT_LOUDNESS,
+        .algo = {
+            .name = "loudness",
+            .p_name = "Loudness",
+            .desc = "Extract the loudness of a signal from its spectrum",
+            .p_desc = "Extract the loudness of an audio signal from its spectrum",
+            .author = "Moore, Glasberg et al",
+            .year = 2005
+        },
+        .data = {XTRACT_BARK_COEFFS, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_FLATNESS] = {
+        .id = XTRACT_FLATNESS,
+        .algo = {
+            .name = "flatness",
+            .p_name = "Spectral Flatness",
+            .desc = "Extract the spectral flatness of a spectrum",
+            .p_desc = "Extract the spectral flatness of an audio spectrum",
+            .author = "Tristan Jehan",
+            .year = 2005
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_FLATNESS_DB] = {
+        .id = XTRACT_FLATNESS_DB,
+        .algo = {
+            .name = "flatness_db",
+            .p_name = "Log Spectral Flatness",
+            .desc = "Extract the log spectral flatness of a spectrum",
+            .p_desc = "Extract the log spectral flatness of an audio spectrum",
+            .author = "Peeters",
+            .year = 2003
+        },
+        .data = {XTRACT_NO_DATA, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {1.0},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_FLATNESS, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, XTRACT_DBFS}
+    },
+    [XTRACT_TONALITY] = {
+        .id = XTRACT_TONALITY,
+        .algo = {
+            .name = "tonality",
+            .p_name = "Tonality",
+            .desc = "Extract the tonality of a spectrum",
+            .p_desc = "Extract the tonality an audio spectrum",
+            .author = "J. D. Johnston",
+            .year = 1988
+        },
+        .data = {XTRACT_NO_DATA, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_FLATNESS_DB, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_CREST] = {
+        .id = XTRACT_CREST,
+        .algo = {
+            .name = "crest",
+            .p_name = "Spectral Crest Measure",
+            .desc = "Extract the spectral crest measure of a spectrum",
+            .p_desc = "Extract the spectral crest measure of an audio spectrum",
+            .author = "Peeters",
+            .year = 2003
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0, 0.0},
+            .max = {0.0, 0.0},
+            .def = {0.0, 0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_HIGHEST_VALUE, XTRACT_MEAN, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_NOISINESS] = {
+        .id = XTRACT_NOISINESS,
+        .algo = {
+            .name = "noisiness",
+            .p_name = "Noisiness",
+            .desc = "Extract the noisiness of a spectrum",
+            .p_desc = "Extract the noisiness of an audio  spectrum",
+            .author = "Tae Hong Park",
+            .year = 2000
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0, 0.0},
+            .max = {0.0, 0.0},
+            .def = {0.0, 0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_SUM, XTRACT_SUM, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_RMS_AMPLITUDE] = {
+        .id = XTRACT_RMS_AMPLITUDE,
+        .algo = {
+            .name = "rms_amplitude",
+            .p_name = "RMS Amplitude",
+            .desc = "Extract the RMS amplitude of a signal",
+            .p_desc = "Extract the RMS amplitude of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_SPECTRAL_INHARMONICITY] = {
+        .id = XTRACT_SPECTRAL_INHARMONICITY,
+        .algo = {
+            .name = "spectral_inharmonicity",
+            .p_name = "Inharmonicity",
+            .desc = "Extract the inharmonicity of a spectrum",
+            .p_desc = "Extract the inharmonicity of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_PEAKS, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {XTRACT_SR_UPPER_LIMIT / 2.0},
+            .def = {XTRACT_FUNDAMENTAL_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_FAILSAFE_F0, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_POWER] = {
+        .id = XTRACT_POWER,
+        .algo = {
+            .name = "power",
+            .p_name = "Spectral Power",
+            .desc = "Extract the spectral power of a spectrum",
+            .p_desc = "Extract the spectral power of an audio spectrum",
+            .author = "Bee Suan Ong",
+            .year = 2005
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_ODD_EVEN_RATIO] = {
+        .id = XTRACT_ODD_EVEN_RATIO,
+        .algo = {
+            .name = "odd_even_ratio",
+            .p_name = "Odd/even Harmonic Ratio",
+            .desc = "Extract the odd-to-even harmonic ratio of a spectrum",
+            .p_desc = "Extract the odd-to-even harmonic ratio of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_HARMONICS, XTRACT_HERTZ},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {XTRACT_SR_UPPER_LIMIT / 2.0},
+            .def = {XTRACT_FUNDAMENTAL_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_FAILSAFE_F0, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 1.0, (xtract_unit_t)XTRACT_NONE}
+    },
+    [XTRACT_SHARPNESS] = {
+        .id = XTRACT_SHARPNESS,
+        .algo = {
+            .name = "sharpness",
+            .p_name = "Spectral Sharpness",
+            .desc = "Extract the spectral sharpness of a spectrum",
+            .p_desc = "Extract the spectral sharpness of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_BARK_COEFFS, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_SPECTRAL_SLOPE] = {
+        .id = XTRACT_SPECTRAL_SLOPE,
+        .algo = {
+            .name = "spectral_slope",
+            .p_name = "Spectral Slope",
+            .desc = "Extract the spectral slope of a spectrum",
+            .p_desc = "Extract the spectral slope of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_LOWEST_VALUE] = {
+        .id = XTRACT_LOWEST_VALUE,
+        .algo = {
+            .name = "lowest_value",
+            .p_name = "Lowest Value",
+            .desc = "Extract the lowest value from an input vector",
+            .p_desc = "Extract the lowest value from a given range",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_HIGHEST_VALUE] = {
+        .id = XTRACT_HIGHEST_VALUE,
+        .algo = {
+            .name = "highest_value",
+            .p_name = "Highest Value",
+            .desc = "Extract the highest value from an input vector",
+            .p_desc = "Extract the highest value from a given range",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_SUM] = {
+        .id = XTRACT_SUM,
+        .algo = {
+            .name = "sum",
+            .p_name = "Sum of Values",
+            .desc = "Extract the sum of the values in an input vector",
+            .p_desc = "Extract the sum of the values in a given range",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_NONZERO_COUNT] = {
+        .id = XTRACT_NONZERO_COUNT,
+        .algo = {
+            .name = "nonzero_count",
+            .p_name = "Non-zero count",
+            .desc = "Extract the number of non-zero elements in the input vector",
+            .p_desc = "Extract the number of non-zero elements in an input spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_PEAKS_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_HPS] = {
+        .id = XTRACT_HPS,
+        .algo = {
+            .name = "hps",
+            .p_name = "Harmonic Product Spectrum",
+            .desc = "Extract the harmonic product spectrum of a spectrum",
+            .p_desc = "Extract the harmonic product spectrum of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_F0] = {
+        .id = XTRACT_F0,
+        .algo = {
+            .name = "f0",
+            .p_name = "Fundamental Frequency",
+            .desc = "Extract the fundamental frequency	of a signal",
+            .p_desc = "Extract the fundamental frequency of an audio signal",
+            .author = "Jamie Bullock",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_SR_LOWER_LIMIT},
+            .max = {XTRACT_SR_UPPER_LIMIT},
+            .def = {XTRACT_SR_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_FAILSAFE_F0] = {
+        .id = XTRACT_FAILSAFE_F0,
+        .algo = {
+            .name = "failsafe_f0",
+            .p_name = "Fundamental Frequency (failsafe)",
+            .desc = "Extract the fundamental frequency of a signal (failsafe)",
+            .p_desc = "Extract the fundamental frequency of an audio signal (failsafe)",
+            .author = "Jamie Bullock",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_SR_LOWER_LIMIT},
+            .max = {XTRACT_SR_UPPER_LIMIT},
+            .def = {XTRACT_SR_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_WAVELET_F0] = {
+        .id = XTRACT_WAVELET_F0,
+        .algo = {
+            .name = "wavelet_f0",
+            .p_name = "Fundamental Frequency (wavelet method)",
+            .desc = "Extract the fundamental frequency of a signal (wavelet method)",
+            .p_desc = "Extract the fundamental frequency of an audio signal (wavelet method)",
+            .author = "Antoine Schmitt",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_SR_LOWER_LIMIT},
+            .max = {XTRACT_SR_UPPER_LIMIT},
+            .def = {XTRACT_SR_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_MCLEOD_F0] = {
+        .id = XTRACT_MCLEOD_F0,
+        .algo = {
+            .name = "mcleod_f0",
+            .p_name = "Fundamental Frequency (McLeod Pitch Method)",
+            .desc = "Extract the fundamental frequency of a signal (McLeod method)",
+            .p_desc = "Extract the fundamental frequency of an audio signal using the Normalised Square Difference Function",
+            .author = "Philip McLeod",
+            .year = 2005
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_SR_LOWER_LIMIT},
+            .max = {XTRACT_SR_UPPER_LIMIT},
+            .def = {XTRACT_SR_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_YIN_F0] = {
+        .id = XTRACT_YIN_F0,
+        .algo = {
+            .name = "yin_f0",
+            .p_name = "Fundamental Frequency (YIN)",
+            .desc = "Extract the fundamental frequency of a signal (YIN method)",
+            .p_desc = "Extract the fundamental frequency of an audio signal using the cumulative mean normalised difference function",
+            .author = "Alain de Cheveigne and Hideki Kawahara",
+            .year = 2002
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_SR_LOWER_LIMIT},
+            .max = {XTRACT_SR_UPPER_LIMIT},
+            .def = {XTRACT_SR_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 96000.0, XTRACT_HERTZ}
+    },
+    [XTRACT_MIDICENT] = {
+        .id = XTRACT_MIDICENT,
+        .algo = {
+            .name = "midicent",
+            .p_name = "Frequency to MIDI Cent conversion",
+            .desc = "Convert frequency in Hertz to Pitch in MIDI cents",
+            .p_desc = "Convert frequency in Hertz to Pitch in MIDI cents",
+            .author = "Jamie Bullock",
+            .year = 0
+        },
+        .data = {XTRACT_NO_DATA, (xtract_unit_t)XTRACT_NONE},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_SR_LOWER_LIMIT},
+            .max = {XTRACT_SR_UPPER_LIMIT},
+            .def = {XTRACT_SR_DEFAULT},
+            .unit = {XTRACT_HERTZ},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {0.0, 12700.0, XTRACT_MIDI_CENT}
+    },
+    [XTRACT_LNORM] = {
+        .id = XTRACT_LNORM,
+        .algo = {
+            .name = "lnorm",
+            .p_name = "L-norm",
+            .desc = "Extract the L-norm of a vector",
+            .p_desc = "Extract the L-norm of a vector",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 3,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {0.0},
+            .def = {0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_TRUE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_FLUX] = {
+        .id = XTRACT_FLUX,
+        .algo = {
+            .name = "flux",
+            .p_name = "Spectral Flux",
+            .desc = "Extract the spectral flux of a spectrum",
+            .p_desc = "Extract the spectral flux of an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 3,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {0.0},
+            .def = {0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_TRUE,
+        .result.scalar = {XTRACT_UNBOUNDED_MIN, XTRACT_UNBOUNDED_MAX, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_ATTACK_TIME] = {
+        .id = XTRACT_ATTACK_TIME,
+        .algo = {
+            .name = "attack_time",
+            .p_name = "Attack Time",
+            .desc = "Extract the attack time of a signal",
+            .p_desc = "Extract the attack time of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_NO_DATA, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_DECAY_TIME] = {
+        .id = XTRACT_DECAY_TIME,
+        .algo = {
+            .name = "decay_time",
+            .p_name = "Decay Time",
+            .desc = "Extract the decay time of a signal",
+            .p_desc = "Extract the decay time of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_NO_DATA, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_TRUE,
+        .is_delta = XTRACT_FALSE,
+        .result.scalar = {XTRACT_UNKNOWN_MIN, XTRACT_UNKNOWN_MAX, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_DIFFERENCE_VECTOR] = {
+        .id = XTRACT_DIFFERENCE_VECTOR,
+        .algo = {
+            .name = "difference_vector",
+            .p_name = "Difference vector",
+            .desc = "Extract the difference between two vectors",
+            .p_desc = "Extract the difference between two vectors",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SUBFRAMES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_TRUE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_AUTOCORRELATION] = {
+        .id = XTRACT_AUTOCORRELATION,
+        .algo = {
+            .name = "autocorrelation",
+            .p_name = "Autocorrelation",
+            .desc = "Extract the autocorrelation of a signal",
+            .p_desc = "Extract the autocorrelation of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_AMDF] = {
+        .id = XTRACT_AMDF,
+        .algo = {
+            .name = "amdf",
+            .p_name = "Average Magnitude Difference Function",
+            .desc = "Extract the AMDF of a signal",
+            .p_desc = "Extract the AMDF of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_ASDF] = {
+        .id = XTRACT_ASDF,
+        .algo = {
+            .name = "asdf",
+            .p_name = "Average Squared Difference Function",
+            .desc = "Extract the ASDF of a signal",
+            .p_desc = "Extract the ASDF of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_BARK_COEFFICIENTS] = {
+        .id = XTRACT_BARK_COEFFICIENTS,
+        .algo = {
+            .name = "bark_coefficients",
+            .p_name = "Bark Coefficients",
+            .desc = "Extract bark coefficients from a spectrum",
+            .p_desc = "Extract bark coefficients from an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = XTRACT_BARK_BANDS,
+        .argv = {
+            .type = XTRACT_INT,
+            .min = {0.0},
+            .max = {0.0},
+            .def = {0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_INIT_BARK, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_BARK_COEFFS, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_PEAK_SPECTRUM] = {
+        .id = XTRACT_PEAK_SPECTRUM,
+        .algo = {
+            .name = "peak_spectrum",
+            .p_name = "Peak Spectrum",
+            .desc = "Extract the spectral peaks from of a spectrum",
+            .p_desc = "Extract the spectral peaks from an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_SR_LOWER_LIMIT / 2.0, 0.0},
+            .max = {XTRACT_SR_UPPER_LIMIT / 2.0, 100.0},
+            .def = {XTRACT_SR_DEFAULT / 2.0, 10.0},
+            .unit = {XTRACT_HERTZ, XTRACT_PERCENT},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ}
+    },
+    [XTRACT_SPECTRUM] = {
+        .id = XTRACT_SPECTRUM,
+        .algo = {
+            .name = "spectrum",
+            .p_name = "Spectrum",
+            .desc = "Extract the spectrum of an input vector",
+            .p_desc = "Extract the spectrum of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 4,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {XTRACT_SR_LOWER_LIMIT / XTRACT_FFT_BANDS_MIN, 0.0, 0.0, 0.0},
+            .max = {XTRACT_SR_UPPER_LIMIT / XTRACT_FFT_BANDS_MAX, 3.0, 1.0, 1.0},
+            .def = {XTRACT_SR_DEFAULT / XTRACT_FFT_BANDS_DEF, 0.0, 0.0, 0.0},
+            .unit = {XTRACT_HERTZ, (xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ}
+    },
+    [XTRACT_AUTOCORRELATION_FFT] = {
+        .id = XTRACT_AUTOCORRELATION_FFT,
+        .algo = {
+            .name = "autocorrelation_fft",
+            .p_name = "Autocorrelation (FFT method)",
+            .desc = "Extract the autocorrelation of a signal (fft method)",
+            .p_desc = "Extract the autocorrelation of an audio signal (fft method)",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_MFCC] = {
+        .id = XTRACT_MFCC,
+        .algo = {
+            .name = "mfcc",
+            .p_name = "Mel-Frequency Cepstral Coefficients",
+            .desc = "Extract MFCC from a spectrum",
+            .p_desc = "Extract MFCC from an audio spectrum",
+            .author = "Rabiner",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_MEL_FILTER,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_INIT_MFCC, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_MEL_COEFFS, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_DCT] = {
+        .id = XTRACT_DCT,
+        .algo = {
+            .name = "dct",
+            .p_name = "Discrete Cosine Transform",
+            .desc = "Extract the DCT of a signal",
+            .p_desc = "Extract the DCT of an audio signal",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_AUDIO_SAMPLES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_HARMONIC_SPECTRUM] = {
+        .id = XTRACT_HARMONIC_SPECTRUM,
+        .algo = {
+            .name = "harmonic_spectrum",
+            .p_name = "Harmonic Spectrum",
+            .desc = "Extract the harmonics from a spectrum",
+            .p_desc = "Extract the harmonics from an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_PEAKS, XTRACT_ANY_AMPLITUDE_HERTZ},
+        .argc = 2,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0, 0.0},
+            .max = {XTRACT_SR_UPPER_LIMIT / 2.0, 1.0},
+            .def = {XTRACT_FUNDAMENTAL_DEFAULT, XTRACT_YIN_THRESHOLD_DEFAULT},
+            .unit = {XTRACT_HERTZ, (xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_FAILSAFE_F0, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_SPECTRAL, XTRACT_ANY_AMPLITUDE_HERTZ}
+    },
+    [XTRACT_LPC] = {
+        .id = XTRACT_LPC,
+        .algo = {
+            .name = "lpc",
+            .p_name = "Linear predictive coding coefficients",
+            .desc = "Extract LPC from autocorrelation coefficients",
+            .p_desc = "Extract LPC from autocorrelation coefficients",
+            .author = "Rabiner and Juang as implemented by Jutta Degener",
+            .year = 1994
+        },
+        .data = {XTRACT_AUTOCORRELATION_COEFFS, (xtract_unit_t)XTRACT_ANY},
+        .argc = 0,
+        .argv = {
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_LPC_COEFFS, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_LPCC] = {
+        .id = XTRACT_LPCC,
+        .algo = {
+            .name = "lpcc",
+            .p_name = "Linear predictive coding cepstral coefficients",
+            .desc = "Extract LPC cepstrum from LPC coefficients",
+            .p_desc = "Extract LPC cepstrum from LPC coefficients",
+            .author = "Rabiner and Juang",
+            .year = 1993
+        },
+        .data = {XTRACT_LPC_COEFFS, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_INT,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_LPCC_COEFFS, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_SUBBANDS] = {
+        .id = XTRACT_SUBBANDS,
+        .algo = {
+            .name = "subbands",
+            .p_name = "Sub band coefficients",
+            .desc = "Extract subband coefficients from spectral magnitudes",
+            .p_desc = "Extract subband coefficients from spectral magnitudes",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 4,
+        .argv = {
+            .type = XTRACT_INT,
+            .min = {XTRACT_UNBOUNDED_MIN, 1.0, 0.0, 0.0},
+            .max = {XTRACT_UNBOUNDED_MAX, 16384.0, 32.0, XTRACT_UNBOUNDED_MAX},
+            .def = {0.0, 4.0, 0.0, 0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE, (xtract_unit_t)XTRACT_NONE, XTRACT_BINS},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_MEL_SPECTROGRAM] = {
+        .id = XTRACT_MEL_SPECTROGRAM,
+        .algo = {
+            .name = "mel_spectrogram",
+            .p_name = "Mel Spectrogram",
+            .desc = "Extract log mel energies from a spectrum",
+            .p_desc = "Extract log-scaled mel-filtered energies from an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_MEL_FILTER,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_INIT_MFCC, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_MEL_COEFFS, XTRACT_DBFS}
+    },
+    [XTRACT_GFCC] = {
+        .id = XTRACT_GFCC,
+        .algo = {
+            .name = "gfcc",
+            .p_name = "Gammatone Frequency Cepstral Coefficients",
+            .desc = "Extract GFCC from a spectrum",
+            .p_desc = "Extract GFCC from an audio spectrum using a gammatone filterbank",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_MEL_FILTER,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_INIT_GFCC, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_MEL_COEFFS, (xtract_unit_t)XTRACT_UNKNOWN}
+    },
+    [XTRACT_GAMMATONE_SPECTROGRAM] = {
+        .id = XTRACT_GAMMATONE_SPECTROGRAM,
+        .algo = {
+            .name = "gammatone_spectrogram",
+            .p_name = "Gammatone Spectrogram",
+            .desc = "Extract log gammatone energies from a spectrum",
+            .p_desc = "Extract log-scaled gammatone-filtered energies from an audio spectrum",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_SPECTRAL_MAGNITUDES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_MEL_FILTER,
+            .min = {XTRACT_UNBOUNDED_MIN},
+            .max = {XTRACT_UNBOUNDED_MAX},
+            .def = {0.0},
+            .unit = {XTRACT_DBFS},
+            .donor = {XTRACT_INIT_GFCC, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_MEL_COEFFS, XTRACT_DBFS}
+    },
+    [XTRACT_WINDOWED] = {
+        .id = XTRACT_WINDOWED,
+        .algo = {
+            .name = "windowed",
+            .p_name = "Windowed frame",
+            .desc = "Apply a window function to a frame of data",
+            .p_desc = "Apply a window function to a frame of data",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = XTRACT_WINDOW_SIZE,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {0.0},
+            .def = {0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_INIT_WINDOWED, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    },
+    [XTRACT_SMOOTHED] = {
+        .id = XTRACT_SMOOTHED,
+        .algo = {
+            .name = "smoothed",
+            .p_name = "Smoothed frame",
+            .desc = "Apply a bidirectional smoothing filter to a frame of data",
+            .p_desc = "Apply a bidirectional smoothing filter to a frame of data",
+            .author = "",
+            .year = 0
+        },
+        .data = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY},
+        .argc = 1,
+        .argv = {
+            .type = XTRACT_FLOAT,
+            .min = {0.0},
+            .max = {0.0},
+            .def = {0.0},
+            .unit = {(xtract_unit_t)XTRACT_NONE},
+            .donor = {XTRACT_ANY, XTRACT_ANY, XTRACT_ANY, XTRACT_ANY}
+        },
+        .is_scalar = XTRACT_FALSE,
+        .is_delta = XTRACT_FALSE,
+        .result.vector = {XTRACT_ARBITRARY_SERIES, (xtract_unit_t)XTRACT_ANY}
+    }
+};
 
-    f = F = XTRACT_FEATURES;
+static const unsigned short xtract_name_seeds[32] = {
+    1, 1, 1, 1, 2, 4, 1, 0,
+    1, 3, 2, 5, 5, 0, 1, 0,
+    3, 4, 1, 1, 5, 1, 0, 2,
+    3, 0, 6, 1, 0, 7, 3, 1
+};
 
-    fd = (xtract_function_descriptor_t*)malloc(XTRACT_FEATURES * sizeof(xtract_function_descriptor_t));
-    if(fd == NULL)
-        return NULL;
+static const signed char xtract_name_slots[128] = {
+    -1, 0, 2, -1, 32, 31, -1, -1, 26, -1, -1, 57, -1, -1, 40, -1,
+    15, 1, -1, 66, 10, -1, 50, -1, 6, 8, -1, 17, -1, 52, -1, -1,
+    -1, 59, 7, 16, 20, -1, -1, -1, 43, 51, -1, 19, -1, -1, -1, 58,
+    54, -1, -1, -1, -1, -1, 47, 35, 27, -1, -1, 41, -1, -1, 30, -1,
+    -1, -1, -1, 48, -1, 22, 38, -1, 9, 14, 5, 63, -1, 29, 13, 53,
+    62, 25, -1, -1, -1, -1, -1, -1, 24, 36, 61, -1, 42, 23, 3, 64,
+    55, -1, -1, 18, -1, 44, 60, -1, -1, 11, -1, 45, -1, 56, -1, 4,
+    -1, 33, -1, 12, -1, -1, 65, 21, 39, 49, 34, -1, 46, 37, -1, 28
+};
 
-    /* FIX - this file probably needs a rewrite for readability */
+static unsigned int xtract_name_hash(const char *name, unsigned int seed)
+{
+    unsigned int h = 2166136261u ^ seed;
 
-    while(f--)
+    while(*name)
     {
+        h ^= (unsigned char)*name++;
+        h *= 16777619u;
+    }
 
-        d = &fd[f];
-        d->id = f;
-        argc = &d->argc;
-        argv_type = &d->argv.type;
-
-        argv_min = &d->argv.min[0];
-        argv_max = &d->argv.max[0];
-        argv_def = &d->argv.def[0];
-        argv_unit = &d->argv.unit[0];
-
-        switch (f)
-        {
-            /* argc = 1 */
-        case XTRACT_VARIANCE:
-        case XTRACT_SPECTRAL_VARIANCE:
-        case XTRACT_STANDARD_DEVIATION:
-        case XTRACT_DIFFERENCE_VECTOR:
-        case XTRACT_AVERAGE_DEVIATION:
-        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-            /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION: */
-        case XTRACT_LOWEST_VALUE:
-        case XTRACT_TONALITY:
-        case XTRACT_MFCC:
-        case XTRACT_MEL_SPECTROGRAM:
-        case XTRACT_GFCC:
-        case XTRACT_GAMMATONE_SPECTROGRAM:
-        case XTRACT_LPC:
-        case XTRACT_LPCC:
-            *argv_min = XTRACT_UNBOUNDED_MIN;
-            *argv_max = XTRACT_UNBOUNDED_MAX;
-            *argv_def = XTRACT_NO_DEFAULT;
-            *argv_unit = XTRACT_DBFS;
-            break;
-        case XTRACT_SPECTRAL_INHARMONICITY:
-            *argv_min = 0.0;
-            *argv_max = XTRACT_SR_UPPER_LIMIT / 2.0;
-            *argv_def = XTRACT_FUNDAMENTAL_DEFAULT;
-            *argv_unit = XTRACT_HERTZ;
-            break;
-        case XTRACT_F0:
-        case XTRACT_FAILSAFE_F0:
-        case XTRACT_WAVELET_F0:
-        case XTRACT_MCLEOD_F0:
-        case XTRACT_MIDICENT:
-            *argv_min = XTRACT_SR_LOWER_LIMIT;
-            *argv_max = XTRACT_SR_UPPER_LIMIT;
-            *argv_def = XTRACT_SR_DEFAULT;
-            *argv_unit = XTRACT_HERTZ;
-            break;
-        case XTRACT_FLATNESS_DB:
-            *argv_min = 0;
-            *argv_max = 1.0;
-            *argv_def = XTRACT_NO_DEFAULT;
-            *argv_unit = XTRACT_DBFS;
-            break;
-            /* argc = 2 */;
-        case XTRACT_ROLLOFF:
-            *argv_min  = XTRACT_FFT_BANDS_MIN;
-            *argv_max = XTRACT_FFT_BANDS_MAX;
-            *argv_def = XTRACT_SPEC_BW_DEF ;
-            *argv_unit = XTRACT_HERTZ;
-            *(argv_min + 1) = 0.0;
-            *(argv_max + 1) = 100.0;
-            *(argv_def + 1) = 95.0;
-            *(argv_unit + 1) = XTRACT_PERCENT;
-            break;
-        case XTRACT_PEAK_SPECTRUM:
-            *argv_min  = XTRACT_SR_LOWER_LIMIT / 2.0;
-            *argv_max = XTRACT_SR_UPPER_LIMIT / 2.0;
-            *argv_def = XTRACT_SR_DEFAULT / 2.0;
-            *argv_unit = XTRACT_HERTZ;
-            *(argv_min + 1) = 0.0;
-            *(argv_max + 1) = 100.0 ;
-            *(argv_def + 1) = 10.0 ;
-            *(argv_unit + 1) = XTRACT_PERCENT;
-            break;
-        case XTRACT_HARMONIC_SPECTRUM:
-            *argv_min = 0.0;
-            *argv_max = XTRACT_SR_UPPER_LIMIT / 2.0;
-            *argv_def = XTRACT_FUNDAMENTAL_DEFAULT;
-            *argv_unit = XTRACT_HERTZ;
-            *(argv_min + 1) = 0.0;
-            *(argv_max + 1) = 1.0 ;
-            *(argv_def + 1) = .1 ;
-            *(argv_unit + 1) = (xtract_unit_t)XTRACT_NONE;
-            break;
-        case XTRACT_NOISINESS:
-        case XTRACT_SKEWNESS:
-        case XTRACT_KURTOSIS:
-        case XTRACT_SPECTRAL_SKEWNESS:
-        case XTRACT_SPECTRAL_KURTOSIS:
-        case XTRACT_CREST:
-            *argv_min = XTRACT_NONE;
-            *argv_max = XTRACT_NONE;
-            *argv_def = XTRACT_NONE;
-            *argv_unit = (xtract_unit_t)XTRACT_NONE;
-            *(argv_min + 1) = XTRACT_NONE;
-            *(argv_max + 1) = XTRACT_NONE;
-            *(argv_def + 1) = XTRACT_NONE;
-            *(argv_unit + 1) = (xtract_unit_t)XTRACT_NONE;
-            break;
-            /* argc = 4 */
-        case XTRACT_SPECTRUM:
-            *argv_min  = XTRACT_SR_LOWER_LIMIT / XTRACT_FFT_BANDS_MIN;
-            *argv_max = XTRACT_SR_UPPER_LIMIT / XTRACT_FFT_BANDS_MAX;
-            *argv_def = XTRACT_SR_DEFAULT / XTRACT_FFT_BANDS_DEF;
-            *argv_unit = XTRACT_HERTZ;
-            *(argv_min + 1) = 0;
-            *(argv_max + 1) = 3 ;
-            *(argv_def + 1) = 0;
-            *(argv_unit + 1) = (xtract_unit_t)XTRACT_NONE;
-            *(argv_min + 2) = 0;
-            *(argv_max + 2) = 1;
-            *(argv_def + 2) = 0;
-            *(argv_unit + 2) = (xtract_unit_t)XTRACT_NONE;
-            *(argv_min + 3) = 0;
-            *(argv_max + 3) = 1;
-            *(argv_def + 3) = 0;
-            *(argv_unit + 3) = (xtract_unit_t)XTRACT_NONE;
-            break;
-        case XTRACT_SUBBANDS:
-            *argv_min  = XTRACT_UNBOUNDED_MIN;
-            *argv_max = XTRACT_UNBOUNDED_MAX;
-            *argv_def = XTRACT_MEAN;
-            *argv_unit = (xtract_unit_t)XTRACT_NONE;
-            *(argv_min + 1) = 1;
-            *(argv_max + 1) = 16384;
-            *(argv_def + 1) = 4;
-            *(argv_unit + 1) = (xtract_unit_t)XTRACT_NONE;
-            *(argv_min + 2) = 0;
-            *(argv_max + 2) = 32;
-            *(argv_def + 2) = 0;
-            *(argv_unit + 2) = (xtract_unit_t)XTRACT_NONE;
-            *(argv_min + 3) = 0;
-            *(argv_max + 3) = XTRACT_UNBOUNDED_MAX;
-            *(argv_def + 3) = 0;
-            *(argv_unit + 3) = XTRACT_BINS;
-            break;
-        case XTRACT_BARK_COEFFICIENTS:
-            /* BARK_COEFFICIENTS is special because argc = BARK_BANDS */
-        case XTRACT_WINDOWED:
-            /* WINDOWED is special because argc = window size = N */
-        case XTRACT_SMOOTHED:
-        default:
-            *argv_min = XTRACT_NONE;
-            *argv_max = XTRACT_NONE;
-            *argv_def = XTRACT_NONE;
-            *argv_unit = (xtract_unit_t)XTRACT_NONE;
-            break;
-        }
-
-        argv_donor = &d->argv.donor[0];
-
-        switch (f)
-        {
-            /* argc = 1 */
-        case XTRACT_VARIANCE:
-            *argv_donor = XTRACT_MEAN;
-            break;
-        case XTRACT_SPECTRAL_VARIANCE:
-            *argv_donor = XTRACT_SPECTRAL_MEAN;
-            break;
-        case XTRACT_STANDARD_DEVIATION:
-            *argv_donor = XTRACT_VARIANCE;
-            break;
-        case XTRACT_AVERAGE_DEVIATION:
-            *argv_donor = XTRACT_MEAN;
-            break;
-        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-            *argv_donor = XTRACT_SPECTRAL_VARIANCE;
-            break;
-            /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION:
-                *argv_donor = XTRACT_SPECTRAL_MEAN;
-                break; */
-        case XTRACT_SPECTRAL_INHARMONICITY:
-            *argv_donor = XTRACT_FAILSAFE_F0;
-            break;
-        case XTRACT_FLATNESS_DB:
-            *argv_donor = XTRACT_FLATNESS;
-            break;
-        case XTRACT_TONALITY:
-            *argv_donor = XTRACT_FLATNESS_DB;
-            break;
-        case XTRACT_LOWEST_VALUE:
-        case XTRACT_F0:
-        case XTRACT_FAILSAFE_F0:
-        case XTRACT_WAVELET_F0:
-        case XTRACT_MCLEOD_F0:
-        case XTRACT_MIDICENT:
-            *argv_donor = XTRACT_ANY;
-            break;
-        case XTRACT_MFCC:
-        case XTRACT_MEL_SPECTROGRAM:
-            *argv_donor = XTRACT_INIT_MFCC;
-            break;
-        case XTRACT_GFCC:
-        case XTRACT_GAMMATONE_SPECTROGRAM:
-            *argv_donor = XTRACT_INIT_GFCC;
-            break;
-            /* argc = 2 */;
-        case XTRACT_ROLLOFF:
-        case XTRACT_PEAK_SPECTRUM:
-        case XTRACT_FLUX:
-        case XTRACT_LNORM:
-            *argv_donor = XTRACT_ANY;
-            *(argv_donor + 1) = XTRACT_ANY;
-            break;
-        case XTRACT_SKEWNESS:
-        case XTRACT_KURTOSIS:
-            *argv_donor = XTRACT_MEAN;
-            *(argv_donor + 1) = XTRACT_STANDARD_DEVIATION;
-            break;
-        case XTRACT_SPECTRAL_SKEWNESS:
-        case XTRACT_SPECTRAL_KURTOSIS:
-            *argv_donor = XTRACT_SPECTRAL_MEAN;
-            *(argv_donor + 1) = XTRACT_SPECTRAL_STANDARD_DEVIATION;
-            break;
-        case XTRACT_HARMONIC_SPECTRUM:
-            *argv_donor = XTRACT_FAILSAFE_F0;
-            *(argv_donor + 1) = XTRACT_ANY;
-            break;
-        case XTRACT_NOISINESS:
-            *argv_donor = XTRACT_SUM;
-            *(argv_donor + 1) = XTRACT_SUM;
-            break;
-        case XTRACT_CREST:
-            *argv_donor = XTRACT_HIGHEST_VALUE;
-            *(argv_donor + 1) = XTRACT_MEAN;
-            break;
-            /* argc = 4 */
-        case XTRACT_SPECTRUM:
-            *argv_donor = XTRACT_ANY;
-            *(argv_donor + 1) = XTRACT_ANY;
-            *(argv_donor + 2) = XTRACT_ANY;
-            *(argv_donor + 3) = XTRACT_ANY;
-            break;
-        case XTRACT_SUBBANDS:
-            *argv_donor = XTRACT_ANY;
-            *(argv_donor + 1) = XTRACT_ANY;
-            *(argv_donor + 2) = XTRACT_ANY;
-            *(argv_donor + 3) = XTRACT_ANY;
-            break;
-            /* BARK_BANDS */
-        case XTRACT_BARK_COEFFICIENTS:
-            *argv_donor = XTRACT_INIT_BARK;
-            break;
-        case XTRACT_WINDOWED:
-            *argv_donor = XTRACT_INIT_WINDOWED;
-            break;
-        case XTRACT_SMOOTHED:
-        default:
-            *argv_donor = XTRACT_ANY;
-            break;
-        }
-
-        data_format = &d->data.format;
-
-        switch(f)
-        {
-
-        case XTRACT_MEAN:
-        case XTRACT_VARIANCE:
-        case XTRACT_STANDARD_DEVIATION:
-        case XTRACT_AVERAGE_DEVIATION:
-        case XTRACT_SKEWNESS:
-        case XTRACT_KURTOSIS:
-        case XTRACT_LOWEST_VALUE:
-        case XTRACT_HIGHEST_VALUE:
-        case XTRACT_SUM:
-        case XTRACT_WINDOWED:
-        case XTRACT_SMOOTHED:
-            *data_format = XTRACT_ARBITRARY_SERIES;
-            break;
-        case XTRACT_SPECTRAL_MEAN:
-        case XTRACT_SPECTRAL_VARIANCE:
-        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-            /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION: */
-        case XTRACT_SPECTRAL_SKEWNESS:
-        case XTRACT_SPECTRAL_KURTOSIS:
-        case XTRACT_SPECTRAL_CENTROID:
-        case XTRACT_SPECTRAL_SLOPE:
-            *data_format = XTRACT_SPECTRAL;
-            break;
-        case XTRACT_ROLLOFF:
-        case XTRACT_NOISINESS:
-        case XTRACT_BARK_COEFFICIENTS:
-        case XTRACT_CREST:
-        case XTRACT_IRREGULARITY_K:
-        case XTRACT_IRREGULARITY_J:
-        case XTRACT_SMOOTHNESS:
-        case XTRACT_FLATNESS:
-        case XTRACT_SPREAD:
-        case XTRACT_POWER:
-        case XTRACT_HPS:
-        case XTRACT_PEAK_SPECTRUM:
-        case XTRACT_SUBBANDS:
-        case XTRACT_MFCC:
-        case XTRACT_MEL_SPECTROGRAM:
-        case XTRACT_GFCC:
-        case XTRACT_GAMMATONE_SPECTROGRAM:
-            *data_format = XTRACT_SPECTRAL_MAGNITUDES;
-            break;
-        case XTRACT_LPC:
-            *data_format = XTRACT_AUTOCORRELATION_COEFFS;
-            break;
-        case XTRACT_LPCC:
-            *data_format = XTRACT_LPC_COEFFS;
-            break;
-        case XTRACT_SPECTRAL_INHARMONICITY:
-        case XTRACT_HARMONIC_SPECTRUM:
-            *data_format = XTRACT_SPECTRAL_PEAKS;
-            break;
-        case XTRACT_NONZERO_COUNT:
-            *data_format = XTRACT_SPECTRAL_PEAKS_MAGNITUDES;
-            break;
-        case XTRACT_F0:
-        case XTRACT_FAILSAFE_F0:
-        case XTRACT_WAVELET_F0:
-        case XTRACT_MCLEOD_F0:
-        case XTRACT_SPECTRUM:
-        case XTRACT_AUTOCORRELATION:
-        case XTRACT_AUTOCORRELATION_FFT:
-        case XTRACT_DCT:
-        case XTRACT_AMDF:
-        case XTRACT_ASDF:
-        case XTRACT_ZCR:
-        case XTRACT_RMS_AMPLITUDE:
-        case XTRACT_FLUX:
-        case XTRACT_LNORM:
-            *data_format = XTRACT_AUDIO_SAMPLES;
-            break;
-        case XTRACT_TONALITY:
-        case XTRACT_FLATNESS_DB:
-            *data_format = XTRACT_NO_DATA;
-            break;
-        case XTRACT_TRISTIMULUS_1:
-        case XTRACT_TRISTIMULUS_2:
-        case XTRACT_TRISTIMULUS_3:
-        case XTRACT_ODD_EVEN_RATIO:
-            *data_format = XTRACT_SPECTRAL_HARMONICS_MAGNITUDES;
-            break;
-        case XTRACT_LOUDNESS:
-        case XTRACT_SHARPNESS:
-            *data_format = XTRACT_BARK_COEFFS;
-            break;
-        case XTRACT_DIFFERENCE_VECTOR:
-            *data_format = XTRACT_SUBFRAMES;
-            break;
-        case XTRACT_ATTACK_TIME:
-        case XTRACT_DECAY_TIME:
-        case XTRACT_MIDICENT:
-        default:
-            *data_format = XTRACT_NO_DATA;
-            break;
-        }
-
-        data_unit = &d->data.unit;
-
-        switch(f)
-        {
-
-        case XTRACT_MEAN:
-        case XTRACT_VARIANCE:
-        case XTRACT_STANDARD_DEVIATION:
-        case XTRACT_AVERAGE_DEVIATION:
-        case XTRACT_SKEWNESS:
-        case XTRACT_KURTOSIS:
-        case XTRACT_LOWEST_VALUE:
-        case XTRACT_HIGHEST_VALUE:
-        case XTRACT_SUM:
-        case XTRACT_ZCR:
-        case XTRACT_PEAK_SPECTRUM:
-        case XTRACT_TRISTIMULUS_1:
-        case XTRACT_TRISTIMULUS_2:
-        case XTRACT_TRISTIMULUS_3:
-        case XTRACT_DCT:
-        case XTRACT_AMDF:
-        case XTRACT_ASDF:
-        case XTRACT_IRREGULARITY_K:
-        case XTRACT_IRREGULARITY_J:
-        case XTRACT_ATTACK_TIME:
-        case XTRACT_DECAY_TIME:
-        case XTRACT_DIFFERENCE_VECTOR:
-        case XTRACT_FLUX:
-        case XTRACT_LNORM:
-        case XTRACT_F0:
-        case XTRACT_FAILSAFE_F0:
-        case XTRACT_WAVELET_F0:
-        case XTRACT_MCLEOD_F0:
-        case XTRACT_MFCC:
-        case XTRACT_MEL_SPECTROGRAM:
-        case XTRACT_GFCC:
-        case XTRACT_GAMMATONE_SPECTROGRAM:
-        case XTRACT_AUTOCORRELATION:
-        case XTRACT_AUTOCORRELATION_FFT:
-        case XTRACT_ROLLOFF:
-        case XTRACT_NOISINESS:
-        case XTRACT_CREST:
-        case XTRACT_FLATNESS:
-        case XTRACT_FLATNESS_DB:
-        case XTRACT_POWER:
-        case XTRACT_BARK_COEFFICIENTS:
-        case XTRACT_RMS_AMPLITUDE:
-        case XTRACT_SMOOTHNESS:
-        case XTRACT_SPREAD:
-        case XTRACT_SHARPNESS:
-        case XTRACT_HPS:
-        case XTRACT_SPECTRUM:
-        case XTRACT_TONALITY:
-        case XTRACT_LOUDNESS:
-        case XTRACT_NONZERO_COUNT:
-        case XTRACT_LPC:
-        case XTRACT_LPCC:
-        case XTRACT_WINDOWED:
-        case XTRACT_SMOOTHED:
-        case XTRACT_SUBBANDS:
-            *data_unit = (xtract_unit_t)XTRACT_ANY;
-            break;
-        case XTRACT_SPECTRAL_MEAN:
-        case XTRACT_SPECTRAL_VARIANCE:
-        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-            /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION: */
-        case XTRACT_SPECTRAL_SKEWNESS:
-        case XTRACT_SPECTRAL_KURTOSIS:
-        case XTRACT_SPECTRAL_CENTROID:
-        case XTRACT_SPECTRAL_SLOPE:
-        case XTRACT_HARMONIC_SPECTRUM:
-        case XTRACT_SPECTRAL_INHARMONICITY:
-            *data_unit = XTRACT_ANY_AMPLITUDE_HERTZ;
-            break;
-        case XTRACT_ODD_EVEN_RATIO:
-            *data_unit = XTRACT_HERTZ;
-            break;
-        }
-
-        name = d->algo.name;
-        p_name = d->algo.p_name;
-        desc = d->algo.desc;
-        p_desc = d->algo.p_desc;
-        author = d->algo.author;
-        year = &d->algo.year;
-
-        strcpy(author, "");
-        *year = 0;
-
-        switch(f)
-        {
-        case XTRACT_MEAN:
-            strcpy(name, "mean");
-            strcpy(p_name, "Mean");
-            strcpy(desc, "Extract the mean of an input vector");
-            strcpy(p_desc, "Extract the mean of a range of values");
-            strcpy(author, "");
-            break;
-        case XTRACT_VARIANCE:
-            strcpy(name, "variance");
-            strcpy(p_name, "Variance");
-            strcpy(desc, "Extract the variance of an input vector");
-            strcpy(p_desc, "Extract the variance of a range of values");
-            strcpy(author, "");
-            break;
-        case XTRACT_STANDARD_DEVIATION:
-            strcpy(name, "standard_deviation");
-            strcpy(p_name, "Standard Deviation");
-            strcpy(desc,
-                   "Extract the standard deviation of an input vector");
-            strcpy(p_desc,
-                   "Extract the standard deviation of a range of values");
-            strcpy(author, "");
-            break;
-        case XTRACT_AVERAGE_DEVIATION:
-            strcpy(name, "average_deviation");
-            strcpy(p_name, "Average Deviation");
-            strcpy(desc,
-                   "Extract the average deviation of an input vector");
-            strcpy(p_desc,
-                   "Extract the average deviation of a range of values");
-            strcpy(author, "");
-            break;
-        case XTRACT_SKEWNESS:
-            strcpy(name, "skewness");
-            strcpy(p_name, "Skewness");
-            strcpy(desc,
-                   "Extract the skewness of an input vector");
-            strcpy(p_desc,
-                   "Extract the skewness of a range of values");
-            strcpy(author, "");
-            break;
-        case XTRACT_KURTOSIS:
-            strcpy(name, "kurtosis");
-            strcpy(p_name, "Kurtosis");
-            strcpy(desc,
-                   "Extract the kurtosis of an input vector");
-            strcpy(p_desc,
-                   "Extract the kurtosis of a range of values");
-            strcpy(author, "");
-            break;
-        case XTRACT_SPECTRAL_MEAN:
-            strcpy(name, "spectral_mean");
-            strcpy(p_name, "Spectral Mean");
-            strcpy(desc, "Extract the mean of an input spectrum");
-            strcpy(p_desc, "Extract the mean of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_SPECTRAL_VARIANCE:
-            strcpy(name, "spectral_variance");
-            strcpy(p_name, "Spectral Variance");
-            strcpy(desc, "Extract the variance of an input spectrum");
-            strcpy(p_desc, "Extract the variance of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-            strcpy(name, "spectral_standard_deviation");
-            strcpy(p_name, "Spectral Standard Deviation");
-            strcpy(desc,
-                   "Extract the standard deviation of an input spectrum");
-            strcpy(p_desc,
-                   "Extract the standard deviation of an audio spectrum");
-            strcpy(author, "");
-            break;
-            /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION:
-                strcpy(name, "spectral_average_deviation");
-                strcpy(p_name, "Spectral Average Deviation");
-                strcpy(desc,
-                        "Extract the average deviation of an input spectrum");
-                strcpy(p_desc,
-                        "Extract the average deviation of an audio spectrum");
-                strcpy(author, "");
-                break;
-                */
-        case XTRACT_ROLLOFF:
-            strcpy(name, "rolloff");
-            strcpy(p_name, "Spectral Rolloff");
-            strcpy(desc,
-                   "Extract the rolloff point of a spectrum");
-            strcpy(p_desc,
-                   "Extract the rolloff point of an audio spectrum");
-            strcpy(author, "Bee Suan Ong");
-            *year = 2005;
-            break;
-        case XTRACT_SPECTRAL_INHARMONICITY:
-            strcpy(name, "spectral_inharmonicity");
-            strcpy(p_name, "Inharmonicity");
-            strcpy(desc, "Extract the inharmonicity of a spectrum");
-            strcpy(p_desc,
-                   "Extract the inharmonicity of an audio spectrum");
-            break;
-        case XTRACT_SPECTRUM:
-            strcpy(name, "spectrum");
-            strcpy(p_name, "Spectrum");
-            strcpy(desc,
-                   "Extract the spectrum of an input vector");
-            strcpy(p_desc,
-                   "Extract the spectrum of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_ODD_EVEN_RATIO:
-            strcpy(name, "odd_even_ratio");
-            strcpy(p_name, "Odd/even Harmonic Ratio");
-            strcpy(desc,
-                   "Extract the odd-to-even harmonic ratio of a spectrum");
-            strcpy(p_desc,
-                   "Extract the odd-to-even harmonic ratio of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_LOWEST_VALUE:
-            strcpy(name, "lowest_value");
-            strcpy(p_name, "Lowest Value");
-            strcpy(desc, "Extract the lowest value from an input vector");
-            strcpy(p_desc, "Extract the lowest value from a given range");
-            strcpy(author, "");
-            break;
-        case XTRACT_F0:
-            strcpy(name, "f0");
-            strcpy(p_name, "Fundamental Frequency");
-            strcpy(desc, "Extract the fundamental frequency	of a signal");
-            strcpy(p_desc,
-                   "Extract the fundamental frequency of an audio signal");
-            strcpy(author, "Jamie Bullock");
-            break;
-        case XTRACT_FAILSAFE_F0:
-            strcpy(name, "failsafe_f0");
-            strcpy(p_name, "Fundamental Frequency (failsafe)");
-            strcpy(desc, "Extract the fundamental frequency of a signal (failsafe)");
-            strcpy(p_desc,
-                   "Extract the fundamental frequency of an audio signal (failsafe)");
-            strcpy(author, "Jamie Bullock");
-            break;
-        case XTRACT_WAVELET_F0:
-            strcpy(name, "wavelet_f0");
-            strcpy(p_name, "Fundamental Frequency (wavelet method)");
-            strcpy(desc, "Extract the fundamental frequency of a signal (wavelet method)");
-            strcpy(p_desc,
-                   "Extract the fundamental frequency of an audio signal (wavelet method)");
-            strcpy(author, "Antoine Schmitt");
-            break;
-        case XTRACT_MCLEOD_F0:
-            strcpy(name, "mcleod_f0");
-            strcpy(p_name, "Fundamental Frequency (McLeod Pitch Method)");
-            strcpy(desc, "Extract the fundamental frequency of a signal (McLeod method)");
-            strcpy(p_desc,
-                   "Extract the fundamental frequency of an audio signal using the Normalised Square Difference Function");
-            strcpy(author, "Philip McLeod");
-            *year = 2005;
-            break;
-        case XTRACT_MIDICENT:
-                strcpy(name, "midicent");
-                strcpy(p_name, "Frequency to MIDI Cent conversion");
-                strcpy(desc, "Convert frequency in Hertz to Pitch in MIDI cents");
-                strcpy(p_desc, "Convert frequency in Hertz to Pitch in MIDI cents");
-                strcpy(author, "Jamie Bullock");
-                break;
-        case XTRACT_TONALITY:
-            strcpy(name, "tonality");
-            strcpy(p_name, "Tonality");
-            strcpy(desc, "Extract the tonality of a spectrum");
-            strcpy(p_desc, "Extract the tonality an audio spectrum");
-            strcpy(author, "J. D. Johnston");
-            *year = 1988;
-            break;
-        case XTRACT_SPECTRAL_SKEWNESS:
-            strcpy(name, "spectral_skewness");
-            strcpy(p_name, "Spectral Skewness");
-            strcpy(desc, "Extract the skewness of an input spectrum");
-            strcpy(p_desc, "Extract the skewness of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_SPECTRAL_KURTOSIS:
-            strcpy(name, "spectral_kurtosis");
-            strcpy(p_name, "Spectral Kurtosis");
-            strcpy(desc, "Extract the kurtosis of an input spectrum");
-            strcpy(p_desc, "Extract the kurtosis of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_PEAK_SPECTRUM:
-            strcpy(name, "peak_spectrum");
-            strcpy(p_name, "Peak Spectrum");
-            strcpy(desc, "Extract the spectral peaks from of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral peaks from an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_HARMONIC_SPECTRUM:
-            strcpy(name, "harmonic_spectrum");
-            strcpy(p_name, "Harmonic Spectrum");
-            strcpy(desc, "Extract the harmonics from a spectrum");
-            strcpy(p_desc, "Extract the harmonics from an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_NOISINESS:
-            strcpy(name, "noisiness");
-            strcpy(p_name, "Noisiness");
-            strcpy(desc, "Extract the noisiness of a spectrum");
-            strcpy(p_desc, "Extract the noisiness of an audio  spectrum");
-            strcpy(author, "Tae Hong Park");
-            *year = 2000;
-            break;
-        case XTRACT_CREST:
-            strcpy(name, "crest");
-            strcpy(p_name, "Spectral Crest Measure");
-            strcpy(desc,
-                   "Extract the spectral crest measure of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral crest measure of an audio spectrum");
-            strcpy(author, "Peeters");
-            *year = 2003;
-            break;
-        case XTRACT_MFCC:
-            strcpy(name, "mfcc");
-            strcpy(p_name, "Mel-Frequency Cepstral Coefficients");
-            strcpy(desc, "Extract MFCC from a spectrum");
-            strcpy(p_desc, "Extract MFCC from an audio spectrum");
-            strcpy(author, "Rabiner");
-            break;
-        case XTRACT_MEL_SPECTROGRAM:
-            strcpy(name, "mel_spectrogram");
-            strcpy(p_name, "Mel Spectrogram");
-            strcpy(desc, "Extract log mel energies from a spectrum");
-            strcpy(p_desc, "Extract log-scaled mel-filtered energies from an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_GFCC:
-            strcpy(name, "gfcc");
-            strcpy(p_name, "Gammatone Frequency Cepstral Coefficients");
-            strcpy(desc, "Extract GFCC from a spectrum");
-            strcpy(p_desc, "Extract GFCC from an audio spectrum using a gammatone filterbank");
-            strcpy(author, "");
-            break;
-        case XTRACT_GAMMATONE_SPECTROGRAM:
-            strcpy(name, "gammatone_spectrogram");
-            strcpy(p_name, "Gammatone Spectrogram");
-            strcpy(desc, "Extract log gammatone energies from a spectrum");
-            strcpy(p_desc, "Extract log-scaled gammatone-filtered energies from an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_LPC:
-            strcpy(name, "lpc");
-            strcpy(p_name, "Linear predictive coding coefficients");
-            strcpy(desc, "Extract LPC from autocorrelation coefficients");
-            strcpy(p_desc,
-                   "Extract LPC from autocorrelation coefficients");
-            strcpy(author,
-                   "Rabiner and Juang as implemented by Jutta Degener");
-            *year = 1994;
-            break;
-        case XTRACT_LPCC:
-            strcpy(name, "lpcc");
-            strcpy(p_name, "Linear predictive coding cepstral coefficients");
-            strcpy(desc, "Extract LPC cepstrum from LPC coefficients");
-            strcpy(p_desc,
-                   "Extract LPC cepstrum from LPC coefficients");
-            strcpy(author, "Rabiner and Juang");
-            *year = 1993;
-            break;
-        case XTRACT_SUBBANDS:
-            strcpy(name, "subbands");
-            strcpy(p_name, "Sub band coefficients");
-            strcpy(desc, "Extract subband coefficients from spectral magnitudes");
-            strcpy(p_desc,
-                   "Extract subband coefficients from spectral magnitudes");
-            strcpy(author, "");
-            break;
-        case XTRACT_BARK_COEFFICIENTS:
-            strcpy(name, "bark_coefficients");
-            strcpy(p_name, "Bark Coefficients");
-            strcpy(desc, "Extract bark coefficients from a spectrum");
-            strcpy(p_desc,
-                   "Extract bark coefficients from an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_SPECTRAL_CENTROID:
-            strcpy(name, "spectral_centroid");
-            strcpy(p_name, "Spectral Centroid");
-            strcpy(desc, "Extract the spectral centroid of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral centroid of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_IRREGULARITY_K:
-            strcpy(name, "irregularity_k");
-            strcpy(p_name, "Irregularity I");
-            strcpy(desc, "Extract the irregularity (type I) of a spectrum");
-            strcpy(p_desc,
-                   "Extract the irregularity (type I) of an audio spectrum");
-            strcpy(author, "Krimphoff");
-            *year = 1994;
-            break;
-        case XTRACT_IRREGULARITY_J:
-            strcpy(name, "irregularity_j");
-            strcpy(p_name, "Irregularity II");
-            strcpy(desc, "Extract the irregularity (type II) of a spectrum");
-            strcpy(p_desc,
-                   "Extract the irregularity (type II) of an audio spectrum");
-            strcpy(author, "Jensen");
-            *year = 1999;
-            break;
-        case XTRACT_TRISTIMULUS_1:
-            strcpy(name, "tristimulus_1");
-            strcpy(p_name, "Tristimulus I");
-            strcpy(desc, "Extract the tristimulus (type I) of a spectrum");
-            strcpy(p_desc,
-                   "Extract the tristimulus (type I) of an audio spectrum");
-            strcpy(author, "Pollard and Jansson");
-            *year = 1982;
-            break;
-        case XTRACT_TRISTIMULUS_2:
-            strcpy(name, "tristimulus_2");
-            strcpy(p_name, "Tristimulus II");
-            strcpy(desc, "Extract the tristimulus (type II) of a spectrum");
-            strcpy(p_desc,
-                   "Extract the tristimulus (type II) of an audio spectrum");
-            strcpy(author, "Pollard and Jansson");
-            *year = 1982;
-            break;
-        case XTRACT_TRISTIMULUS_3:
-            strcpy(name, "tristimulus_3");
-            strcpy(p_name, "Tristimulus III");
-            strcpy(desc,
-                   "Extract the tristimulus (type III) of a spectrum");
-            strcpy(p_desc,
-                   "Extract the tristimulus (type III) of an audio spectrum");
-            strcpy(author, "Pollard and Jansson");
-            *year = 1982;
-            break;
-        case XTRACT_SMOOTHNESS:
-            strcpy(name, "smoothness");
-            strcpy(p_name, "Spectral Smoothness");
-            strcpy(desc, "Extract the spectral smoothness of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral smoothness of an audio spectrum");
-            strcpy(author, "McAdams");
-            *year = 1999;
-            break;
-        case XTRACT_FLATNESS:
-            strcpy(name, "flatness");
-            strcpy(p_name, "Spectral Flatness");
-            strcpy(desc, "Extract the spectral flatness of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral flatness of an audio spectrum");
-            strcpy(author, "Tristan Jehan");
-            *year = 2005;
-            break;
-        case XTRACT_FLATNESS_DB:
-            strcpy(name, "flatness_db");
-            strcpy(p_name, "Log Spectral Flatness");
-            strcpy(desc, "Extract the log spectral flatness of a spectrum");
-            strcpy(p_desc,
-                   "Extract the log spectral flatness of an audio spectrum");
-            strcpy(author, "Peeters");
-            *year = 2003;
-            break;
-        case XTRACT_SPREAD:
-            strcpy(name, "spread");
-            strcpy(p_name, "Spectral Spread");
-            strcpy(desc, "Extract the spectral spread of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral spread of an audio spectrum");
-            strcpy(author, "Norman Casagrande");
-            *year = 2005;
-            break;
-        case XTRACT_ZCR:
-            strcpy(name, "zcr");
-            strcpy(p_name, "Zero Crossing Rate");
-            strcpy(desc, "Extract the zero crossing rate of a vector");
-            strcpy(p_desc,
-                   "Extract the zero crossing rate of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_LOUDNESS:
-            strcpy(name, "loudness");
-            strcpy(p_name, "Loudness");
-            strcpy(desc,
-                   "Extract the loudness of a signal from its spectrum");
-            strcpy(p_desc,
-                   "Extract the loudness of an audio signal from its spectrum");
-            strcpy(author, "Moore, Glasberg et al");
-            *year = 2005;
-            break;
-        case XTRACT_HIGHEST_VALUE:
-            strcpy(name, "highest_value");
-            strcpy(p_name, "Highest Value");
-            strcpy(desc, "Extract the highest value from an input vector");
-            strcpy(p_desc, "Extract the highest value from a given range");
-            strcpy(author, "");
-            break;
-        case XTRACT_SUM:
-            strcpy(name, "sum");
-            strcpy(p_name, "Sum of Values");
-            strcpy(desc,
-                   "Extract the sum of the values in an input vector");
-            strcpy(p_desc,
-                   "Extract the sum of the values in a given range");
-            strcpy(author, "");
-            break;
-        case XTRACT_RMS_AMPLITUDE:
-            strcpy(name, "rms_amplitude");
-            strcpy(p_name, "RMS Amplitude");
-            strcpy(desc, "Extract the RMS amplitude of a signal");
-            strcpy(p_desc, "Extract the RMS amplitude of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_POWER:
-            strcpy(name, "power");
-            strcpy(p_name, "Spectral Power");
-            strcpy(desc, "Extract the spectral power of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral power of an audio spectrum");
-            strcpy(author, "Bee Suan Ong");
-            *year = 2005;
-            break;
-        case XTRACT_SHARPNESS:
-            strcpy(name, "sharpness");
-            strcpy(p_name, "Spectral Sharpness");
-            strcpy(desc, "Extract the spectral sharpness of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral sharpness of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_SPECTRAL_SLOPE:
-            strcpy(name, "spectral_slope");
-            strcpy(p_name, "Spectral Slope");
-            strcpy(desc, "Extract the spectral slope of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral slope of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_HPS:
-            strcpy(name, "hps");
-            strcpy(p_name, "Harmonic Product Spectrum");
-            strcpy(desc,
-                   "Extract the harmonic product spectrum of a spectrum");
-            strcpy(p_desc,
-                   "Extract the harmonic product spectrum of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_FLUX:
-            strcpy(name, "flux");
-            strcpy(p_name, "Spectral Flux");
-            strcpy(desc, "Extract the spectral flux of a spectrum");
-            strcpy(p_desc,
-                   "Extract the spectral flux of an audio spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_LNORM:
-            strcpy(name, "lnorm");
-            strcpy(p_name, "L-norm");
-            strcpy(desc, "Extract the L-norm of a vector");
-            strcpy(p_desc, "Extract the L-norm of a vector");
-            strcpy(author, "");
-            break;
-        case XTRACT_ATTACK_TIME:
-            strcpy(name, "attack_time");
-            strcpy(p_name, "Attack Time");
-            strcpy(desc, "Extract the attack time of a signal");
-            strcpy(p_desc, "Extract the attack time of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_DECAY_TIME:
-            strcpy(name, "decay_time");
-            strcpy(p_name, "Decay Time");
-            strcpy(desc, "Extract the decay time of a signal");
-            strcpy(p_desc, "Extract the decay time of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_DIFFERENCE_VECTOR:
-            strcpy(name, "difference_vector");
-            strcpy(p_name, "Difference vector");
-            strcpy(desc, "Extract the difference between two vectors");
-            strcpy(p_desc, "Extract the difference between two vectors");
-            strcpy(author, "");
-            break;
-        case XTRACT_AUTOCORRELATION_FFT:
-            strcpy(name, "autocorrelation_fft");
-            strcpy(p_name, "Autocorrelation (FFT method)");
-            strcpy(desc, "Extract the autocorrelation of a signal (fft method)");
-            strcpy(p_desc, "Extract the autocorrelation of an audio signal (fft method)");
-            strcpy(author, "");
-            break;
-        case XTRACT_DCT:
-            strcpy(name, "dct");
-            strcpy(p_name, "Discrete Cosine Transform");
-            strcpy(desc, "Extract the DCT of a signal");
-            strcpy(p_desc, "Extract the DCT of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_AUTOCORRELATION:
-            strcpy(name, "autocorrelation");
-            strcpy(p_name, "Autocorrelation");
-            strcpy(desc, "Extract the autocorrelation of a signal");
-            strcpy(p_desc,
-                   "Extract the autocorrelation of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_AMDF:
-            strcpy(name, "amdf");
-            strcpy(p_name, "Average Magnitude Difference Function");
-            strcpy(desc, "Extract the AMDF of a signal");
-            strcpy(p_desc, "Extract the AMDF of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_ASDF:
-            strcpy(name, "asdf");
-            strcpy(p_name, "Average Squared Difference Function");
-            strcpy(desc, "Extract the ASDF of a signal");
-            strcpy(p_desc, "Extract the ASDF of an audio signal");
-            strcpy(author, "");
-            break;
-        case XTRACT_NONZERO_COUNT:
-            strcpy(name, "nonzero_count");
-            strcpy(p_name, "Non-zero count");
-            strcpy(desc,
-                   "Extract the number of non-zero elements in the input vector");
-            strcpy(p_desc,
-                   "Extract the number of non-zero elements in an input spectrum");
-            strcpy(author, "");
-            break;
-        case XTRACT_WINDOWED:
-            strcpy(name, "windowed");
-            strcpy(p_name, "Windowed frame");
-            strcpy(desc, "Apply a window function to a frame of data");
-            strcpy(p_desc, "Apply a window function to a frame of data");
-            strcpy(author, "");
-            break;
-        case XTRACT_SMOOTHED:
-            strcpy(name, "smoothed");
-            strcpy(p_name, "Smoothed frame");
-            strcpy(desc, "Apply a bidirectional smoothing filter to a frame of data");
-            strcpy(p_desc, "Apply a bidirectional smoothing filter to a frame of data");
-            strcpy(author, "");
-            break;
-        default:
-            strcpy(name, "");
-            strcpy(p_name, "");
-            strcpy(desc, "");
-            strcpy(p_desc, "");
-            strcpy(author, "");
-            break;
-        }
-
-        switch(f)
-        {
-
-        case XTRACT_VARIANCE:
-        case XTRACT_STANDARD_DEVIATION:
-        case XTRACT_AVERAGE_DEVIATION:
-        case XTRACT_SPECTRAL_VARIANCE:
-        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-            /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION: */
-        case XTRACT_SPECTRAL_INHARMONICITY:
-        case XTRACT_LOWEST_VALUE:
-        case XTRACT_F0:
-        case XTRACT_FAILSAFE_F0:
-        case XTRACT_WAVELET_F0:
-        case XTRACT_MCLEOD_F0:
-        case XTRACT_MIDICENT:
-        case XTRACT_FLATNESS_DB:
-        case XTRACT_TONALITY:
-            *argc = 1;
-            *argv_type = XTRACT_FLOAT;
-            break;
-        case XTRACT_SKEWNESS:
-        case XTRACT_KURTOSIS:
-        case XTRACT_SPECTRAL_SKEWNESS:
-        case XTRACT_SPECTRAL_KURTOSIS:
-        case XTRACT_PEAK_SPECTRUM:
-        case XTRACT_HARMONIC_SPECTRUM:
-        case XTRACT_NOISINESS:
-        case XTRACT_CREST:
-        case XTRACT_ROLLOFF:
-            *argc = 2;
-            *argv_type = XTRACT_FLOAT;
-            break;
-        case XTRACT_FLUX:
-        case XTRACT_LNORM:
-            *argc = 3;
-            *argv_type = XTRACT_FLOAT;
-            break;
-        case XTRACT_SPECTRUM:
-            *argc = 4;
-            *argv_type = XTRACT_FLOAT;
-            break;
-        case XTRACT_SUBBANDS:
-            *argc = 4;
-            *argv_type = XTRACT_INT;
-            break;
-        case XTRACT_MFCC:
-        case XTRACT_MEL_SPECTROGRAM:
-        case XTRACT_GFCC:
-        case XTRACT_GAMMATONE_SPECTROGRAM:
-            *argc = 1;
-            *argv_type = XTRACT_MEL_FILTER;
-            break;
-        case XTRACT_LPCC:
-            *argc = 1;
-            *argv_type = XTRACT_INT;
-            break;
-        case XTRACT_BARK_COEFFICIENTS:
-            *argc = XTRACT_BARK_BANDS;
-            *argv_type = XTRACT_INT;
-            break;
-        case XTRACT_WINDOWED:
-            *argc = XTRACT_WINDOW_SIZE;
-            *argv_type = XTRACT_FLOAT;
-            break;
-        case XTRACT_SMOOTHED:
-            *argc = 1;
-            *argv_type = XTRACT_FLOAT;
-            break;
-        case XTRACT_MEAN:
-        case XTRACT_SPECTRAL_MEAN:
-        case XTRACT_SPECTRAL_CENTROID:
-        case XTRACT_IRREGULARITY_K:
-        case XTRACT_IRREGULARITY_J:
-        case XTRACT_TRISTIMULUS_1:
-        case XTRACT_TRISTIMULUS_2:
-        case XTRACT_TRISTIMULUS_3:
-        case XTRACT_SMOOTHNESS:
-        case XTRACT_FLATNESS:
-        case XTRACT_SPREAD:
-        case XTRACT_ZCR:
-        case XTRACT_LOUDNESS:
-        case XTRACT_HIGHEST_VALUE:
-        case XTRACT_SUM:
-        case XTRACT_RMS_AMPLITUDE:
-        case XTRACT_POWER:
-        case XTRACT_SHARPNESS:
-        case XTRACT_SPECTRAL_SLOPE:
-        case XTRACT_HPS:
-        case XTRACT_ATTACK_TIME:
-        case XTRACT_DECAY_TIME:
-        case XTRACT_DIFFERENCE_VECTOR:
-        case XTRACT_AUTOCORRELATION_FFT:
-        case XTRACT_DCT:
-        case XTRACT_AUTOCORRELATION:
-        case XTRACT_AMDF:
-        case XTRACT_ASDF:
-        case XTRACT_NONZERO_COUNT:
-        case XTRACT_ODD_EVEN_RATIO:
-        case XTRACT_LPC:
-        default:
-            *argc = 0;
-            break;
-        }
+    return h;
+}
 
-        is_scalar = &d->is_scalar;
+const xtract_function_descriptor_t *xtract_get_descriptor(int feature)
+{
+    if(feature < 0 || feature >= XTRACT_FEATURES)
+        return NULL;
 
-        switch(f)
-        {
-        case XTRACT_MEAN:
-        case XTRACT_VARIANCE:
-        case XTRACT_STANDARD_DEVIATION:
-        case XTRACT_AVERAGE_DEVIATION:
-        case XTRACT_SKEWNESS:
-        case XTRACT_KURTOSIS:
-        case XTRACT_SPECTRAL_MEAN:
-        case XTRACT_SPECTRAL_VARIANCE:
-        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-            /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION: */
-        case XTRACT_SPECTRAL_SKEWNESS:
-        case XTRACT_SPECTRAL_KURTOSIS:
-        case XTRACT_SPECTRAL_CENTROID:
-        case XTRACT_IRREGULARITY_K:
-        case XTRACT_IRREGULARITY_J:
-        case XTRACT_TRISTIMULUS_1:
-        case XTRACT_TRISTIMULUS_2:
-        case XTRACT_TRISTIMULUS_3:
-        case XTRACT_SMOOTHNESS:
-        case XTRACT_SPREAD:
-        case XTRACT_ZCR:
-        case XTRACT_ROLLOFF:
-        case XTRACT_LOUDNESS:
-        case XTRACT_FLATNESS:
-        case XTRACT_FLATNESS_DB:
-        case XTRACT_TONALITY:
-        case XTRACT_CREST:
-        case XTRACT_NOISINESS:
-        case XTRACT_RMS_AMPLITUDE:
-        case XTRACT_SPECTRAL_INHARMONICITY:
-        case XTRACT_POWER:
-        case XTRACT_ODD_EVEN_RATIO:
-        case XTRACT_SHARPNESS:
-        case XTRACT_SPECTRAL_SLOPE:
-        case XTRACT_LOWEST_VALUE:
-        case XTRACT_HIGHEST_VALUE:
-        case XTRACT_SUM:
-        case XTRACT_HPS:
-        case XTRACT_F0:
-        case XTRACT_FAILSAFE_F0:
-        case XTRACT_WAVELET_F0:
-        case XTRACT_MCLEOD_F0:
-        case XTRACT_MIDICENT:
-        case XTRACT_FLUX:
-        case XTRACT_LNORM:
-        case XTRACT_NONZERO_COUNT:
-            *is_scalar = XTRACT_TRUE;
-            break;
-        case XTRACT_AUTOCORRELATION:
-        case XTRACT_AMDF:
-        case XTRACT_ASDF:
-        case XTRACT_BARK_COEFFICIENTS:
-        case XTRACT_PEAK_SPECTRUM:
-        case XTRACT_SPECTRUM:
-        case XTRACT_SUBBANDS:
-        case XTRACT_AUTOCORRELATION_FFT:
-        case XTRACT_MFCC:
-        case XTRACT_MEL_SPECTROGRAM:
-        case XTRACT_GFCC:
-        case XTRACT_GAMMATONE_SPECTROGRAM:
-        case XTRACT_LPC:
-        case XTRACT_LPCC:
-        case XTRACT_DCT:
-        case XTRACT_HARMONIC_SPECTRUM:
-        case XTRACT_DIFFERENCE_VECTOR:
-        case XTRACT_WINDOWED:
-        case XTRACT_SMOOTHED:
-            *is_scalar = XTRACT_FALSE;
-            break;
-        default:
-            *is_scalar = XTRACT_TRUE;
-            break;
+    return &xtract_descriptors[feature];
+}
 
-        }
+int xtract_feature_from_name(const char *name)
+{
+    unsigned int bucket;
+    int feature;
 
-        is_delta = &d->is_delta;
+    if(name == NULL)
+        return XTRACT_ANY;
 
-        switch(f)
-        {
-        case XTRACT_FLUX:
-        case XTRACT_LNORM:
-        case XTRACT_DIFFERENCE_VECTOR:
-            *is_delta = XTRACT_TRUE;
-            break;
-        case XTRACT_MEAN:
-        case XTRACT_VARIANCE:
-        case XTRACT_STANDARD_DEVIATION:
-        case XTRACT_AVERAGE_DEVIATION:
-        case XTRACT_SKEWNESS:
-        case XTRACT_KURTOSIS:
-        case XTRACT_SPECTRAL_MEAN:
-        case XTRACT_SPECTRAL_VARIANCE:
-        case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-            /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION: */
-        case XTRACT_SPECTRAL_SKEWNESS:
-        case XTRACT_SPECTRAL_KURTOSIS:
-        case XTRACT_SPECTRAL_CENTROID:
-        case XTRACT_IRREGULARITY_K:
-        case XTRACT_IRREGULARITY_J:
-        case XTRACT_TRISTIMULUS_1:
-        case XTRACT_TRISTIMULUS_2:
-        case XTRACT_TRISTIMULUS_3:
-        case XTRACT_SMOOTHNESS:
-        case XTRACT_SPREAD:
-        case XTRACT_ZCR:
-        case XTRACT_ROLLOFF:
-        case XTRACT_LOUDNESS:
-        case XTRACT_FLATNESS:
-        case XTRACT_FLATNESS_DB:
-        case XTRACT_TONALITY:
-        case XTRACT_CREST:
-        case XTRACT_NOISINESS:
-        case XTRACT_RMS_AMPLITUDE:
-        case XTRACT_SPECTRAL_INHARMONICITY:
-        case XTRACT_POWER:
-        case XTRACT_ODD_EVEN_RATIO:
-        case XTRACT_SHARPNESS:
-        case XTRACT_SPECTRAL_SLOPE:
-        case XTRACT_LOWEST_VALUE:
-        case XTRACT_HIGHEST_VALUE:
-        case XTRACT_SUM:
-        case XTRACT_HPS:
-        case XTRACT_F0:
-        case XTRACT_FAILSAFE_F0:
-        case XTRACT_WAVELET_F0:
-        case XTRACT_MCLEOD_F0:
-        case XTRACT_MIDICENT:
-        case XTRACT_NONZERO_COUNT:
-        case XTRACT_AUTOCORRELATION:
-        case XTRACT_AMDF:
-        case XTRACT_ASDF:
-        case XTRACT_BARK_COEFFICIENTS:
-        case XTRACT_PEAK_SPECTRUM:
-        case XTRACT_SPECTRUM:
-        case XTRACT_SUBBANDS:
-        case XTRACT_AUTOCORRELATION_FFT:
-        case XTRACT_MFCC:
-        case XTRACT_MEL_SPECTROGRAM:
-        case XTRACT_GFCC:
-        case XTRACT_GAMMATONE_SPECTROGRAM:
-        case XTRACT_LPC:
-        case XTRACT_LPCC:
-        case XTRACT_DCT:
-        case XTRACT_HARMONIC_SPECTRUM:
-        case XTRACT_WINDOWED:
-        case XTRACT_SMOOTHED:
-        default:
-            *is_delta = XTRACT_FALSE;
-            break;
-        }
+    bucket = xtract_name_hash(name, 0) % XTRACT_ARRAY_ELEMENTS(xtract_name_seeds);
+    feature = xtract_name_slots[xtract_name_hash(name, xtract_name_seeds[bucket]) % XTRACT_ARRAY_ELEMENTS(xtract_name_slots)];
 
-        if(*is_scalar)
-        {
+    if(feature < 0 || strcmp(xtract_descriptors[feature].algo.name, name) != 0)
+        return XTRACT_ANY;
 
-            result_unit = &d->result.scalar.unit;
-            result_min = &d->result.scalar.min;
-            result_max = &d->result.scalar.max;
+    return feature;
+}
 
-            switch(f)
-            {
-            case XTRACT_MEAN:
-            case XTRACT_VARIANCE:
-            case XTRACT_STANDARD_DEVIATION:
-            case XTRACT_AVERAGE_DEVIATION:
-            case XTRACT_SKEWNESS:
-            case XTRACT_KURTOSIS:
-            case XTRACT_RMS_AMPLITUDE:
-            case XTRACT_LOWEST_VALUE:
-            case XTRACT_HIGHEST_VALUE:
-            case XTRACT_SUM:
-            case XTRACT_FLUX:
-            case XTRACT_LNORM:
-            case XTRACT_NONZERO_COUNT:
-            case XTRACT_WINDOWED:
-                *result_unit = (xtract_unit_t)XTRACT_ANY;
-                *result_min = XTRACT_UNBOUNDED_MIN;
-                *result_max = XTRACT_UNBOUNDED_MAX;
-                break;
-            case XTRACT_SPECTRAL_SKEWNESS:
-            case XTRACT_SPECTRAL_KURTOSIS:
-            case XTRACT_IRREGULARITY_K:
-            case XTRACT_IRREGULARITY_J:
-            case XTRACT_TRISTIMULUS_1:
-            case XTRACT_TRISTIMULUS_2:
-            case XTRACT_TRISTIMULUS_3:
-            case XTRACT_NOISINESS:
-            case XTRACT_SMOOTHNESS:
-                *result_unit = (xtract_unit_t)XTRACT_NONE;
-                *result_min = XTRACT_UNKNOWN_MIN; /* FIX: need to check these */
-                *result_max = XTRACT_UNKNOWN_MAX;
-                break;
-            case XTRACT_SPECTRAL_MEAN:
-            case XTRACT_SPECTRAL_VARIANCE:
-            case XTRACT_SPECTRAL_STANDARD_DEVIATION:
-                /* case XTRACT_SPECTRAL_AVERAGE_DEVIATION: */
-            case XTRACT_SPECTRAL_CENTROID:
-            case XTRACT_SPREAD:
-            case XTRACT_F0:
-            case XTRACT_FAILSAFE_F0:
-            case XTRACT_WAVELET_F0:
-            case XTRACT_MCLEOD_F0:
-            case XTRACT_HPS:
-            case XTRACT_ROLLOFF:
-                *result_unit = XTRACT_HERTZ;
-                *result_min = 0.0;
-                *result_max = XTRACT_SR_UPPER_LIMIT / 2.0;
-                break;
-            case XTRACT_MIDICENT:
-                *result_unit = XTRACT_MIDI_CENT;
-                *result_min = 0.0;
-                *result_max = 12700;
-                break;
-            case XTRACT_ZCR:
-                *result_unit = XTRACT_HERTZ;
-                *result_min = 0.0;
-                *result_max = XTRACT_UNBOUNDED_MAX;
-                break;
-            case XTRACT_ODD_EVEN_RATIO:
-                *result_unit = (xtract_unit_t)XTRACT_NONE;
-                *result_min = 0.0;
-                *result_max = 1.0;
-                break;
-            case XTRACT_FLATNESS_DB:
-                *result_unit = XTRACT_DBFS;
-                *result_min = XTRACT_UNKNOWN_MIN; /* FIX: check this */
-                *result_max = XTRACT_UNKNOWN_MAX;
-                break;
-            case XTRACT_LOUDNESS:
-            case XTRACT_FLATNESS:
-            case XTRACT_TONALITY:
-            case XTRACT_CREST:
-            case XTRACT_SPECTRAL_INHARMONICITY:
-            case XTRACT_POWER:
-            case XTRACT_SHARPNESS:
-            case XTRACT_SPECTRAL_SLOPE:
-            case XTRACT_LPC:
-            case XTRACT_LPCC:
-            default:
-                *result_unit = (xtract_unit_t)XTRACT_UNKNOWN;
-                *result_min = XTRACT_UNKNOWN_MIN;
-                *result_max = XTRACT_UNKNOWN_MAX;
-                break;
-            }
-        }
-        else
-        {
+xtract_function_descriptor_t *xtract_make_descriptors(void)
+{
+    xtract_function_descriptor_t *fd;
 
-            result_min = NULL;
-            result_max = NULL;
-            result_unit = &d->result.vector.unit;
-            result_format = &d->result.vector.format;
+    fd = (xtract_function_descriptor_t*)malloc(sizeof(xtract_descriptors));
+    if(fd == NULL)
+        return NULL;
 
-            switch(f)
-            {
-            case XTRACT_AUTOCORRELATION:
-            case XTRACT_AMDF:
-            case XTRACT_ASDF:
-            case XTRACT_DCT:
-            case XTRACT_SUBBANDS:
-            case XTRACT_WINDOWED:
-            case XTRACT_SMOOTHED:
-                *result_format = XTRACT_ARBITRARY_SERIES;
-                *result_unit = (xtract_unit_t)XTRACT_ANY;
-                break;
-            case XTRACT_BARK_COEFFICIENTS:
-                *result_format = XTRACT_BARK_COEFFS;
-                *result_unit = (xtract_unit_t)XTRACT_UNKNOWN; /* FIX: check */
-                break;
-            case XTRACT_PEAK_SPECTRUM:
-            case XTRACT_SPECTRUM:
-            case XTRACT_HARMONIC_SPECTRUM:
-                *result_format = XTRACT_SPECTRAL;
-                *result_unit = XTRACT_ANY_AMPLITUDE_HERTZ;
-                break;
-            case XTRACT_AUTOCORRELATION_FFT:
-                break;
-            case XTRACT_MFCC:
-                *result_format = XTRACT_MEL_COEFFS;
-                *result_unit = (xtract_unit_t)XTRACT_UNKNOWN; /* FIX: check */
-                break;
-            case XTRACT_MEL_SPECTROGRAM:
-                *result_format = XTRACT_MEL_COEFFS;
-                *result_unit = XTRACT_DBFS;
-                break;
-            case XTRACT_GFCC:
-                *result_format = XTRACT_MEL_COEFFS;
-                *result_unit = (xtract_unit_t)XTRACT_UNKNOWN;
-                break;
-            case XTRACT_GAMMATONE_SPECTROGRAM:
-                *result_format = XTRACT_MEL_COEFFS;
-                *result_unit = XTRACT_DBFS;
-                break;
-            case XTRACT_LPC:
-                *result_format = XTRACT_LPC_COEFFS;
-                *result_unit = (xtract_unit_t)XTRACT_UNKNOWN;
-                break;
-            case XTRACT_LPCC:
-                *result_format = XTRACT_LPCC_COEFFS;
-                *result_unit = (xtract_unit_t)XTRACT_UNKNOWN;
-                break;
-            default:
-                break;
-            }
-        }
-    }
+    memcpy(fd, xtract_descriptors, sizeof(xtract_descriptors));
 
     return fd;
 }
@@ -1478,8 +1586,3 @@ int xtract_free_descriptors(xtract_function_descriptor_t *fd)
 
     return XTRACT_SUCCESS;
 }
-
-
-
-
-
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+#
+# Generates the perfect hash tables used by xtract_feature_from_name() from the
+# feature names in descriptors.c. Run it after adding or renaming a feature
+# and replace the tables in descriptors.c with its output:
+#
+#     python3 descriptors_hash.py descriptors.c
+#
+# The hash is hash-and-displace: each name falls in one of BUCKETS buckets by
+# its unseeded hash, and each bucket has a seed chosen so that the seeded
+# hashes of all its names land in distinct free slots. Lookup is two hashes
+# and one strcmp().
+
+import re
+import sys
+
+BUCKETS = 32
+SLOTS = 128
+
+
+def name_hash(name, seed):
+    """FNV-1a with the seed folded into the offset basis, as in descriptors.c"""
+    h = (2166136261 ^ seed) & 0xffffffff
+    for c in name.encode():
+        h ^= c
+        h = (h * 16777619) & 0xffffffff
+    return h
+
+
+def build(names):
+    buckets = [[] for _ in range(BUCKETS)]
+    for feature, name in enumerate(names):
+        buckets[name_hash(name, 0) % BUCKETS].append(feature)
+
+    seeds = [0] * BUCKETS
+    slots = [-1] * SLOTS
+
+    for b in sorted(range(BUCKETS), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        for seed in range(1, 65536):
+            taken = [name_hash(names[f], seed) % SLOTS for f in buckets[b]]
+            if len(set(taken)) == len(taken) and all(slots[s] < 0 for s in taken):
+                break
+        else:
+            sys.exit("no seed found for bucket %d, increase SLOTS" % b)
+        seeds[b] = seed
+        for f, s in zip(buckets[b], taken):
+            slots[s] = f
+
+    return seeds, slots
+
+
+def table(ctype, name, values, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join("%d" % v for v in values[i:i + per_line]))
+    return "static const %s %s[%d] = {\n%s\n};" % (ctype, name, len(values), ",\n".join(lines))
+
+
+def main():
+    source = open(sys.argv[1] if len(sys.argv) > 1 else "descriptors.c").read()
+    names = re.findall(r'^\s*\.name = "([^"]*)"', source, re.M)
+    seeds, slots = build(names)
+    print(table("unsigned short", "xtract_name_seeds", seeds, 8))
+    print()
+    print(table("signed char", "xtract_name_slots", slots, 16))
+
+
+if __name__ == "__main__":
+    main()
@@ -102,7 +102,13 @@ typedef struct _minmax {
 	struct _minmax *next;
 } minmax;
 
-double _dywapitch_computeWaveletPitch(const double * samples, int startsample, int samplecount) {
+int dywapitch_workspacesize(int samplecount) {
+	return _floor_power2(samplecount);
+}
+
+// sam holds dywapitch_workspacesize(samplecount) doubles and work three times
+// as many ints
+double _dywapitch_computeWaveletPitch(const double * samples, int startsample, int samplecount, double samplerate, double *sam, int *work) {
 	double pitchF = 0.0;
 	
 	int i, j;
@@ -111,21 +117,24 @@ double _dywapitch_computeWaveletPitch(const double * samples, int startsample, i
 	// must be a power of 2
 	samplecount = _floor_power2(samplecount);
 	
-	double *sam = (double *)malloc(sizeof(double)*samplecount);
 	memcpy(sam, samples + startsample, sizeof(double)*samplecount);
 	int curSamNb = samplecount;
 	
-	int *distances = (int *)malloc(sizeof(int)*samplecount);
-	int *mins = (int *)malloc(sizeof(int)*samplecount);
-	int *maxs = (int *)malloc(sizeof(int)*samplecount);
+	int *distances = work;
+	int *mins = work + samplecount;
+	int *maxs = work + 2*samplecount;
 	int nbMins, nbMaxs;
 	
-	// algorithm parameters
-	int maxFLWTlevels = 6;
-	double maxF = 3000.;
+	// algorithm parameters, tuned for 44100 Hz: one more FLWT level for each
+	// doubling of the sample rate, so that the lowest level covers the same
+	// band, and maxF kept below a quarter of the sample rate
+	int maxFLWTlevels = 6 + (int)floor(log2(samplerate/44100.) + 0.5);
+	double maxF = min(3000., samplerate/4.);
 	int differenceLevelsN = 3;
 	double maximaThresholdRatio = 0.75;
 	
+	if (maxFLWTlevels < 2) maxFLWTlevels = 2;
+	
 	double ampltitudeThreshold;  
 	double theDC = 0.0;
 	
@@ -157,7 +166,7 @@ double _dywapitch_computeWaveletPitch(const double * samples, int startsample, i
 	while(1) {
 		
 		// delta
-		delta = 44100./(_2power(curLevel)*maxF);
+		delta = samplerate/(_2power(curLevel)*maxF);
 		//("dywapitch doing level=%ld delta=%ld\n", curLevel, delta);
 		
 		if (curSamNb < 2) goto cleanup;
@@ -299,7 +308,7 @@ double _dywapitch_computeWaveletPitch(const double * samples, int startsample, i
 				//if DEBUGG then put "similarity="&similarity&&"delta="&delta&&"ok"
  				//asLog("dywapitch similarity=%f OK !\n", similarity);
 				// two consecutive similar mode distances : ok !
-				pitchF = 44100./(_2power(curLevel-1)*curModeDistance);
+				pitchF = samplerate/(_2power(curLevel-1)*curModeDistance);
 				goto cleanup;
 			}
 			//if DEBUGG then put "similarity="&similarity&&"delta="&delta&&"not"
@@ -328,11 +337,6 @@ double _dywapitch_computeWaveletPitch(const double * samples, int startsample, i
 	
 	///
 cleanup:
-	free(distances);
-	free(mins);
-	free(maxs);
-	free(sam);
-	
 	return pitchF;
 }
 
@@ -440,7 +444,21 @@ void dywapitch_inittracking(dywapitchtracker *pitchtracker) {
 }
 
 double dywapitch_computepitch(dywapitchtracker *pitchtracker, const double * samples, int startsample, int samplecount) {
-	double raw_pitch = _dywapitch_computeWaveletPitch(samples, startsample, samplecount);
+	int size = dywapitch_workspacesize(samplecount);
+	double *sam = (double *)malloc(sizeof(double)*size);
+	int *work = (int *)malloc(sizeof(int)*3*size);
+	double pitch = 0.0;
+	
+	if (sam != NULL && work != NULL)
+		pitch = dywapitch_computepitch_workspace(pitchtracker, samples, startsample, samplecount, 44100., sam, work);
+	
+	free(work);
+	free(sam);
+	return pitch;
+}
+
+double dywapitch_computepitch_workspace(dywapitchtracker *pitchtracker, const double * samples, int startsample, int samplecount, double samplerate, double *sam, int *work) {
+	double raw_pitch = _dywapitch_computeWaveletPitch(samples, startsample, samplecount, samplerate, sam, work);
 	return _dywapitch_dynamicprocess(pitchtracker, raw_pitch);
 }
 
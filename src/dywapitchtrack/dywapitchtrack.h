@@ -57,8 +57,9 @@
  over time and makes assumptions about human voice capabilities and reallife conditions
  (as documented inside the code).
  
- Note : The algorithm currently assumes a 44100Hz audio sampling rate. If you use a different
- samplerate, you can just multiply the resulting pitch by the ratio between your samplerate and 44100.
+ Note : dywapitch_computepitch assumes a 44100Hz audio sampling rate. For other sample rates
+ use dywapitch_computepitch_workspace, which also takes the sample rate and adapts the wavelet
+ levels to it.
 */
 
 /* Usage
@@ -72,6 +73,11 @@
  // For each available audio buffer, call 'dywapitch_computepitch'
  double thepitch = dywapitch_computepitch(&pitchtracker, samples, start, count);
  
+ // To avoid allocating on every call, allocate the workspace once and pass it instead
+ double *sam = malloc(dywapitch_workspacesize(count) * sizeof(double));
+ int *work = malloc(3 * dywapitch_workspacesize(count) * sizeof(int));
+ double thepitch = dywapitch_computepitch_workspace(&pitchtracker, samples, start, count, samplerate, sam, work);
+ 
 */
 
 #ifndef dywapitchtrack__H
@@ -102,6 +108,14 @@ void dywapitch_inittracking(dywapitchtracker *pitchtracker);
 // return 0.0 if no pitch was found (sound too low, noise, etc..)
 double dywapitch_computepitch(dywapitchtracker *pitchtracker, const double * samples, int startsample, int samplecount);
 
+// returns the number of doubles needed in the sam buffer of dywapitch_computepitch_workspace,
+// the work buffer needs three times as many ints
+int dywapitch_workspacesize(int samplecount);
+
+// as dywapitch_computepitch, at the given samplerate, using caller allocated buffers
+// instead of allocating on every call
+double dywapitch_computepitch_workspace(dywapitchtracker *pitchtracker, const double * samples, int startsample, int samplecount, double samplerate, double *sam, int *work);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
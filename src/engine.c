@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* engine.c: computes a feature plan over the frames of a signal in parallel,
+ * with work stealing between the threads */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_engine.h"
+#include "xtract_globals_private.h"
+#include "xtract_threads_private.h"
+
+typedef struct xtract_engine_worker_
+{
+    xtract_engine *engine;
+    xtract_plan *plan;
+
+    /* The frames left to this worker, taken from begin and stolen from end */
+    xtract_mutex lock;
+    int begin;
+    int end;
+
+    int failed_frame;           /* earliest frame that failed, or -1 */
+    int status;
+} xtract_engine_worker;
+
+struct xtract_engine_
+{
+    int threads;
+    int columns;
+    int features;
+    int feature[XTRACT_FEATURES];       /* requested features, in column order */
+    int column[XTRACT_FEATURES];        /* first column of each feature, or -1 */
+    int size[XTRACT_FEATURES];
+    xtract_engine_worker *workers;
+
+    /* Set by xtract_engine_compute() */
+    const double *data;
+    int hop;
+    double *result;
+};
+
+static int engine_processors(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return processors > 0 ? (int)processors : 1;
+#endif
+}
+
+xtract_engine *xtract_engine_new(const xtract_plan *plan, int threads)
+{
+    xtract_engine *engine;
+    int f, t, N;
+
+    if(xtract_plan_result(plan, XTRACT_WAVELET_F0, NULL) != NULL)
+    {
+        fprintf(stderr, "libxtract: error: xtract_engine_new(): wavelet_f0 depends on the frames before it\n");
+        return NULL;
+    }
+
+    if(threads <= 0)
+        threads = engine_processors();
+
+    engine = calloc(1, sizeof(xtract_engine));
+
+    if(engine == NULL)
+    {
+        perror("could not allocate memory for xtract_engine");
+        return NULL;
+    }
+
+    for(f = 0; f < XTRACT_FEATURES; ++f)
+    {
+        engine->column[f] = -1;
+
+        if(xtract_plan_result(plan, f, &N) == NULL)
+            continue;
+
+        engine->feature[engine->features++] = f;
+        engine->column[f] = engine->columns;
+        engine->size[f] = N;
+        engine->columns += N;
+    }
+
+    if(engine->features == 0)
+    {
+        fprintf(stderr, "libxtract: error: xtract_engine_new(): plan has not been compiled\n");
+        free(engine);
+        return NULL;
+    }
+
+    engine->workers = calloc(threads, sizeof(xtract_engine_worker));
+
+    if(engine->workers == NULL)
+    {
+        perror("could not allocate memory for xtract_engine");
+        free(engine);
+        return NULL;
+    }
+
+    for(t = 0; t < threads; ++t)
+    {
+        engine->workers[t].engine = engine;
+        engine->workers[t].plan = xtract_plan_copy(plan);
+        xtract_mutex_init(&engine->workers[t].lock);
+        engine->threads = t + 1;
+
+        if(engine->workers[t].plan == NULL)
+        {
+            xtract_engine_delete(engine);
+            return NULL;
+        }
+    }
+
+    return engine;
+}
+
+void xtract_engine_delete(xtract_engine *engine)
+{
+    int t;
+
+    if(engine == NULL)
+        return;
+
+    for(t = 0; t < engine->threads; ++t)
+    {
+        xtract_plan_delete(engine->workers[t].plan);
+        xtract_mutex_destroy(&engine->workers[t].lock);
+    }
+
+    free(engine->workers);
+    free(engine);
+}
+
+int xtract_engine_columns(const xtract_engine *engine)
+{
+    return engine->columns;
+}
+
+int xtract_engine_column(const xtract_engine *engine, int feature, int *N)
+{
+    if(feature < 0 || feature >= XTRACT_FEATURES || engine->column[feature] < 0)
+        return -1;
+
+    if(N != NULL)
+        *N = engine->size[feature];
+
+    return engine->column[feature];
+}
+
+/* Take the next frame of a worker's own range, or -1 if it is empty */
+static int engine_take(xtract_engine_worker *worker)
+{
+    int frame = -1;
+
+    xtract_mutex_lock(&worker->lock);
+
+    if(worker->begin < worker->end)
+        frame = worker->begin++;
+
+    xtract_mutex_unlock(&worker->lock);
+
+    return frame;
+}
+
+/* Move the later half of another worker's frames to this one. Frames are
+ * only ever taken away, so once no worker has any left the job is done */
+static int engine_steal(xtract_engine_worker *worker, int threads)
+{
+    xtract_engine_worker *workers = worker->engine->workers;
+    xtract_engine_worker *victim;
+    int self = (int)(worker - workers);
+    int t, begin = 0, end = 0;
+
+    for(t = 1; t < threads && begin == end; ++t)
+    {
+        victim = &workers[(self + t) % threads];
+
+        xtract_mutex_lock(&victim->lock);
+
+        if(victim->begin < victim->end)
+        {
+            end = victim->end;
+            begin = victim->end - (victim->end - victim->begin + 1) / 2;
+            victim->end = begin;
+        }
+
+        xtract_mutex_unlock(&victim->lock);
+    }
+
+    if(begin == end)
+        return 0;
+
+    xtract_mutex_lock(&worker->lock);
+    worker->begin = begin;
+    worker->end = end;
+    xtract_mutex_unlock(&worker->lock);
+
+    return 1;
+}
+
+static void engine_work(xtract_engine_worker *worker)
+{
+    xtract_engine *engine = worker->engine;
+    double *row;
+    const double *result;
+    int frame, f, feature, rv;
+
+    do
+    {
+        while((frame = engine_take(worker)) >= 0)
+        {
+            rv = xtract_plan_compute(worker->plan, engine->data + (size_t)frame * engine->hop);
+
+            if(rv != XTRACT_SUCCESS && (worker->failed_frame < 0 || frame < worker->failed_frame))
+            {
+                worker->failed_frame = frame;
+                worker->status = rv;
+            }
+
+            row = engine->result + (size_t)frame * engine->columns;
+
+            for(f = 0; f < engine->features; ++f)
+            {
+                feature = engine->feature[f];
+                result = xtract_plan_result(worker->plan, feature, NULL);
+                memcpy(row + engine->column[feature], result, engine->size[feature] * sizeof(double));
+            }
+        }
+    }
+    while(engine_steal(worker, engine->threads));
+}
+
+/* Run a worker on a thread of its own. Features without a _ctx variant, e.g.
+ * xtract_f0(), grow the work buffers of the thread's context, which would
+ * otherwise be lost when the thread exits */
+static XTRACT_THREAD_FN(engine_thread, arg)
+{
+    engine_work(arg);
+    xtract_context_release(&xtract_thread_context);
+
+    return XTRACT_THREAD_RETURN;
+}
+
+int xtract_engine_compute(xtract_engine *engine, const double *data, int frames, int hop, double *result)
+{
+    xtract_thread *threads;
+    xtract_engine_worker *worker;
+    int t, workers, started, failed_frame = -1;
+    int status = XTRACT_SUCCESS;
+
+    if(frames < 0 || hop < 0)
+        return XTRACT_BAD_ARGV;
+
+    if(frames == 0)
+        return XTRACT_SUCCESS;
+
+    workers = engine->threads < frames ? engine->threads : frames;
+
+    engine->data = data;
+    engine->hop = hop;
+    engine->result = result;
+
+    for(t = 0; t < engine->threads; ++t)
+    {
+        worker = &engine->workers[t];
+        worker->begin = t < workers ? (int)((long long)frames * t / workers) : 0;
+        worker->end = t < workers ? (int)((long long)frames * (t + 1) / workers) : 0;
+        worker->failed_frame = -1;
+        worker->status = XTRACT_SUCCESS;
+    }
+
+    threads = malloc(workers * sizeof(xtract_thread));
+
+    if(threads == NULL)
+    {
+        perror("could not allocate memory for xtract_engine threads");
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    /* The calling thread is the first worker. If a thread can't be started
+     * the running workers steal its frames */
+    for(started = 1; started < workers; ++started)
+    {
+        if(xtract_thread_create(&threads[started], engine_thread, &engine->workers[started]) != 0)
+            break;
+    }
+
+    engine_work(&engine->workers[0]);
+
+    for(t = 1; t < started; ++t)
+        xtract_thread_join(threads[t]);
+
+    free(threads);
+
+    for(t = 0; t < workers; ++t)
+    {
+        worker = &engine->workers[t];
+
+        if(worker->failed_frame >= 0 && (failed_frame < 0 || worker->failed_frame < failed_frame))
+        {
+            failed_frame = worker->failed_frame;
+            status = worker->status;
+        }
+    }
+
+    return status;
+}
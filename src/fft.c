@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* fft.c: defines FFT backend selection and the process wide cache of FFT plans */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "fft.h"
+#include "xtract/libxtract.h"
+#include "xtract_threads_private.h"
+
+#ifndef XTRACT_DEFAULT_FFT_BACKEND
+#ifdef __APPLE__
+#define XTRACT_DEFAULT_FFT_BACKEND xtract_fft_backend_vdsp
+#else
+#define XTRACT_DEFAULT_FFT_BACKEND xtract_fft_backend_native
+#endif
+#endif
+
+/* The backend set by xtract_set_fft_backend(), as one of the values of
+ * xtract_fft_backends_. It is atomic so that it may be set while other
+ * threads compute features, each of which loads it once per plan lookup */
+static xtract_atomic xtract_fft_backend_selected = XTRACT_FFT_BACKEND_DEFAULT;
+
+static xtract_fft_plan *xtract_fft_plans = NULL;
+static xtract_mutex xtract_fft_plans_lock = XTRACT_MUTEX_INITIALIZER;
+
+const xtract_fft_backend *xtract_fft_backend_current(void)
+{
+    switch(xtract_atomic_load(&xtract_fft_backend_selected))
+    {
+    case XTRACT_FFT_BACKEND_OOURA:
+        return &xtract_fft_backend_ooura;
+#ifdef __APPLE__
+    case XTRACT_FFT_BACKEND_VDSP:
+        return &xtract_fft_backend_vdsp;
+#endif
+    case XTRACT_FFT_BACKEND_NATIVE:
+        return &xtract_fft_backend_native;
+    default:
+        return &XTRACT_DEFAULT_FFT_BACKEND;
+    }
+}
+
+const xtract_fft_backend *xtract_fft_backend_for(int N, int kind)
+{
+    const xtract_fft_backend *selected;
+
+    if(kind == XTRACT_FFT_DCT)
+    {
+        return N >= 2 && xtract_is_poweroftwo(N) ? &xtract_fft_backend_ooura : &xtract_fft_backend_native;
+    }
+
+    selected = xtract_fft_backend_current();
+
+    if(selected->any_size || xtract_is_poweroftwo(N))
+    {
+        return selected;
+    }
+
+    return &xtract_fft_backend_native;
+}
+
+int xtract_fft_fast_size(int n)
+{
+    int size, m, half;
+
+    if(n < 2)
+        return 2;
+
+    if(!xtract_fft_backend_current()->any_size)
+    {
+        for(size = 2; size < n; size <<= 1)
+            ;
+        return size;
+    }
+
+    for(half = (n + 1) / 2; ; ++half)
+    {
+        m = half;
+        while(m % 2 == 0)
+            m /= 2;
+        while(m % 3 == 0)
+            m /= 3;
+        while(m % 5 == 0)
+            m /= 5;
+        if(m == 1)
+            return 2 * half;
+    }
+}
+
+int xtract_set_fft_backend(int backend)
+{
+    switch(backend)
+    {
+    case XTRACT_FFT_BACKEND_DEFAULT:
+    case XTRACT_FFT_BACKEND_OOURA:
+#ifdef __APPLE__
+    case XTRACT_FFT_BACKEND_VDSP:
+#endif
+    case XTRACT_FFT_BACKEND_NATIVE:
+        xtract_atomic_store(&xtract_fft_backend_selected, backend);
+        return XTRACT_SUCCESS;
+    default:
+        return XTRACT_FEATURE_NOT_IMPLEMENTED;
+    }
+}
+
+int xtract_get_fft_backend(void)
+{
+    return xtract_fft_backend_current()->id;
+}
+
+const char *xtract_get_fft_backend_name(void)
+{
+    return xtract_fft_backend_current()->name();
+}
+
+static void xtract_fft_plan_delete(xtract_fft_plan *plan)
+{
+    plan->backend->plan_free(plan);
+    free(plan);
+}
+
+static xtract_fft_plan *xtract_fft_plan_new(int N, int kind, const xtract_fft_backend *backend)
+{
+    xtract_fft_plan *plan = (xtract_fft_plan *)calloc(1, sizeof(xtract_fft_plan));
+
+    if(plan == NULL)
+    {
+        perror("could not allocate memory for FFT plan");
+        return NULL;
+    }
+
+    plan->N = N;
+    plan->kind = kind;
+    plan->backend = backend;
+
+    if(backend->plan_init(plan) != XTRACT_SUCCESS)
+    {
+        fprintf(stderr, "libxtract: error: could not create %s FFT plan of size %d\n", backend->name(), N);
+        xtract_fft_plan_delete(plan);
+        return NULL;
+    }
+
+    return plan;
+}
+
+const xtract_fft_plan *xtract_fft_plan_get(int N, int kind)
+{
+    const xtract_fft_backend *backend;
+    xtract_fft_plan *plan;
+
+    /* The packed real FFT layout needs an even N */
+    if(N < 1 || (kind != XTRACT_FFT_DCT && (N < 2 || N & 1)))
+    {
+        return NULL;
+    }
+
+    backend = xtract_fft_backend_for(N, kind);
+
+    xtract_mutex_lock(&xtract_fft_plans_lock);
+
+    for(plan = xtract_fft_plans; plan != NULL; plan = plan->next)
+    {
+        if(plan->N == N && plan->kind == kind && plan->backend == backend)
+        {
+            break;
+        }
+    }
+
+    if(plan == NULL)
+    {
+        plan = xtract_fft_plan_new(N, kind, backend);
+
+        if(plan != NULL)
+        {
+            plan->next = xtract_fft_plans;
+            xtract_fft_plans = plan;
+        }
+    }
+
+    xtract_mutex_unlock(&xtract_fft_plans_lock);
+
+    return plan;
+}
+
+void xtract_fft_plan_cache_free(void)
+{
+    xtract_fft_plan *plan;
+
+    xtract_mutex_lock(&xtract_fft_plans_lock);
+
+    while(xtract_fft_plans != NULL)
+    {
+        plan = xtract_fft_plans;
+        xtract_fft_plans = plan->next;
+        xtract_fft_plan_delete(plan);
+    }
+
+    xtract_mutex_unlock(&xtract_fft_plans_lock);
+}
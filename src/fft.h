@@ -24,8 +24,9 @@
 #ifndef FFT_H
 #define FFT_H
 
+#include <stddef.h>
+
 #ifdef _MSC_VER
-	#define USE_OOURA
 	#ifndef __cplusplus
 		typedef int bool;
 		#define false 0
@@ -35,30 +36,91 @@
 	#include <stdbool.h>
 #endif
 
-#ifdef USE_OOURA
-#include "ooura/fftsg.h"
-#else
-        #ifndef __APPLE__
-                #error "The target platform is not an Apple one and USE_OOURA was not defined"
-        #endif
-#include <Accelerate/Accelerate.h>
-#endif
+enum xtract_fft_kind_
+{
+    XTRACT_FFT_REAL,
+    XTRACT_FFT_DCT,
+    XTRACT_FFT_REAL_FLOAT
+};
+
+typedef struct xtract_fft_plan_ xtract_fft_plan;
 
-#ifdef USE_OOURA
-typedef struct xtract_ooura_data_
+/* An FFT implementation. Every backend produces the same output as Ooura's
+ * rdft(): a forward transform (isgn = 1) of N reals leaves DC in a[0], the
+ * Nyquist component in a[1], and Re and -Im of bin k in a[2k] and a[2k + 1].
+ * An inverse transform (isgn = -1) of that layout gives N / 2 times the
+ * original signal */
+typedef struct xtract_fft_backend_
 {
-    int *ooura_ip;
-    double *ooura_w;
-    bool initialised;
-} xtract_ooura_data;
-#else
-typedef struct xtract_vdsp_data_
+    int id;
+
+    /* True if the backend handles any even N, not just powers of two */
+    bool any_size;
+
+    /* Return a name for the backend, including the code path it selected */
+    const char *(*name)(void);
+
+    /* Set up plan->data and plan->work_size for plan->N and plan->kind */
+    int (*plan_init)(xtract_fft_plan *plan);
+    void (*plan_free)(xtract_fft_plan *plan);
+
+    /* In-place real FFT of size plan->N. work points to plan->work_size
+     * elements of scratch memory, or NULL if work_size is 0 */
+    void (*rdft)(const xtract_fft_plan *plan, int isgn, double *a, double *work);
+    void (*rdftf)(const xtract_fft_plan *plan, int isgn, float *a, float *work);
+
+    /* In-place unnormalised DCT-II of size plan->N for XTRACT_FFT_DCT plans,
+     * or NULL if the backend has no DCT */
+    void (*dct)(const xtract_fft_plan *plan, double *a, double *work);
+} xtract_fft_backend;
+
+/* An FFT plan for one transform size, kind and backend. Plans are created on
+ * first use, kept in a process wide cache and never modified afterwards, so
+ * the same plan may be used by any number of threads at once */
+struct xtract_fft_plan_
 {
-    FFTSetupD setup;
-    DSPDoubleSplitComplex fft;
-    vDSP_Length log2N;
+    int N;
+    int kind;
+    const xtract_fft_backend *backend;
+    void *data;         /* backend specific tables */
+    size_t work_size;   /* elements of scratch memory needed per transform */
+    struct xtract_fft_plan_ *next;
+};
+
+/* The plan used by one feature in one context */
+typedef struct xtract_fft_data_
+{
+    const xtract_fft_plan *plan;
     bool initialised;
-} xtract_vdsp_data;
+} xtract_fft_data;
+
+extern const xtract_fft_backend xtract_fft_backend_ooura;
+extern const xtract_fft_backend xtract_fft_backend_native;
+#ifdef __APPLE__
+extern const xtract_fft_backend xtract_fft_backend_vdsp;
 #endif
 
+/* Return the backend selected with xtract_set_fft_backend() */
+const xtract_fft_backend *xtract_fft_backend_current(void);
+
+/* Return the backend used for transforms of size N and the given kind. FFTs
+ * use the current backend, or the native backend if N is not a power of two
+ * and the current backend only handles powers of two. DCTs use Ooura's ddct()
+ * for powers of two and the native backend otherwise */
+const xtract_fft_backend *xtract_fft_backend_for(int N, int kind);
+
+/* Return the smallest even FFT size of at least n that the current backend
+ * transforms without Bluestein's algorithm: a power of two, or for backends
+ * that handle any size twice a number with no prime factor above 5. Used to
+ * choose the padded size of transforms whose length is free */
+int xtract_fft_fast_size(int n);
+
+/* Return the cached plan for N and the given kind using the backend for N,
+ * creating it if necessary, or NULL if N is invalid or the plan could not be
+ * created. FFT sizes must be even, DCT sizes may be any N >= 1 */
+const xtract_fft_plan *xtract_fft_plan_get(int N, int kind);
+
+/* Free every plan in the cache. Only safe once no thread can use a plan */
+void xtract_fft_plan_cache_free(void);
+
 #endif /* Header guard */
@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* fft_native.c: LibXtract's own FFT backend, compiled for several instruction
+ * sets with the best one chosen for the running CPU. Unlike the other backends
+ * it handles any even size */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "fft.h"
+#include "xtract_simd_private.h"
+#include "xtract/libxtract.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327
+#endif
+
+#define XTRACT_NATIVE_MAX_PASSES 32
+
+/* Tables for one transform size, shared by every instantiation of
+ * fft_native_impl.h. The pointers are to the plan's type, double or float */
+typedef struct xtract_native_tables_
+{
+    int n;          /* size of the complex FFT, N / 2 */
+    int cn;         /* size of the FFT done by the passes: n, or the Bluestein size */
+    int bluestein;  /* n has a prime factor above 5 */
+    int passes;
+    int radix[XTRACT_NATIVE_MAX_PASSES];
+    const void *tw;     /* pass twiddles */
+    const void *wr;     /* split twiddles */
+    const void *wi;
+    const void *chirp;  /* Bluestein chirp, n real parts then n imaginary parts */
+    const void *kernel; /* FFT of the conjugate chirp, cn real then cn imaginary parts */
+} xtract_native_tables;
+
+#define XTRACT_NATIVE_REAL double
+#define XTRACT_NATIVE_FN(f) native_##f##_generic
+#define XTRACT_NATIVE_TARGET
+#include "fft_native_impl.h"
+
+#define XTRACT_NATIVE_REAL float
+#define XTRACT_NATIVE_FN(f) native_##f##f_generic
+#define XTRACT_NATIVE_TARGET
+#include "fft_native_impl.h"
+
+#ifdef XTRACT_SIMD_X86_DISPATCH
+
+#define XTRACT_NATIVE_REAL double
+#define XTRACT_NATIVE_FN(f) native_##f##_avx2
+#define XTRACT_NATIVE_TARGET __attribute__((target("avx2,fma")))
+#include "fft_native_impl.h"
+
+#define XTRACT_NATIVE_REAL float
+#define XTRACT_NATIVE_FN(f) native_##f##f_avx2
+#define XTRACT_NATIVE_TARGET __attribute__((target("avx2,fma")))
+#include "fft_native_impl.h"
+
+#define XTRACT_NATIVE_REAL double
+#define XTRACT_NATIVE_FN(f) native_##f##_avx512
+#define XTRACT_NATIVE_TARGET __attribute__((target("avx512f")))
+#include "fft_native_impl.h"
+
+#define XTRACT_NATIVE_REAL float
+#define XTRACT_NATIVE_FN(f) native_##f##f_avx512
+#define XTRACT_NATIVE_TARGET __attribute__((target("avx512f")))
+#include "fft_native_impl.h"
+
+#endif /* XTRACT_SIMD_X86_DISPATCH */
+
+typedef void (*xtract_native_rdft)(const xtract_native_tables *t, int isgn, double *a, double *work);
+typedef void (*xtract_native_rdftf)(const xtract_native_tables *t, int isgn, float *a, float *work);
+
+/* table holds everything that tables and dct point to, in the precision of
+ * the plan */
+typedef struct xtract_fft_native_data_
+{
+    xtract_native_rdft rdft;
+    xtract_native_rdftf rdftf;
+    xtract_native_tables tables;
+    int R;              /* size of the real FFT */
+    const double *dct;  /* DCT plans: cos(pi k / 2N) then sin(pi k / 2N) for k < N */
+    void *table;
+} xtract_fft_native_data;
+
+static const char *native_name(void)
+{
+    switch(xtract_simd_isa())
+    {
+    case XTRACT_SIMD_AVX512:
+        return "native (avx512f)";
+    case XTRACT_SIMD_AVX2:
+        return "native (avx2)";
+    default:
+#if defined(__x86_64__) || defined(__SSE2__) || defined(_M_X64)
+        return "native (sse2)";
+#else
+        return "native (generic)";
+#endif
+    }
+}
+
+static void native_plan_free(xtract_fft_plan *plan)
+{
+    xtract_fft_native_data *data = (xtract_fft_native_data *)plan->data;
+
+    if(data == NULL)
+        return;
+
+    free(data->table);
+    free(data);
+    plan->data = NULL;
+}
+
+/* Factorise n into radix 4, 3, 5 and 2 passes, in that order, so that a
+ * radix-2 pass is only ever last. Returns the number of passes, or -1 if n
+ * has another prime factor */
+static int native_factorise(int n, int *radix)
+{
+    static const int radices[] = {4, 3, 5, 2};
+    int passes = 0;
+    int r;
+
+    for(r = 0; r < 4; ++r)
+    {
+        while(n % radices[r] == 0)
+        {
+            radix[passes++] = radices[r];
+            n /= radices[r];
+        }
+    }
+
+    return n == 1 ? passes : -1;
+}
+
+/* Number of pass twiddles for an FFT of size n */
+static size_t native_tw_size(int n, int passes, const int *radix)
+{
+    size_t size = 0;
+    int i;
+
+    for(i = 0; i < passes; ++i)
+    {
+        n /= radix[i];
+        if(radix[i] != 2)
+            size += 2 * (radix[i] - 1) * n;
+    }
+
+    return size;
+}
+
+/* Fill tw with the pass twiddles for an FFT of size n, as described in
+ * fft_native_impl.h */
+static void native_fill_tw(int n, int passes, const int *radix, double *tw)
+{
+    int L = n;
+    int i, j, m, p;
+
+    for(i = 0; i < passes; ++i)
+    {
+        m = L / radix[i];
+
+        if(radix[i] != 2)
+        {
+            for(j = 1; j < radix[i]; ++j)
+            {
+                for(p = 0; p < m; ++p)
+                {
+                    tw[p] = cos(2.0 * M_PI * j * p / L);
+                    tw[m + p] = -sin(2.0 * M_PI * j * p / L);
+                }
+                tw += 2 * m;
+            }
+        }
+
+        L = m;
+    }
+}
+
+/* Fill the Bluestein chirp exp(-i pi j^2 / n) and the FFT of its conjugate,
+ * wrapped to the convolution size t->cn, using the pass twiddles tw */
+static int native_fill_bluestein(const xtract_native_tables *t, const double *tw, double *chirp, double *kernel)
+{
+    const int n = t->n;
+    const int M = t->cn;
+    double *br = (double *)calloc(4 * (size_t)M, sizeof(double));
+    double *bi, *outr, *outi;
+    long long j2;
+    int j;
+
+    if(br == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    bi = br + M;
+
+    for(j = 0; j < n; ++j)
+    {
+        /* j^2 mod 2n keeps the argument small for large j */
+        j2 = ((long long)j * j) % (2 * (long long)n);
+        chirp[j] = cos(M_PI * j2 / n);
+        chirp[n + j] = -sin(M_PI * j2 / n);
+
+        br[j] = chirp[j];
+        bi[j] = -chirp[n + j];
+        if(j > 0)
+        {
+            br[M - j] = br[j];
+            bi[M - j] = bi[j];
+        }
+    }
+
+    native_stockham_generic(M, t->passes, t->radix, br, bi, br + 2 * M, br + 3 * M, tw, &outr, &outi);
+
+    for(j = 0; j < M; ++j)
+    {
+        kernel[j] = outr[j];
+        kernel[M + j] = outi[j];
+    }
+
+    free(br);
+
+    return XTRACT_SUCCESS;
+}
+
+static int native_plan_init(xtract_fft_plan *plan)
+{
+    const int dct = plan->kind == XTRACT_FFT_DCT;
+    /* An odd size DCT is computed from a real FFT of twice its size */
+    const int N = dct && plan->N & 1 ? plan->N << 1 : plan->N;
+    xtract_native_tables *t;
+    size_t tw_size, split_size, chirp_size, kernel_size, dct_size, size, k;
+    double *table;
+    xtract_fft_native_data *data = (xtract_fft_native_data *)calloc(1, sizeof(xtract_fft_native_data));
+
+    if(data == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    plan->data = data;
+    t = &data->tables;
+
+    switch(xtract_simd_isa())
+    {
+#ifdef XTRACT_SIMD_X86_DISPATCH
+    case XTRACT_SIMD_AVX512:
+        data->rdft = native_rdft_avx512;
+        data->rdftf = native_rdftf_avx512;
+        break;
+    case XTRACT_SIMD_AVX2:
+        data->rdft = native_rdft_avx2;
+        data->rdftf = native_rdftf_avx2;
+        break;
+#endif
+    default:
+        data->rdft = native_rdft_generic;
+        data->rdftf = native_rdftf_generic;
+        break;
+    }
+
+    data->R = N;
+    t->n = N >> 1;
+    t->cn = t->n;
+    t->passes = native_factorise(t->n, t->radix);
+
+    if(t->passes < 0)
+    {
+        /* A power of two of at least 2n - 1 for the Bluestein convolution */
+        t->bluestein = 1;
+        for(t->cn = 1; t->cn < 2 * t->n - 1; t->cn <<= 1)
+            ;
+        t->passes = native_factorise(t->cn, t->radix);
+    }
+
+    tw_size = native_tw_size(t->cn, t->passes, t->radix);
+    split_size = (N >> 2) + 1;
+    chirp_size = t->bluestein ? 2 * (size_t)t->n : 0;
+    kernel_size = t->bluestein ? 2 * (size_t)t->cn : 0;
+    dct_size = dct ? 2 * (size_t)plan->N : 0;
+    size = tw_size + 2 * split_size + chirp_size + kernel_size + dct_size;
+
+    /* Two split complex buffers of N / 2 elements for the passes, and four
+     * of the convolution size for Bluestein's algorithm */
+    plan->work_size = (size_t)N << 1;
+    if(t->bluestein)
+        plan->work_size += 4 * (size_t)t->cn;
+    /* The DCT reorders its input into another N elements */
+    if(dct)
+        plan->work_size += N;
+
+    table = (double *)malloc(size * sizeof(double));
+
+    if(table == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    native_fill_tw(t->cn, t->passes, t->radix, table);
+
+    for(k = 0; k < split_size; ++k)
+    {
+        table[tw_size + k] = cos(2.0 * M_PI * k / N);
+        table[tw_size + split_size + k] = -sin(2.0 * M_PI * k / N);
+    }
+
+    if(t->bluestein && native_fill_bluestein(t, table, table + tw_size + 2 * split_size,
+                table + tw_size + 2 * split_size + chirp_size) != XTRACT_SUCCESS)
+    {
+        free(table);
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    if(dct)
+    {
+        double *c = table + size - dct_size;
+
+        for(k = 0; k < (size_t)plan->N; ++k)
+        {
+            c[k] = cos(M_PI * k / (2.0 * plan->N));
+            c[plan->N + k] = sin(M_PI * k / (2.0 * plan->N));
+        }
+
+        data->dct = c;
+    }
+
+    if(plan->kind == XTRACT_FFT_REAL_FLOAT)
+    {
+        float *tablef = (float *)malloc(size * sizeof(float));
+
+        if(tablef == NULL)
+        {
+            free(table);
+            return XTRACT_MALLOC_FAILED;
+        }
+
+        for(k = 0; k < size; ++k)
+        {
+            tablef[k] = (float)table[k];
+        }
+
+        free(table);
+        data->table = tablef;
+
+        t->tw = tablef;
+        t->wr = tablef + tw_size;
+        t->wi = tablef + tw_size + split_size;
+        t->chirp = tablef + tw_size + 2 * split_size;
+        t->kernel = tablef + tw_size + 2 * split_size + chirp_size;
+    }
+    else
+    {
+        data->table = table;
+
+        t->tw = table;
+        t->wr = table + tw_size;
+        t->wi = table + tw_size + split_size;
+        t->chirp = table + tw_size + 2 * split_size;
+        t->kernel = table + tw_size + 2 * split_size + chirp_size;
+    }
+
+    return XTRACT_SUCCESS;
+}
+
+static void native_rdft(const xtract_fft_plan *plan, int isgn, double *a, double *work)
+{
+    const xtract_fft_native_data *data = (const xtract_fft_native_data *)plan->data;
+
+    data->rdft(&data->tables, isgn, a, work);
+}
+
+static void native_rdftf(const xtract_fft_plan *plan, int isgn, float *a, float *work)
+{
+    const xtract_fft_native_data *data = (const xtract_fft_native_data *)plan->data;
+
+    data->rdftf(&data->tables, isgn, a, work);
+}
+
+/* DCT-II from a real FFT. For even N this is Makhoul's algorithm: the even
+ * samples followed by the odd samples in reverse order have the FFT V, and
+ * C[k] = Re(exp(-i pi k / 2N) V[k]). For odd N the FFT Y of the input followed
+ * by its mirror image gives C[k] = Re(exp(-i pi k / 2N) Y[k]) / 2 */
+static void native_dct(const xtract_fft_plan *plan, double *a, double *work)
+{
+    const xtract_fft_native_data *data = (const xtract_fft_native_data *)plan->data;
+    const int N = plan->N;
+    const int h = N >> 1;
+    const double *c = data->dct;
+    const double *s = c + N;
+    double *v = work;
+    int j, k;
+
+    if(N & 1)
+    {
+        for(j = 0; j < N; ++j)
+        {
+            v[j] = a[j];
+            v[2 * N - 1 - j] = a[j];
+        }
+
+        data->rdft(&data->tables, 1, v, work + data->R);
+
+        /* Re Y[k] is v[2k] and Im Y[k] is -v[2k + 1] */
+        a[0] = 0.5 * v[0];
+
+        for(k = 1; k < N; ++k)
+        {
+            a[k] = 0.5 * (c[k] * v[2 * k] - s[k] * v[2 * k + 1]);
+        }
+    }
+    else
+    {
+        for(j = 0; j < h; ++j)
+        {
+            v[j] = a[2 * j];
+            v[N - 1 - j] = a[2 * j + 1];
+        }
+
+        data->rdft(&data->tables, 1, v, work + data->R);
+
+        /* C[N - k] uses V[N - k] = conj(V[k]) */
+        a[0] = v[0];
+        a[h] = c[h] * v[1];
+
+        for(k = 1; k < h; ++k)
+        {
+            a[k] = c[k] * v[2 * k] - s[k] * v[2 * k + 1];
+            a[N - k] = s[k] * v[2 * k] + c[k] * v[2 * k + 1];
+        }
+    }
+}
+
+const xtract_fft_backend xtract_fft_backend_native =
+{
+    XTRACT_FFT_BACKEND_NATIVE,
+    true,
+    native_name,
+    native_plan_init,
+    native_plan_free,
+    native_rdft,
+    native_rdftf,
+    native_dct
+};
@@ -0,0 +1,514 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* fft_native_impl.h: template for the native real FFT. fft_native.c includes
+ * this file once for each sample type and instruction set, with
+ *
+ *   XTRACT_NATIVE_REAL     the sample type
+ *   XTRACT_NATIVE_FN(f)    the name of function f for this instantiation
+ *   XTRACT_NATIVE_TARGET   a function attribute selecting the instruction set
+ *
+ * defined. The loops below work on split real and imaginary arrays with unit
+ * stride so that the compiler can vectorise them for the selected target.
+ *
+ * The complex FFT is a mixed radix Stockham autosort FFT, so no bit reversal
+ * is needed. Its passes are radix 4 first, then 3 and 5, with a final radix-2
+ * pass if needed. The first radix-4 pass is vectorised over butterflies and
+ * the others over the stride. Sizes with other prime factors use Bluestein's
+ * algorithm, a convolution computed with power of two FFTs.
+ *
+ * A real FFT of size N is computed as a complex FFT of size N / 2 of the even
+ * and odd samples followed by a split into the two half spectra.
+ *
+ * A radix r pass of m butterflies takes W^p ... W^(r-1)p from 2(r - 1)
+ * contiguous arrays of m values, real and imaginary parts in turn. The split
+ * uses a table of exp(-2 pi i k / N) for k <= N / 4.
+ */
+
+#define T XTRACT_NATIVE_REAL
+
+/* The first radix-4 pass, which has stride 1. The inputs are the four rows
+ * of m values at x + j * m, and the outputs are interleaved */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(first_pass4)(int m, const T *restrict xr, const T *restrict xi, T *restrict yr, T *restrict yi, const T *restrict tw)
+{
+    const T *restrict x0r = xr, *restrict x1r = xr + m, *restrict x2r = xr + 2 * m, *restrict x3r = xr + 3 * m;
+    const T *restrict x0i = xi, *restrict x1i = xi + m, *restrict x2i = xi + 2 * m, *restrict x3i = xi + 3 * m;
+    const T *restrict w1r = tw, *restrict w1i = tw + m;
+    const T *restrict w2r = tw + 2 * m, *restrict w2i = tw + 3 * m;
+    const T *restrict w3r = tw + 4 * m, *restrict w3i = tw + 5 * m;
+    int p;
+
+    for(p = 0; p < m; ++p)
+    {
+        const T t0r = x0r[p] + x2r[p];
+        const T t0i = x0i[p] + x2i[p];
+        const T t1r = x0r[p] - x2r[p];
+        const T t1i = x0i[p] - x2i[p];
+        const T t2r = x1r[p] + x3r[p];
+        const T t2i = x1i[p] + x3i[p];
+        const T t3r = x1r[p] - x3r[p];
+        const T t3i = x1i[p] - x3i[p];
+        const T u1r = t1r + t3i;
+        const T u1i = t1i - t3r;
+        const T u2r = t0r - t2r;
+        const T u2i = t0i - t2i;
+        const T u3r = t1r - t3i;
+        const T u3i = t1i + t3r;
+
+        yr[4 * p] = t0r + t2r;
+        yi[4 * p] = t0i + t2i;
+        yr[4 * p + 1] = u1r * w1r[p] - u1i * w1i[p];
+        yi[4 * p + 1] = u1r * w1i[p] + u1i * w1r[p];
+        yr[4 * p + 2] = u2r * w2r[p] - u2i * w2i[p];
+        yi[4 * p + 2] = u2r * w2i[p] + u2i * w2r[p];
+        yr[4 * p + 3] = u3r * w3r[p] - u3i * w3i[p];
+        yi[4 * p + 3] = u3r * w3i[p] + u3i * w3r[p];
+    }
+}
+
+/* s radix-4 butterflies with the same twiddles, on x[q + j * is] for q < s,
+ * writing to the separate rows yj. The rows are passed separately so that
+ * the compiler knows they don't overlap */
+static inline XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(butterflies4)(int s, const T *restrict xr, const T *restrict xi, int is,
+        T *restrict y0r, T *restrict y0i, T *restrict y1r, T *restrict y1i,
+        T *restrict y2r, T *restrict y2i, T *restrict y3r, T *restrict y3i,
+        T w1r, T w1i, T w2r, T w2i, T w3r, T w3i)
+{
+    int q;
+
+    for(q = 0; q < s; ++q)
+    {
+        const T t0r = xr[q] + xr[q + 2 * is];
+        const T t0i = xi[q] + xi[q + 2 * is];
+        const T t1r = xr[q] - xr[q + 2 * is];
+        const T t1i = xi[q] - xi[q + 2 * is];
+        const T t2r = xr[q + is] + xr[q + 3 * is];
+        const T t2i = xi[q + is] + xi[q + 3 * is];
+        const T t3r = xr[q + is] - xr[q + 3 * is];
+        const T t3i = xi[q + is] - xi[q + 3 * is];
+        const T u1r = t1r + t3i;
+        const T u1i = t1i - t3r;
+        const T u2r = t0r - t2r;
+        const T u2i = t0i - t2i;
+        const T u3r = t1r - t3i;
+        const T u3i = t1i + t3r;
+
+        y0r[q] = t0r + t2r;
+        y0i[q] = t0i + t2i;
+        y1r[q] = u1r * w1r - u1i * w1i;
+        y1i[q] = u1r * w1i + u1i * w1r;
+        y2r[q] = u2r * w2r - u2i * w2i;
+        y2i[q] = u2r * w2i + u2i * w2r;
+        y3r[q] = u3r * w3r - u3i * w3i;
+        y3i[q] = u3r * w3i + u3i * w3r;
+    }
+}
+
+/* One radix-4 pass of m butterflies of stride s > 1 from (xr, xi) to (yr, yi) */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(pass4)(int m, int s, const T *restrict xr, const T *restrict xi, T *restrict yr, T *restrict yi, const T *restrict tw)
+{
+    const T *w1r = tw;
+    const T *w1i = tw + m;
+    const T *w2r = tw + 2 * m;
+    const T *w2i = tw + 3 * m;
+    const T *w3r = tw + 4 * m;
+    const T *w3i = tw + 5 * m;
+    int p;
+
+    for(p = 0; p < m; ++p)
+    {
+        T *restrict y0r = yr + 4 * s * p;
+        T *restrict y0i = yi + 4 * s * p;
+
+        XTRACT_NATIVE_FN(butterflies4)(s, xr + s * p, xi + s * p, s * m,
+                y0r, y0i, y0r + s, y0i + s, y0r + 2 * s, y0i + 2 * s, y0r + 3 * s, y0i + 3 * s,
+                w1r[p], w1i[p], w2r[p], w2i[p], w3r[p], w3i[p]);
+    }
+}
+
+/* s radix-3 butterflies with the same twiddles, as butterflies4() */
+static inline XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(butterflies3)(int s, const T *restrict xr, const T *restrict xi, int is,
+        T *restrict y0r, T *restrict y0i, T *restrict y1r, T *restrict y1i, T *restrict y2r, T *restrict y2i,
+        T w1r, T w1i, T w2r, T w2i)
+{
+    const T s3 = (T)0.86602540378443864676; /* sin(2 pi / 3) */
+    int q;
+
+    for(q = 0; q < s; ++q)
+    {
+        const T t1r = xr[q + is] + xr[q + 2 * is];
+        const T t1i = xi[q + is] + xi[q + 2 * is];
+        const T t2r = xr[q] - (T)0.5 * t1r;
+        const T t2i = xi[q] - (T)0.5 * t1i;
+        const T dr = s3 * (xr[q + is] - xr[q + 2 * is]);
+        const T di = s3 * (xi[q + is] - xi[q + 2 * is]);
+        const T u1r = t2r + di;
+        const T u1i = t2i - dr;
+        const T u2r = t2r - di;
+        const T u2i = t2i + dr;
+
+        y0r[q] = xr[q] + t1r;
+        y0i[q] = xi[q] + t1i;
+        y1r[q] = u1r * w1r - u1i * w1i;
+        y1i[q] = u1r * w1i + u1i * w1r;
+        y2r[q] = u2r * w2r - u2i * w2i;
+        y2i[q] = u2r * w2i + u2i * w2r;
+    }
+}
+
+/* One radix-3 pass of m butterflies of stride s */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(pass3)(int m, int s, const T *restrict xr, const T *restrict xi, T *restrict yr, T *restrict yi, const T *restrict tw)
+{
+    int p;
+
+    for(p = 0; p < m; ++p)
+    {
+        T *restrict y0r = yr + 3 * s * p;
+        T *restrict y0i = yi + 3 * s * p;
+
+        XTRACT_NATIVE_FN(butterflies3)(s, xr + s * p, xi + s * p, s * m,
+                y0r, y0i, y0r + s, y0i + s, y0r + 2 * s, y0i + 2 * s,
+                tw[p], tw[m + p], tw[2 * m + p], tw[3 * m + p]);
+    }
+}
+
+/* s radix-5 butterflies with the same twiddles, as butterflies4() */
+static inline XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(butterflies5)(int s, const T *restrict xr, const T *restrict xi, int is,
+        T *restrict y0r, T *restrict y0i, T *restrict y1r, T *restrict y1i, T *restrict y2r, T *restrict y2i,
+        T *restrict y3r, T *restrict y3i, T *restrict y4r, T *restrict y4i,
+        T w1r, T w1i, T w2r, T w2i, T w3r, T w3i, T w4r, T w4i)
+{
+    const T c1 = (T)0.30901699437494742410;  /* cos(2 pi / 5) */
+    const T c2 = (T)-0.80901699437494742410; /* cos(4 pi / 5) */
+    const T s1 = (T)0.95105651629515357212;  /* sin(2 pi / 5) */
+    const T s2 = (T)0.58778525229247312917;  /* sin(4 pi / 5) */
+    int q;
+
+    for(q = 0; q < s; ++q)
+    {
+        const T a1r = xr[q + is] + xr[q + 4 * is];
+        const T a1i = xi[q + is] + xi[q + 4 * is];
+        const T b1r = xr[q + is] - xr[q + 4 * is];
+        const T b1i = xi[q + is] - xi[q + 4 * is];
+        const T a2r = xr[q + 2 * is] + xr[q + 3 * is];
+        const T a2i = xi[q + 2 * is] + xi[q + 3 * is];
+        const T b2r = xr[q + 2 * is] - xr[q + 3 * is];
+        const T b2i = xi[q + 2 * is] - xi[q + 3 * is];
+        /* y1 and y4 are c14 -/+ i v14, y2 and y3 are c23 -/+ i v23 */
+        const T c14r = xr[q] + c1 * a1r + c2 * a2r;
+        const T c14i = xi[q] + c1 * a1i + c2 * a2i;
+        const T c23r = xr[q] + c2 * a1r + c1 * a2r;
+        const T c23i = xi[q] + c2 * a1i + c1 * a2i;
+        const T v14r = s1 * b1r + s2 * b2r;
+        const T v14i = s1 * b1i + s2 * b2i;
+        const T v23r = s2 * b1r - s1 * b2r;
+        const T v23i = s2 * b1i - s1 * b2i;
+        const T u1r = c14r + v14i;
+        const T u1i = c14i - v14r;
+        const T u4r = c14r - v14i;
+        const T u4i = c14i + v14r;
+        const T u2r = c23r + v23i;
+        const T u2i = c23i - v23r;
+        const T u3r = c23r - v23i;
+        const T u3i = c23i + v23r;
+
+        y0r[q] = xr[q] + a1r + a2r;
+        y0i[q] = xi[q] + a1i + a2i;
+        y1r[q] = u1r * w1r - u1i * w1i;
+        y1i[q] = u1r * w1i + u1i * w1r;
+        y2r[q] = u2r * w2r - u2i * w2i;
+        y2i[q] = u2r * w2i + u2i * w2r;
+        y3r[q] = u3r * w3r - u3i * w3i;
+        y3i[q] = u3r * w3i + u3i * w3r;
+        y4r[q] = u4r * w4r - u4i * w4i;
+        y4i[q] = u4r * w4i + u4i * w4r;
+    }
+}
+
+/* One radix-5 pass of m butterflies of stride s */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(pass5)(int m, int s, const T *restrict xr, const T *restrict xi, T *restrict yr, T *restrict yi, const T *restrict tw)
+{
+    int p;
+
+    for(p = 0; p < m; ++p)
+    {
+        T *restrict y0r = yr + 5 * s * p;
+        T *restrict y0i = yi + 5 * s * p;
+
+        XTRACT_NATIVE_FN(butterflies5)(s, xr + s * p, xi + s * p, s * m,
+                y0r, y0i, y0r + s, y0i + s, y0r + 2 * s, y0i + 2 * s,
+                y0r + 3 * s, y0i + 3 * s, y0r + 4 * s, y0i + 4 * s,
+                tw[p], tw[m + p], tw[2 * m + p], tw[3 * m + p],
+                tw[4 * m + p], tw[5 * m + p], tw[6 * m + p], tw[7 * m + p]);
+    }
+}
+
+/* Final radix-2 pass of stride s, where every twiddle is 1 */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(pass2)(int s, const T *restrict xr, const T *restrict xi, T *restrict yr, T *restrict yi)
+{
+    int q;
+
+    for(q = 0; q < s; ++q)
+    {
+        yr[q] = xr[q] + xr[q + s];
+        yi[q] = xi[q] + xi[q + s];
+        yr[q + s] = xr[q] - xr[q + s];
+        yi[q + s] = xi[q] - xi[q + s];
+    }
+}
+
+/* Complex FFT of size n with the given passes, of (xr, xi) using (yr, yi) as
+ * scratch memory. Sets *outr and *outi to whichever pair holds the result */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(stockham)(int n, int passes, const int *radix, T *xr, T *xi, T *yr, T *yi, const T *tw, T **outr, T **outi)
+{
+    int L = n;
+    int s = 1;
+    int i, m;
+    T *tr, *ti;
+
+    for(i = 0; i < passes; ++i)
+    {
+        m = L / radix[i];
+
+        switch(radix[i])
+        {
+        case 4:
+            if(s == 1)
+                XTRACT_NATIVE_FN(first_pass4)(m, xr, xi, yr, yi, tw);
+            else
+                XTRACT_NATIVE_FN(pass4)(m, s, xr, xi, yr, yi, tw);
+            break;
+        case 3:
+            XTRACT_NATIVE_FN(pass3)(m, s, xr, xi, yr, yi, tw);
+            break;
+        case 5:
+            XTRACT_NATIVE_FN(pass5)(m, s, xr, xi, yr, yi, tw);
+            break;
+        default:
+            /* Only ever the last pass, so m is 1 and has no twiddles */
+            XTRACT_NATIVE_FN(pass2)(s, xr, xi, yr, yi);
+            break;
+        }
+
+        if(radix[i] != 2)
+            tw += 2 * (radix[i] - 1) * m;
+        L = m;
+        s *= radix[i];
+
+        tr = xr; xr = yr; yr = tr;
+        ti = xi; xi = yi; yi = ti;
+    }
+
+    *outr = xr;
+    *outi = xi;
+}
+
+/* Complex FFT of size t->n of (zr, zi) in place using Bluestein's algorithm,
+ * X[k] = c[k] sum_j (z[j] c[j]) conj(c[k - j]) with the chirp
+ * c[j] = exp(-i pi j^2 / n). The sum is a cyclic convolution of size
+ * M = t->cn, computed with the power of two passes in t. work must hold 4M
+ * elements */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(bluestein)(const xtract_native_tables *t, T *restrict zr, T *restrict zi, T *restrict work)
+{
+    const int n = t->n;
+    const int M = t->cn;
+    const T *cr = (const T *)t->chirp;
+    const T *ci = cr + n;
+    const T *kr = (const T *)t->kernel;
+    const T *ki = kr + M;
+    const T scale = (T)1.0 / (T)M;
+    T *ar = work;
+    T *ai = work + M;
+    T *pr, *pi;
+    int j;
+
+    for(j = 0; j < n; ++j)
+    {
+        ar[j] = zr[j] * cr[j] - zi[j] * ci[j];
+        ai[j] = zr[j] * ci[j] + zi[j] * cr[j];
+    }
+
+    for(j = n; j < M; ++j)
+    {
+        ar[j] = 0;
+        ai[j] = 0;
+    }
+
+    XTRACT_NATIVE_FN(stockham)(M, t->passes, t->radix, ar, ai, work + 2 * M, work + 3 * M, (const T *)t->tw, &pr, &pi);
+
+    /* Multiply by the transformed kernel and conjugate, so that a forward FFT
+     * gives the conjugate of the inverse */
+    for(j = 0; j < M; ++j)
+    {
+        const T re = pr[j] * kr[j] - pi[j] * ki[j];
+        const T im = pr[j] * ki[j] + pi[j] * kr[j];
+
+        pr[j] = re;
+        pi[j] = -im;
+    }
+
+    ar = pr;
+    ai = pi;
+    XTRACT_NATIVE_FN(stockham)(M, t->passes, t->radix, ar, ai, ar == work ? work + 2 * M : work,
+            ar == work ? work + 3 * M : work + M, (const T *)t->tw, &pr, &pi);
+
+    for(j = 0; j < n; ++j)
+    {
+        const T re = pr[j] * scale;
+        const T im = -pi[j] * scale;
+
+        zr[j] = re * cr[j] - im * ci[j];
+        zi[j] = re * ci[j] + im * cr[j];
+    }
+}
+
+/* Complex FFT of size t->n of (xr, xi), as stockham(). work is only used by
+ * Bluestein's algorithm */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(cfft)(const xtract_native_tables *t, T *xr, T *xi, T *yr, T *yi, T *work, T **outr, T **outi)
+{
+    if(t->bluestein)
+    {
+        XTRACT_NATIVE_FN(bluestein)(t, xr, xi, work);
+        *outr = xr;
+        *outi = xi;
+    }
+    else
+    {
+        XTRACT_NATIVE_FN(stockham)(t->n, t->passes, t->radix, xr, xi, yr, yi, (const T *)t->tw, outr, outi);
+    }
+}
+
+/* Split Z into the spectra E and O of the even and odd samples, then
+ * X[k] = E[k] + W^k O[k] and X[n - k] = conj(E[k] - W^k O[k]) for
+ * 0 < k < n - k. Bins below n / 2 are written to lo and the bins above it to
+ * hi, which points to a + n */
+static inline XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(split)(int n, const T *restrict zr, const T *restrict zi,
+        T *restrict lo, T *restrict hi, const T *restrict wr, const T *restrict wi)
+{
+    int k;
+
+    for(k = 1; 2 * k < n; ++k)
+    {
+        const int c = n - k;
+        const T er = (T)0.5 * (zr[k] + zr[c]);
+        const T ei = (T)0.5 * (zi[k] - zi[c]);
+        const T or_ = (T)0.5 * (zi[k] + zi[c]);
+        const T oi = (T)0.5 * (zr[c] - zr[k]);
+        const T tr = or_ * wr[k] - oi * wi[k];
+        const T ti = or_ * wi[k] + oi * wr[k];
+
+        lo[2 * k] = er + tr;
+        lo[2 * k + 1] = -(ei + ti);
+        hi[n - 2 * k] = er - tr;
+        hi[n - 2 * k + 1] = ei - ti;
+    }
+}
+
+/* The inverse of split(), giving conj(Z) in (xlor, xloi) below n / 2 and in
+ * (xhir, xhii) above it, which point to x + n */
+static inline XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(join)(int n, const T *restrict a,
+        T *restrict xlor, T *restrict xloi, T *restrict xhir, T *restrict xhii, const T *restrict wr, const T *restrict wi)
+{
+    int k;
+
+    for(k = 1; 2 * k < n; ++k)
+    {
+        const int c = n - k;
+        const T er = (T)0.5 * (a[2 * k] + a[2 * c]);
+        const T ei = (T)0.5 * (a[2 * c + 1] - a[2 * k + 1]);
+        const T dr = (T)0.5 * (a[2 * k] - a[2 * c]);
+        const T di = (T)-0.5 * (a[2 * k + 1] + a[2 * c + 1]);
+        const T or_ = dr * wr[k] + di * wi[k];
+        const T oi = di * wr[k] - dr * wi[k];
+
+        xlor[k] = er - oi;
+        xloi[k] = -(ei + or_);
+        xhir[-k] = er + oi;
+        xhii[-k] = ei - or_;
+    }
+}
+
+/* Real FFT with the layout and scaling of Ooura's rdft(), for any even N.
+ * work must hold 2N elements, plus 4M for Bluestein's algorithm */
+static XTRACT_NATIVE_TARGET void XTRACT_NATIVE_FN(rdft)(const xtract_native_tables *t, int isgn, T *restrict a, T *restrict work)
+{
+    const int n = t->n;
+    const int h = n >> 1;
+    const T *wr = (const T *)t->wr;
+    const T *wi = (const T *)t->wi;
+    T *xr = work;
+    T *xi = work + n;
+    T *zr, *zi;
+    int j;
+
+    if(isgn >= 0)
+    {
+        for(j = 0; j < n; ++j)
+        {
+            xr[j] = a[2 * j];
+            xi[j] = a[2 * j + 1];
+        }
+
+        XTRACT_NATIVE_FN(cfft)(t, xr, xi, work + 2 * n, work + 3 * n, work + 4 * n, &zr, &zi);
+
+        a[0] = zr[0] + zi[0];
+        a[1] = zr[0] - zi[0];
+
+        XTRACT_NATIVE_FN(split)(n, zr, zi, a, a + n, wr, wi);
+
+        /* W^(n / 2) = -i, so the middle bin is Z[n / 2] itself */
+        if(h > 0 && (n & 1) == 0)
+        {
+            a[n] = zr[h];
+            a[n + 1] = zi[h];
+        }
+    }
+    else
+    {
+        /* Rebuild Z from X, conjugated so that the forward transform gives
+         * the conjugate of the unnormalised inverse */
+        xr[0] = (T)0.5 * (a[0] + a[1]);
+        xi[0] = (T)-0.5 * (a[0] - a[1]);
+
+        XTRACT_NATIVE_FN(join)(n, a, xr, xi, xr + n, xi + n, wr, wi);
+
+        if(h > 0 && (n & 1) == 0)
+        {
+            xr[h] = a[n];
+            xi[h] = -a[n + 1];
+        }
+
+        XTRACT_NATIVE_FN(cfft)(t, xr, xi, work + 2 * n, work + 3 * n, work + 4 * n, &zr, &zi);
+
+        for(j = 0; j < n; ++j)
+        {
+            a[2 * j] = zr[j];
+            a[2 * j + 1] = -zi[j];
+        }
+    }
+}
+
+#undef T
+#undef XTRACT_NATIVE_REAL
+#undef XTRACT_NATIVE_FN
+#undef XTRACT_NATIVE_TARGET
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* fft_ooura.c: FFT backend using Ooura's fftsg */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "fft.h"
+#include "ooura/fftsg.h"
+#include "ooura/fftsgf.h"
+#include "xtract/libxtract.h"
+
+typedef struct xtract_fft_ooura_data_
+{
+    int *ip;
+    double *w;
+    float *wf;
+} xtract_fft_ooura_data;
+
+static const char *ooura_name(void)
+{
+    return "ooura";
+}
+
+static void ooura_plan_free(xtract_fft_plan *plan)
+{
+    xtract_fft_ooura_data *data = (xtract_fft_ooura_data *)plan->data;
+
+    if(data == NULL)
+        return;
+
+    free(data->ip);
+    free(data->w);
+    free(data->wf);
+    free(data);
+    plan->data = NULL;
+}
+
+static int ooura_plan_init(xtract_fft_plan *plan)
+{
+    /* Build the complete twiddle tables up front, so that rdft() and ddct()
+     * never need to write to them */
+    int N = plan->N;
+    int nw = N >> 2 > 0 ? N >> 2 : 1;
+    int nc = plan->kind == XTRACT_FFT_DCT ? N : nw;
+    xtract_fft_ooura_data *data = (xtract_fft_ooura_data *)calloc(1, sizeof(xtract_fft_ooura_data));
+
+    if(data == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    plan->data = data;
+    plan->work_size = 0;
+
+    data->ip = (int *)calloc(3 + sqrt((double)N), sizeof(int));
+
+    if(plan->kind == XTRACT_FFT_REAL_FLOAT)
+        data->wf = (float *)calloc(nw + nc, sizeof(float));
+    else
+        data->w = (double *)calloc(nw + nc, sizeof(double));
+
+    if(data->ip == NULL || (data->w == NULL && data->wf == NULL))
+        return XTRACT_MALLOC_FAILED;
+
+    if(plan->kind == XTRACT_FFT_REAL_FLOAT)
+    {
+        makewtf(nw, data->ip, data->wf);
+        makectf(nc, data->ip, data->wf + nw);
+    }
+    else
+    {
+        makewt(nw, data->ip, data->w);
+        makect(nc, data->ip, data->w + nw);
+    }
+
+    return XTRACT_SUCCESS;
+}
+
+static void ooura_rdft(const xtract_fft_plan *plan, int isgn, double *a, double *work)
+{
+    const xtract_fft_ooura_data *data = (const xtract_fft_ooura_data *)plan->data;
+
+    (void)work;
+    rdft(plan->N, isgn, a, data->ip, data->w);
+}
+
+static void ooura_rdftf(const xtract_fft_plan *plan, int isgn, float *a, float *work)
+{
+    const xtract_fft_ooura_data *data = (const xtract_fft_ooura_data *)plan->data;
+
+    (void)work;
+    rdftf(plan->N, isgn, a, data->ip, data->wf);
+}
+
+static void ooura_dct(const xtract_fft_plan *plan, double *a, double *work)
+{
+    const xtract_fft_ooura_data *data = (const xtract_fft_ooura_data *)plan->data;
+
+    (void)work;
+    ddct(plan->N, -1, a, data->ip, data->w);
+}
+
+const xtract_fft_backend xtract_fft_backend_ooura =
+{
+    XTRACT_FFT_BACKEND_OOURA,
+    false,
+    ooura_name,
+    ooura_plan_init,
+    ooura_plan_free,
+    ooura_rdft,
+    ooura_rdftf,
+    ooura_dct
+};
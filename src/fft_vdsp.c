@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* fft_vdsp.c: FFT backend using Apple's vDSP */
+
+#ifdef __APPLE__
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <Accelerate/Accelerate.h>
+
+#include "fft.h"
+#include "xtract/libxtract.h"
+
+typedef struct xtract_fft_vdsp_data_
+{
+    FFTSetupD setup;
+    FFTSetup setupf;
+    vDSP_Length log2N;
+} xtract_fft_vdsp_data;
+
+static const char *vdsp_name(void)
+{
+    return "vdsp";
+}
+
+static void vdsp_plan_free(xtract_fft_plan *plan)
+{
+    xtract_fft_vdsp_data *data = (xtract_fft_vdsp_data *)plan->data;
+
+    if(data == NULL)
+        return;
+
+    if(data->setup != NULL)
+        vDSP_destroy_fftsetupD(data->setup);
+    if(data->setupf != NULL)
+        vDSP_destroy_fftsetup(data->setupf);
+    free(data);
+    plan->data = NULL;
+}
+
+static int vdsp_plan_init(xtract_fft_plan *plan)
+{
+    xtract_fft_vdsp_data *data = (xtract_fft_vdsp_data *)calloc(1, sizeof(xtract_fft_vdsp_data));
+
+    if(data == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    plan->data = data;
+    /* Split complex buffer: N / 2 real parts followed by N / 2 imaginary parts */
+    plan->work_size = plan->N;
+    data->log2N = (vDSP_Length)log2f(plan->N);
+
+    if(plan->kind == XTRACT_FFT_REAL_FLOAT)
+        data->setupf = vDSP_create_fftsetup(data->log2N, FFT_RADIX2);
+    else
+        data->setup = vDSP_create_fftsetupD(data->log2N, FFT_RADIX2);
+
+    if(data->setup == NULL && data->setupf == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    return XTRACT_SUCCESS;
+}
+
+/* vDSP's real FFT gives twice the DFT with the Nyquist component in imagp[0],
+ * and its inverse gives N times the signal. Both are rescaled and the
+ * imaginary parts negated to match the Ooura layout */
+static void vdsp_rdft(const xtract_fft_plan *plan, int isgn, double *a, double *work)
+{
+    const xtract_fft_vdsp_data *data = (const xtract_fft_vdsp_data *)plan->data;
+    vDSP_Length n = plan->N >> 1;
+    double half = 0.5;
+    DSPDoubleSplitComplex split;
+
+    split.realp = work;
+    split.imagp = work + n;
+
+    vDSP_ctozD((const DSPDoubleComplex *)a, 2, &split, 1, n);
+
+    if(isgn >= 0)
+    {
+        vDSP_fft_zripD(data->setup, &split, 1, data->log2N, FFT_FORWARD);
+        vDSP_vnegD(split.imagp + 1, 1, split.imagp + 1, 1, n - 1);
+    }
+    else
+    {
+        vDSP_vnegD(split.imagp + 1, 1, split.imagp + 1, 1, n - 1);
+        vDSP_fft_zripD(data->setup, &split, 1, data->log2N, FFT_INVERSE);
+    }
+
+    vDSP_ztocD(&split, 1, (DSPDoubleComplex *)a, 2, n);
+    vDSP_vsmulD(a, 1, &half, a, 1, plan->N);
+}
+
+static void vdsp_rdftf(const xtract_fft_plan *plan, int isgn, float *a, float *work)
+{
+    const xtract_fft_vdsp_data *data = (const xtract_fft_vdsp_data *)plan->data;
+    vDSP_Length n = plan->N >> 1;
+    float half = 0.5f;
+    DSPSplitComplex split;
+
+    split.realp = work;
+    split.imagp = work + n;
+
+    vDSP_ctoz((const DSPComplex *)a, 2, &split, 1, n);
+
+    if(isgn >= 0)
+    {
+        vDSP_fft_zrip(data->setupf, &split, 1, data->log2N, FFT_FORWARD);
+        vDSP_vneg(split.imagp + 1, 1, split.imagp + 1, 1, n - 1);
+    }
+    else
+    {
+        vDSP_vneg(split.imagp + 1, 1, split.imagp + 1, 1, n - 1);
+        vDSP_fft_zrip(data->setupf, &split, 1, data->log2N, FFT_INVERSE);
+    }
+
+    vDSP_ztoc(&split, 1, (DSPComplex *)a, 2, n);
+    vDSP_vsmul(a, 1, &half, a, 1, plan->N);
+}
+
+const xtract_fft_backend xtract_fft_backend_vdsp =
+{
+    XTRACT_FFT_BACKEND_VDSP,
+    false,
+    vdsp_name,
+    vdsp_plan_init,
+    vdsp_plan_free,
+    vdsp_rdft,
+    vdsp_rdftf,
+    NULL
+};
+
+#else
+
+/* ISO C doesn't allow an empty translation unit */
+typedef int xtract_fft_vdsp_unavailable;
+
+#endif /* __APPLE__ */
@@ -24,6 +24,7 @@
 /* fini.c: Contains library destructor routine */
 
 #include "xtract/libxtract.h"
+#include "fft.h"
 
 #ifdef __GNUC__
 __attribute__((destructor)) void fini()
@@ -32,6 +33,7 @@ void _fini()
 #endif
 {
     xtract_free_fft();
+    xtract_fft_plan_cache_free();
 }
 
 
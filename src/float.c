@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* float.c: contains single precision versions of the most commonly used features */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+
+#ifdef __APPLE__
+#include <Accelerate/Accelerate.h>
+#endif
+
+#include "fft.h"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_float.h"
+#include "xtract_macros_private.h"
+#include "xtract_filterbank_private.h"
+#include "xtract_globals_private.h"
+#include "xtract_simd_private.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327
+#endif
+
+int xtractf_mean(const float *data, const int N, const void *argv, float *result)
+{
+
+#ifdef __APPLE__
+    vDSP_meanv(data, 1, result, N);
+#else
+    *result = xtract_simd->sum_powf(data, N, 0.f, 1) / N;
+#endif
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_variance(const float *data, const int N, const void *argv, float *result)
+{
+
+    *result = xtract_simd->sum_powf(data, N, *(float *)argv, 2) / (N - 1);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_standard_deviation(const float *data, const int N, const void *argv, float *result)
+{
+
+    *result = sqrtf(*(float *)argv);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_average_deviation(const float *data, const int N, const void *argv, float *result)
+{
+
+    *result = xtract_simd->sum_abs_devf(data, N, *(float *)argv) / N;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_skewness(const float *data, const int N, const void *argv, float *result)
+{
+
+    const float arg0 = ((float *)argv)[0];
+    const float arg1 = ((float *)argv)[1];
+
+    *result = 0.f;
+
+    if (arg1 == 0)
+    {
+        return XTRACT_NO_RESULT;
+    }
+
+    *result = xtract_simd->sum_powf(data, N, arg0, 3) / XTRACT_POW3(arg1);
+    *result /= N;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_kurtosis(const float *data, const int N, const void *argv, float *result)
+{
+
+    const float arg0 = ((float *)argv)[0];
+    const float arg1 = ((float *)argv)[1];
+
+    *result = 0.f;
+
+    if (arg1 == 0)
+    {
+        return XTRACT_NO_RESULT;
+    }
+
+    *result = xtract_simd->sum_powf(data, N, arg0, 4) / XTRACT_POW4(arg1);
+    *result /= N;
+    *result -= 3.f;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_zcr(const float *data, const int N, const void *argv, float *result)
+{
+
+    *result = xtract_simd->count_negative_productsf(data, data + 1, N - 1) / N;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_rms_amplitude(const float *data, const int N, const void *argv, float *result)
+{
+
+#ifdef __APPLE__
+    vDSP_rmsqv(data, 1, result, N);
+#else
+    *result = sqrtf(xtract_simd->sum_powf(data, N, 0.f, 2) / (float)N);
+#endif
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_lowest_value(const float *data, const int N, const void *argv, float *result)
+{
+
+    *result = xtract_simd->min_abovef(data, N, *(float *)argv);
+
+    if (*result == FLT_MAX)
+        return XTRACT_NO_RESULT;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_highest_value(const float *data, const int N, const void *argv, float *result)
+{
+
+#ifdef __APPLE__
+    vDSP_maxv(data, 1, result, N);
+#else
+    *result = xtract_simd->maxf(data, N);
+#endif
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_sum(const float *data, const int N, const void *argv, float *result)
+{
+
+#ifdef __APPLE__
+    vDSP_sve(data, 1, result, N);
+#else
+    *result = xtract_simd->sum_powf(data, N, 0.f, 1);
+#endif
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_windowed(const float *data, const int N, const void *argv, float *result)
+{
+
+    int n = N;
+    const float *window = (const float *)argv;
+
+    while(n--)
+        result[n] = data[n] * window[n];
+
+    return XTRACT_SUCCESS;
+}
+
+float *xtractf_init_window(const int N, const int type)
+{
+    double *window;
+    float *windowf;
+    int n;
+
+    window = xtract_init_window(N, type);
+    if(window == NULL)
+        return NULL;
+
+    windowf = (float *)malloc(N * sizeof(float));
+    if(windowf != NULL)
+    {
+        for(n = 0; n < N; ++n)
+            windowf[n] = (float)window[n];
+    }
+
+    xtract_free_window(window);
+
+    return windowf;
+}
+
+void xtractf_free_window(float *window)
+{
+    free(window);
+}
+
+/* Single precision counterpart of spectrum_from_fft() in vector.c */
+static void spectrumf_from_fft(const float *re, const float *im, const int stride, const int N, const int vector, const int withDC, const int normalise, const float q, float *result)
+{
+    float NxN = XTRACT_SQ((float)N);
+    float max = 0.f;
+    float real = 0.f;
+    float imag = 0.f;
+    float temp;
+    int M = N >> 1;
+    int offset = withDC ? 0 : 1; /* discard DC and keep Nyquist unless withDC */
+    int n, m;
+
+    switch(vector)
+    {
+
+    case XTRACT_LOG_MAGNITUDE_SPECTRUM:
+        XTRACT_SPECTRUM_BINS(
+            temp = XTRACT_SQ(real) + XTRACT_SQ(imag);
+            temp = temp > XTRACT_LOG_LIMIT ? logf(sqrtf(temp) / (float)N) : XTRACT_LOG_LIMIT_DB;
+            result[m] = (temp + XTRACT_DB_SCALE_OFFSET) / XTRACT_DB_SCALE_OFFSET;
+            XTRACT_SET_FREQUENCY;
+            XTRACT_GET_MAX);
+        break;
+
+    case XTRACT_POWER_SPECTRUM:
+        XTRACT_SPECTRUM_BINS(
+            result[m] = (XTRACT_SQ(real) + XTRACT_SQ(imag)) / NxN;
+            XTRACT_SET_FREQUENCY;
+            XTRACT_GET_MAX);
+        break;
+
+    case XTRACT_LOG_POWER_SPECTRUM:
+        XTRACT_SPECTRUM_BINS(
+            temp = XTRACT_SQ(real) + XTRACT_SQ(imag);
+            temp = temp > XTRACT_LOG_LIMIT ? logf(temp / NxN) : XTRACT_LOG_LIMIT_DB;
+            result[m] = (temp + XTRACT_DB_SCALE_OFFSET) / XTRACT_DB_SCALE_OFFSET;
+            XTRACT_SET_FREQUENCY;
+            XTRACT_GET_MAX);
+        break;
+
+    case XTRACT_SPECTRUM_COEFFICIENTS:
+        XTRACT_SPECTRUM_BINS(
+            result[m*2] = real;
+            result[m*2+1] = imag);
+        for(m = 0; m < M; ++m)
+        {
+            XTRACT_GET_MAX;
+        }
+        break;
+
+    default:
+        /* MAGNITUDE_SPECTRUM */
+        XTRACT_SPECTRUM_BINS(
+            result[m] = sqrtf(XTRACT_SQ(real) + XTRACT_SQ(imag)) / (float)N;
+            XTRACT_SET_FREQUENCY;
+            XTRACT_GET_MAX);
+        break;
+    }
+
+    if(normalise && max != 0.f)
+    {
+        if(vector == XTRACT_SPECTRUM_COEFFICIENTS)
+        {
+            /* Interleaved formats: find true max magnitude, then scale both components */
+            float true_max = 0.f;
+            for(n = 0; n < M; n++)
+            {
+                float mag = sqrtf(XTRACT_SQ(result[n*2]) + XTRACT_SQ(result[n*2+1]));
+                if(mag > true_max) true_max = mag;
+            }
+            if(true_max != 0.f)
+            {
+                for(n = 0; n < M; n++)
+                {
+                    result[n*2] /= true_max;
+                    result[n*2+1] /= true_max;
+                }
+            }
+        }
+        else
+        {
+            for(n = 0; n < M; n++)
+                result[n] /= max;
+        }
+    }
+}
+
+int xtractf_spectrum(const float *data, const int N, const void *argv, float *result)
+{
+    return xtractf_spectrum_ctx(&xtract_thread_context, data, N, argv, result);
+}
+
+int xtractf_spectrum_ctx(xtract_context *ctx, const float *data, const int N, const void *argv, float *result)
+{
+
+    float q = ((const float *)argv)[0];
+    int vector = (int)((const float *)argv)[1];
+    int withDC = (int)((const float *)argv)[2];
+    int normalise = (int)((const float *)argv)[3];
+    const xtract_fft_plan *plan = NULL;
+    float *fft = NULL;
+
+    XTRACT_CHECK_q;
+    if(!ctx->fft_data_spectrum.initialised)
+    {
+        fprintf(stderr,
+                "libxtract: error: xtractf_spectrum() failed, "
+                "fft data unitialised.\n");
+        return XTRACT_NO_RESULT;
+    }
+
+    plan = xtract_context_fft_plan(ctx, &ctx->fft_data_spectrum_float, N, XTRACT_FFT_REAL_FLOAT);
+    if(plan == NULL)
+        return XTRACT_BAD_VECTOR_SIZE;
+
+    fft = xtract_context_workf(ctx, XTRACT_WORK_FFT, N);
+    if(fft == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    memcpy(fft, data, N * sizeof(float));
+    if(xtract_context_rdftf(ctx, plan, 1, fft) != XTRACT_SUCCESS)
+        return XTRACT_MALLOC_FAILED;
+    spectrumf_from_fft(fft, fft + 1, 2, N, vector, withDC, normalise, q, result);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_dct(const float *data, const int N, const void *argv, float *result)
+{
+    return xtractf_dct_ctx(&xtract_thread_context, data, N, argv, result);
+}
+
+int xtractf_dct_ctx(xtract_context *ctx, const float *data, const int N, const void *argv, float *result)
+{
+    const xtract_fft_plan *plan;
+    double *dct;
+    int n, rv;
+
+    /* The DCT plans are double precision, so widen the input first */
+    plan = xtract_context_fft_plan(ctx, &ctx->fft_data_dct, N, XTRACT_FFT_DCT);
+    if (plan == NULL)
+        return XTRACT_BAD_VECTOR_SIZE;
+
+    dct = xtract_context_work(ctx, XTRACT_WORK_FFT, N);
+    if (dct == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    for (n = 0; n < N; ++n)
+        dct[n] = data[n];
+
+    rv = xtract_context_dct(ctx, plan, dct);
+    if (rv != XTRACT_SUCCESS)
+        return rv;
+
+    for (n = 0; n < N; ++n)
+        result[n] = (float)dct[n];
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_mel_spectrogram(const float *data, const int N, const void *argv, float *result)
+{
+
+    const xtract_mel_filter *f = (const xtract_mel_filter *)argv;
+    const double *filter;
+    int n, k, start, length;
+
+    for(k = 0; k < f->n_filters; k++)
+    {
+        filter = xtract_filter_band(f, k, N, &start, &length);
+        result[k] = 0.f;
+        for(n = 0; n < length; n++)
+            result[k] += data[start + n] * (float)filter[n];
+        if(result[k] < XTRACT_LOG_LIMIT)
+            result[k] = XTRACT_LOG_LIMIT_DB;
+        else
+            result[k] = logf(result[k]);
+    }
+
+    return XTRACT_SUCCESS;
+}
+
+int xtractf_mfcc(const float *data, const int N, const void *argv, float *result)
+{
+    return xtractf_mfcc_ctx(&xtract_thread_context, data, N, argv, result);
+}
+
+int xtractf_mfcc_ctx(xtract_context *ctx, const float *data, const int N, const void *argv, float *result)
+{
+
+    const xtract_mel_filter *f = (const xtract_mel_filter *)argv;
+    float *temp;
+
+    temp = xtract_context_workf(ctx, XTRACT_WORK_CEPSTRUM, f->n_filters);
+    if(temp == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    xtractf_mel_spectrogram(data, N, f, temp);
+
+    return xtractf_dct_ctx(ctx, temp, f->n_filters, NULL, result);
+}
@@ -26,6 +26,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 
 #include "fft.h"
@@ -34,216 +35,113 @@
 #include "xtract_window_private.h"
 #define DEFINE_GLOBALS
 #include "xtract_globals_private.h"
+#include "xtract_simd_private.h"
 
-#ifdef USE_OOURA
-thread_local struct xtract_ooura_data_ ooura_data_dct;
-thread_local struct xtract_ooura_data_ ooura_data_mfcc;
-thread_local struct xtract_ooura_data_ ooura_data_spectrum;
-thread_local struct xtract_ooura_data_ ooura_data_autocorrelation_fft;
-#else
-thread_local xtract_vdsp_data vdsp_data_dct;
-thread_local xtract_vdsp_data vdsp_data_mfcc;
-thread_local xtract_vdsp_data vdsp_data_spectrum;
-thread_local xtract_vdsp_data vdsp_data_autocorrelation_fft;
-#endif
-
-thread_local dywapitchtracker wavelet_f0_state;
-
-#ifdef USE_OOURA
-void xtract_init_ooura_data(xtract_ooura_data *ooura_data, unsigned int N)
-{
-    ooura_data->ooura_ip  = (int *)calloc(2 + sqrt((double)N), sizeof(int));
-    ooura_data->ooura_w   = (double *)calloc(N * 5 / 4, sizeof(double));
-    ooura_data->initialised = true;
-}
+thread_local xtract_context xtract_thread_context;
 
-void xtract_free_ooura_data(xtract_ooura_data *ooura_data)
+static xtract_fft_data *xtract_fft_data_for_feature(xtract_context *ctx, int feature_name)
 {
-    free(ooura_data->ooura_ip);
-    free(ooura_data->ooura_w);
-    ooura_data->ooura_ip = NULL;
-    ooura_data->ooura_w = NULL;
-    ooura_data->initialised = false;
+    switch(feature_name)
+    {
+    case XTRACT_SPECTRUM:
+        return &ctx->fft_data_spectrum;
+    case XTRACT_AUTOCORRELATION_FFT:
+        return &ctx->fft_data_autocorrelation_fft;
+    case XTRACT_DCT:
+        return &ctx->fft_data_dct;
+    case XTRACT_MFCC:
+        return &ctx->fft_data_mfcc;
+    default:
+        return NULL;
+    }
 }
 
-int xtract_init_ooura_(int N, int feature_name)
+int xtract_context_init_fft(xtract_context *ctx, int N, int feature_name)
 {
+    xtract_fft_data *fft_data;
+    const xtract_fft_plan *plan;
+    int kind = XTRACT_FFT_REAL;
 
-    int M = N >> 1;
+    fft_data = xtract_fft_data_for_feature(ctx, feature_name);
 
-    if(feature_name == XTRACT_AUTOCORRELATION_FFT)
+    if(fft_data == NULL)
     {
-        M = N; /* allow for zero padding */
+        return XTRACT_SUCCESS;
     }
 
     switch(feature_name)
     {
-    case XTRACT_SPECTRUM:
-        if(ooura_data_spectrum.initialised)
-        {
-            xtract_free_ooura_data(&ooura_data_spectrum);
-        }
-        xtract_init_ooura_data(&ooura_data_spectrum, M);
-        break;
     case XTRACT_AUTOCORRELATION_FFT:
-        if(ooura_data_autocorrelation_fft.initialised)
-        {
-            xtract_free_ooura_data(&ooura_data_autocorrelation_fft);
-        }
-        xtract_init_ooura_data(&ooura_data_autocorrelation_fft, M);
+        N <<= 1; /* allow for zero padding */
         break;
     case XTRACT_DCT:
-        if(ooura_data_dct.initialised)
-        {
-            xtract_free_ooura_data(&ooura_data_dct);
-        }
-        xtract_init_ooura_data(&ooura_data_dct, M);
-        break;
     case XTRACT_MFCC:
-        if(ooura_data_mfcc.initialised)
-        {
-            xtract_free_ooura_data(&ooura_data_mfcc);
-        }
-        xtract_init_ooura_data(&ooura_data_mfcc, M);
+        kind = XTRACT_FFT_DCT;
         break;
     }
 
-    return XTRACT_SUCCESS;
-}
-
-void xtract_free_ooura_(void)
-{
-    if(ooura_data_spectrum.initialised)
-    {
-        xtract_free_ooura_data(&ooura_data_spectrum);
-    }
-    if(ooura_data_autocorrelation_fft.initialised)
+    /* Any even FFT size and any DCT size is supported */
+    if(N < 1 || (kind != XTRACT_FFT_DCT && (N < 2 || N & 1)))
     {
-        xtract_free_ooura_data(&ooura_data_autocorrelation_fft);
-    }
-    if(ooura_data_dct.initialised)
-    {
-        xtract_free_ooura_data(&ooura_data_dct);
-    }
-    if(ooura_data_mfcc.initialised)
-    {
-        xtract_free_ooura_data(&ooura_data_mfcc);
+        return XTRACT_ARGUMENT_ERROR;
     }
-}
-
-#else
 
-void xtract_init_vdsp_data(xtract_vdsp_data *vdsp_data, unsigned int N)
-{
-    vdsp_data->setup = vDSP_create_fftsetupD(log2f(N), FFT_RADIX2);
-    vdsp_data->fft.realp = (double *) calloc((N >> 1), sizeof(double));
-    vdsp_data->fft.imagp = (double *) calloc((N >> 1), sizeof(double));
-    vdsp_data->log2N = log2f(N);
-    vdsp_data->initialised = true;
-}
+    plan = xtract_context_fft_plan(ctx, fft_data, N, kind);
 
-void xtract_free_vdsp_data(xtract_vdsp_data *vdsp_data)
-{
-    free(vdsp_data->fft.realp);
-    free(vdsp_data->fft.imagp);
-    vDSP_destroy_fftsetupD(vdsp_data->setup);
-    vdsp_data->initialised = false;
-}
+    if(plan == NULL)
+    {
+        return XTRACT_MALLOC_FAILED;
+    }
 
-int xtract_init_vdsp_(int N, int feature_name)
-{
-    switch(feature_name)
+    /* Size the work buffers now so that the first frame doesn't allocate */
+    if((kind == XTRACT_FFT_REAL && xtract_context_work(ctx, XTRACT_WORK_FFT, N) == NULL) ||
+            (plan->work_size > 0 && xtract_context_work(ctx, XTRACT_WORK_FFT_BACKEND, plan->work_size) == NULL))
     {
-    case XTRACT_SPECTRUM:
-        if(vdsp_data_spectrum.initialised)
-        {
-            xtract_free_vdsp_data(&vdsp_data_spectrum);
-        }
-        xtract_init_vdsp_data(&vdsp_data_spectrum, N);
-        break;
-    case XTRACT_AUTOCORRELATION_FFT:
-        if(vdsp_data_autocorrelation_fft.initialised)
-        {
-            xtract_free_vdsp_data(&vdsp_data_autocorrelation_fft);
-        }
-        xtract_init_vdsp_data(&vdsp_data_autocorrelation_fft, N * 2); // allow for zero padding
-        break;
-    case XTRACT_DCT:
-        if(vdsp_data_dct.initialised)
-        {
-            xtract_free_vdsp_data(&vdsp_data_dct);
-        }
-        xtract_init_vdsp_data(&vdsp_data_dct, N);
-        break;
-    case XTRACT_MFCC:
-        if(vdsp_data_mfcc.initialised)
-        {
-            xtract_free_vdsp_data(&vdsp_data_mfcc);
-        }
-        xtract_init_vdsp_data(&vdsp_data_mfcc, N);
-        break;
+        return XTRACT_MALLOC_FAILED;
     }
 
+    fft_data->initialised = true;
+
     return XTRACT_SUCCESS;
 }
 
-void xtract_free_vdsp_(void)
+void xtract_context_free_fft(xtract_context *ctx)
 {
-    if(vdsp_data_spectrum.initialised)
-    {
-        xtract_free_vdsp_data(&vdsp_data_spectrum);
-    }
-    if(vdsp_data_autocorrelation_fft.initialised)
-    {
-        xtract_free_vdsp_data(&vdsp_data_autocorrelation_fft);
-    }
-    if(vdsp_data_dct.initialised)
+    /* Plans belong to the process wide cache, so only the references to them
+     * are dropped here */
+    ctx->fft_data_spectrum.plan = NULL;
+    ctx->fft_data_spectrum.initialised = false;
+    ctx->fft_data_autocorrelation_fft.plan = NULL;
+    ctx->fft_data_autocorrelation_fft.initialised = false;
+    ctx->fft_data_dct.plan = NULL;
+    ctx->fft_data_dct.initialised = false;
+    ctx->fft_data_mfcc.plan = NULL;
+    ctx->fft_data_mfcc.initialised = false;
+    ctx->fft_data_spectrum_float.plan = NULL;
+    ctx->fft_data_spectrum_float.initialised = false;
+
+    for (int n = 0; n < XTRACT_CONTEXT_RECENT_PLANS; ++n)
     {
-        xtract_free_vdsp_data(&vdsp_data_dct);
+        ctx->recent_plans[n] = NULL;
     }
-    if(vdsp_data_mfcc.initialised)
+    ctx->recent_plans_next = 0;
+
+    for (int n = 0; n < XTRACT_CONTEXT_WORK_BUFFERS; ++n)
     {
-        xtract_free_vdsp_data(&vdsp_data_mfcc);
+        free(ctx->work[n]);
+        ctx->work[n] = NULL;
+        ctx->work_size[n] = 0;
     }
 }
 
-
-#endif
-
 int xtract_init_fft(int N, int feature_name)
 {
-    if(!xtract_is_poweroftwo(N))
-    {
-        return XTRACT_ARGUMENT_ERROR;
-    }
-#ifdef USE_OOURA
-    return xtract_init_ooura_(N, feature_name);
-#else
-    return xtract_init_vdsp_(N, feature_name);
-#endif
+    return xtract_context_init_fft(&xtract_thread_context, N, feature_name);
 }
 
-extern thread_local double** dct_cos_table;
-extern thread_local int dct_cos_table_dim;
-
 void xtract_free_fft(void)
 {
-#ifdef USE_OOURA
-    xtract_free_ooura_();
-#else
-    xtract_free_vdsp_();
-#endif
-
-    if (dct_cos_table != NULL)
-    {
-        for (int n = 0; n < dct_cos_table_dim; ++n)
-        {
-            free(dct_cos_table[n]);
-        }
-        free(dct_cos_table);
-        dct_cos_table = NULL;
-        dct_cos_table_dim = 0;
-    }
+    xtract_context_free_fft(&xtract_thread_context);
 }
 
 
@@ -394,11 +292,7 @@ int xtract_init_mfcc(int N, double nyquist, int style, double freq_min, double f
     }
 
 
-    /* Initialise the fft_plan for the DCT */
-    /*
-     * Ooura doesn't support non power-of-two DCT
-    xtract_init_fft(freq_bands, XTRACT_MFCC);
-    */
+    /* The DCT plan of size freq_bands is created by xtract_mfcc() on first use */
 
     free(mel_peak);
     free(lin_peak);
@@ -469,12 +363,170 @@ int xtract_init_gfcc(int N, double nyquist, double freq_min, double freq_max, in
     return XTRACT_SUCCESS;
 }
 
-int xtract_init_wavelet_f0_state(void)
+/* Copy the coefficients of the dense tables above limit into filter. Each
+ * filter keeps the bins from its first to its last coefficient above limit */
+static int filterbank_make_sparse(int N, int freq_bands, double **tables, double limit, xtract_mel_filter *filter)
 {
-    dywapitch_inittracking(&wavelet_f0_state);
+    int n, k, first, last;
+    size_t total = 0;
+    double *w;
+
+    filter->n_filters = freq_bands;
+    filter->filters = NULL;
+    filter->start = (int *)malloc(2 * freq_bands * sizeof(int));
+
+    if(filter->start == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    filter->length = filter->start + freq_bands;
+
+    for(n = 0; n < freq_bands; n++)
+    {
+        first = 0;
+        last = -1;
+
+        for(k = 0; k < N; k++)
+        {
+            if(fabs(tables[n][k]) > limit)
+            {
+                if(last < 0)
+                    first = k;
+                last = k;
+            }
+        }
+
+        filter->start[n] = first;
+        filter->length[n] = last - first + 1;
+        total += filter->length[n];
+    }
+
+    /* All weights share one block, owned by weights[0] */
+    filter->weights = (double **)malloc(freq_bands * sizeof(double *));
+    w = (double *)malloc((total > 0 ? total : 1) * sizeof(double));
+
+    if(filter->weights == NULL || w == NULL)
+    {
+        free(w);
+        free(filter->weights);
+        free(filter->start);
+        filter->start = NULL;
+        filter->length = NULL;
+        filter->weights = NULL;
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    for(n = 0; n < freq_bands; n++)
+    {
+        filter->weights[n] = w;
+        memcpy(w, tables[n] + filter->start[n], filter->length[n] * sizeof(double));
+        w += filter->length[n];
+    }
+
     return XTRACT_SUCCESS;
 }
 
+/* Allocate freq_bands zeroed tables of N coefficients in one block, owned
+ * by the first table */
+static double **filterbank_tables_new(int N, int freq_bands)
+{
+    double **tables = (double **)malloc(freq_bands * sizeof(double *));
+    int n;
+
+    if(tables == NULL)
+        return NULL;
+
+    tables[0] = (double *)calloc((size_t)freq_bands * N, sizeof(double));
+
+    if(tables[0] == NULL)
+    {
+        free(tables);
+        return NULL;
+    }
+
+    for(n = 1; n < freq_bands; n++)
+        tables[n] = tables[0] + (size_t)n * N;
+
+    return tables;
+}
+
+static void filterbank_tables_free(double **tables)
+{
+    free(tables[0]);
+    free(tables);
+}
+
+int xtract_init_mfcc_sparse(int N, double nyquist, int style, double freq_min, double freq_max, int freq_bands, xtract_mel_filter *filter)
+{
+    double **tables;
+    int rv;
+
+    if(freq_bands <= 1)
+        return XTRACT_ARGUMENT_ERROR;
+
+    tables = filterbank_tables_new(N, freq_bands);
+
+    if(tables == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    rv = xtract_init_mfcc(N, nyquist, style, freq_min, freq_max, freq_bands, tables);
+
+    /* Mel filters are triangles, so only the exact zeros are dropped */
+    if(rv == XTRACT_SUCCESS)
+        rv = filterbank_make_sparse(N, freq_bands, tables, 0.0, filter);
+
+    filterbank_tables_free(tables);
+
+    return rv;
+}
+
+int xtract_init_gfcc_sparse(int N, double nyquist, double freq_min, double freq_max, int freq_bands, xtract_mel_filter *filter)
+{
+    double **tables;
+    int rv;
+
+    if(freq_bands <= 1)
+        return XTRACT_ARGUMENT_ERROR;
+
+    tables = filterbank_tables_new(N, freq_bands);
+
+    if(tables == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    rv = xtract_init_gfcc(N, nyquist, freq_min, freq_max, freq_bands, tables);
+
+    /* Gammatone gains peak at 1 and never reach zero */
+    if(rv == XTRACT_SUCCESS)
+        rv = filterbank_make_sparse(N, freq_bands, tables, 1e-6, filter);
+
+    filterbank_tables_free(tables);
+
+    return rv;
+}
+
+void xtract_free_mel_filter(xtract_mel_filter *filter)
+{
+    if(filter->weights != NULL && filter->n_filters > 0)
+        free(filter->weights[0]);
+
+    free(filter->weights);
+    free(filter->start);
+    filter->start = NULL;
+    filter->length = NULL;
+    filter->weights = NULL;
+    filter->n_filters = 0;
+}
+
+int xtract_context_init_wavelet_f0_state(xtract_context *ctx)
+{
+    dywapitch_inittracking(&ctx->wavelet_f0_state);
+    return XTRACT_SUCCESS;
+}
+
+int xtract_init_wavelet_f0_state(void)
+{
+    return xtract_context_init_wavelet_f0_state(&xtract_thread_context);
+}
+
 double *xtract_init_window(const int N, const int type)
 {
     double *window;
@@ -512,6 +564,9 @@ double *xtract_init_window(const int N, const int type)
     case XTRACT_BLACKMAN_HARRIS:
         blackman_harris(window, N);
         break;
+    case XTRACT_RECTANGULAR:
+        rectangular(window, N);
+        break;
     default:
         hann(window, N);
         break;
@@ -531,15 +586,9 @@ __attribute__((constructor)) void init()
 void _init()
 #endif
 {
-#ifdef USE_OOURA
-    ooura_data_dct.initialised = false;
-    ooura_data_spectrum.initialised = false;
-    ooura_data_autocorrelation_fft.initialised = false;
-    ooura_data_mfcc.initialised = false;
-#else
-    vdsp_data_dct.initialised = false;
-    vdsp_data_spectrum.initialised = false;
-    vdsp_data_autocorrelation_fft.initialised = false;
-    vdsp_data_mfcc.initialised = false;
-#endif
+    xtract_thread_context.fft_data_dct.initialised = false;
+    xtract_thread_context.fft_data_spectrum.initialised = false;
+    xtract_thread_context.fft_data_autocorrelation_fft.initialised = false;
+    xtract_thread_context.fft_data_mfcc.initialised = false;
+    xtract_simd_init();
 }
@@ -69,6 +69,7 @@ int(*xtract[])(const double *, const int, const void *, double *) =
     xtract_failsafe_f0,
     xtract_wavelet_f0,
     xtract_mcleod_f0,
+    xtract_yin_f0,
     xtract_midicent,
     /* xtract_delta.h */
     xtract_lnorm,
@@ -98,3 +99,26 @@ int(*xtract[])(const double *, const int, const void *, double *) =
     xtract_smoothed
 };
 
+
+int(*xtractf[XTRACT_FEATURES])(const float *, const int, const void *, float *) =
+{
+    /* xtract_scalar.h */
+    [XTRACT_MEAN] = xtractf_mean,
+    [XTRACT_VARIANCE] = xtractf_variance,
+    [XTRACT_STANDARD_DEVIATION] = xtractf_standard_deviation,
+    [XTRACT_AVERAGE_DEVIATION] = xtractf_average_deviation,
+    [XTRACT_SKEWNESS] = xtractf_skewness,
+    [XTRACT_KURTOSIS] = xtractf_kurtosis,
+    [XTRACT_ZCR] = xtractf_zcr,
+    [XTRACT_RMS_AMPLITUDE] = xtractf_rms_amplitude,
+    [XTRACT_LOWEST_VALUE] = xtractf_lowest_value,
+    [XTRACT_HIGHEST_VALUE] = xtractf_highest_value,
+    [XTRACT_SUM] = xtractf_sum,
+    /* xtract_vector.h */
+    [XTRACT_SPECTRUM] = xtractf_spectrum,
+    [XTRACT_MFCC] = xtractf_mfcc,
+    [XTRACT_DCT] = xtractf_dct,
+    [XTRACT_MEL_SPECTROGRAM] = xtractf_mel_spectrogram,
+    /* xtract_helper.h */
+    [XTRACT_WINDOWED] = xtractf_windowed
+};
@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* multichannel.c: features of interleaved multichannel blocks, computed with
+ * one channel in each SIMD lane */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_multichannel.h"
+#include "xtract_macros_private.h"
+#include "xtract_filterbank_private.h"
+#include "xtract_simd_private.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327
+#endif
+
+#define XTRACT_MULTICHANNEL_CHECK_SIZE \
+    if(N < 1 || channels < 1) \
+        return XTRACT_BAD_VECTOR_SIZE
+
+int xtract_multichannel_windowed(const double *data, const int N, const int channels, const void *argv, double *result)
+{
+    const double *window = (const double *)argv;
+    int n, c;
+
+    XTRACT_MULTICHANNEL_CHECK_SIZE;
+
+    for(n = 0; n < N; ++n, data += channels, result += channels)
+        for(c = 0; c < channels; ++c)
+            result[c] = data[c] * window[n];
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_multichannel_mean(const double *data, const int N, const int channels, const void *argv, double *result)
+{
+    int c;
+
+    XTRACT_MULTICHANNEL_CHECK_SIZE;
+
+    xtract_simd->channels_sum(data, N, channels, result);
+
+    for(c = 0; c < channels; ++c)
+        result[c] /= N;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_multichannel_variance(const double *data, const int N, const int channels, const void *argv, double *result)
+{
+    int c;
+
+    XTRACT_MULTICHANNEL_CHECK_SIZE;
+
+    xtract_simd->channels_sum_sq_dev(data, N, channels, (const double *)argv, result);
+
+    for(c = 0; c < channels; ++c)
+        result[c] /= N - 1;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_multichannel_rms_amplitude(const double *data, const int N, const int channels, const void *argv, double *result)
+{
+    int c;
+
+    XTRACT_MULTICHANNEL_CHECK_SIZE;
+
+    xtract_simd->channels_sum_sq_dev(data, N, channels, NULL, result);
+
+    for(c = 0; c < channels; ++c)
+        result[c] = sqrt(result[c] / (double)N);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_multichannel_zcr(const double *data, const int N, const int channels, const void *argv, double *result)
+{
+    int c;
+
+    XTRACT_MULTICHANNEL_CHECK_SIZE;
+
+    xtract_simd->channels_count_sign_changes(data, N, channels, result);
+
+    for(c = 0; c < channels; ++c)
+        result[c] /= N;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_multichannel_highest_value(const double *data, const int N, const int channels, const void *argv, double *result)
+{
+    XTRACT_MULTICHANNEL_CHECK_SIZE;
+
+    xtract_simd->channels_max(data, N, channels, result);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_multichannel_mel_spectrogram(const double *data, const int N, const int channels, const void *argv, double *result)
+{
+    const xtract_mel_filter *f = (const xtract_mel_filter *)argv;
+    const double *band;
+    int filter, start, length, c;
+
+    XTRACT_MULTICHANNEL_CHECK_SIZE;
+
+    for(filter = 0; filter < f->n_filters; ++filter, result += channels)
+    {
+        band = xtract_filter_band(f, filter, N, &start, &length);
+        xtract_simd->channels_weighted_sum(data + (size_t)start * channels, length, channels, band, result);
+
+        for(c = 0; c < channels; ++c)
+            result[c] = result[c] < XTRACT_LOG_LIMIT ? XTRACT_LOG_LIMIT_DB : log(result[c]);
+    }
+
+    return XTRACT_SUCCESS;
+}
+
+struct xtract_multichannel_fft_
+{
+    int N;
+    int channels;
+    int *reverse;       /* bit reversed index of each of the N / 2 complex points */
+    double *window;
+    double *tw;         /* twiddles, as described for the channels_rdft kernel */
+    double *re;         /* N / 2 + 1 rows of channels, bins 0 to N / 2 */
+    double *im;
+    double *max;        /* largest value of each channel, for normalisation */
+};
+
+xtract_multichannel_fft *xtract_multichannel_fft_new(int N, int channels, int window_type)
+{
+    xtract_multichannel_fft *fft;
+    int M = N >> 1;
+    int bits, m, b, j;
+
+    if(N < 2 || (N & (N - 1)) != 0 || channels < 1)
+    {
+        fprintf(stderr, "libxtract: error: xtract_multichannel_fft_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    fft = calloc(1, sizeof(xtract_multichannel_fft));
+
+    if(fft == NULL)
+    {
+        perror("could not allocate memory for xtract_multichannel_fft");
+        return NULL;
+    }
+
+    fft->N = N;
+    fft->channels = channels;
+    fft->reverse = malloc(M * sizeof(int));
+    fft->window = xtract_init_window(N, window_type);
+    fft->tw = malloc((2 * (M / 2) + 2 * (M / 2 + 1)) * sizeof(double));
+    fft->re = malloc((size_t)(M + 1) * channels * sizeof(double));
+    fft->im = malloc((size_t)(M + 1) * channels * sizeof(double));
+    fft->max = malloc(channels * sizeof(double));
+
+    if(fft->reverse == NULL || fft->window == NULL || fft->tw == NULL ||
+            fft->re == NULL || fft->im == NULL || fft->max == NULL)
+    {
+        perror("could not allocate memory for xtract_multichannel_fft");
+        xtract_multichannel_fft_delete(fft);
+        return NULL;
+    }
+
+    for(bits = 0; (1 << bits) < M; ++bits)
+        ;
+
+    for(m = 0; m < M; ++m)
+    {
+        for(b = 0, fft->reverse[m] = 0; b < bits; ++b)
+            fft->reverse[m] |= ((m >> b) & 1) << (bits - 1 - b);
+    }
+
+    for(j = 0; j < M / 2; ++j)
+    {
+        fft->tw[j] = cos(2.0 * M_PI * j / M);
+        fft->tw[M / 2 + j] = -sin(2.0 * M_PI * j / M);
+    }
+
+    for(j = 0; j <= M / 2; ++j)
+    {
+        fft->tw[2 * (M / 2) + j] = cos(2.0 * M_PI * j / N);
+        fft->tw[2 * (M / 2) + M / 2 + 1 + j] = -sin(2.0 * M_PI * j / N);
+    }
+
+    return fft;
+}
+
+void xtract_multichannel_fft_delete(xtract_multichannel_fft *fft)
+{
+    if(fft == NULL)
+        return;
+
+    xtract_free_window(fft->window);
+    free(fft->reverse);
+    free(fft->tw);
+    free(fft->re);
+    free(fft->im);
+    free(fft->max);
+    free(fft);
+}
+
+/* Run STORE for output bin m of every channel c, with re and im pointing to
+ * the row of bin n, as XTRACT_SPECTRUM_BINS() does for a single channel */
+#define XTRACT_MULTICHANNEL_BINS(STORE) \
+    for(m = 0; m < M; ++m) \
+    { \
+        n = m + offset; \
+        re = fft->re + (size_t)n * C; \
+        im = fft->im + (size_t)n * C; \
+        for(c = 0; c < C; ++c) \
+        { \
+            STORE; \
+        } \
+    }
+
+#define XTRACT_MULTICHANNEL_VALUE(VALUE) \
+    XTRACT_MULTICHANNEL_BINS( \
+        temp = XTRACT_SQ(re[c]) + XTRACT_SQ(im[c]); \
+        result[(size_t)m * C + c] = (VALUE); \
+        max[c] = result[(size_t)m * C + c] > max[c] ? result[(size_t)m * C + c] : max[c])
+
+int xtract_multichannel_spectrum(xtract_multichannel_fft *fft, const double *data, const int N, const void *argv, double *result)
+{
+    const int C = fft->channels;
+    const int M = N >> 1;
+    const double *w = fft->window;
+    const double *even, *odd, *re, *im;
+    double *max = fft->max;
+    double *row_re, *row_im;
+    double NxN = XTRACT_SQ((double)N);
+    double q, temp;
+    int vector, withDC, normalise, offset;
+    int n, m, c;
+
+    if(N != fft->N)
+        return XTRACT_BAD_VECTOR_SIZE;
+
+    q = *(double *)argv;
+    vector = (int)*((double *)argv+1);
+    withDC = (int)*((double *)argv+2);
+    normalise = (int)*((double *)argv+3);
+    offset = withDC ? 0 : 1; /* discard DC and keep Nyquist unless withDC */
+
+    XTRACT_CHECK_q;
+
+    /* Window the even and odd samples into the real and imaginary parts of
+     * the complex points, in bit reversed order */
+    for(m = 0; m < M; ++m)
+    {
+        even = data + (size_t)2 * m * C;
+        odd = even + C;
+        row_re = fft->re + (size_t)fft->reverse[m] * C;
+        row_im = fft->im + (size_t)fft->reverse[m] * C;
+
+        for(c = 0; c < C; ++c)
+        {
+            row_re[c] = even[c] * w[2 * m];
+            row_im[c] = odd[c] * w[2 * m + 1];
+        }
+    }
+
+    xtract_simd->channels_rdft(fft->re, fft->im, M, C, fft->tw);
+
+    for(c = 0; c < C; ++c)
+        max[c] = 0.0;
+
+    switch(vector)
+    {
+
+    case XTRACT_LOG_MAGNITUDE_SPECTRUM:
+        XTRACT_MULTICHANNEL_VALUE(
+            ((temp > XTRACT_LOG_LIMIT ? log(sqrt(temp) / (double)N) : XTRACT_LOG_LIMIT_DB)
+                + XTRACT_DB_SCALE_OFFSET) / XTRACT_DB_SCALE_OFFSET);
+        break;
+
+    case XTRACT_POWER_SPECTRUM:
+        XTRACT_MULTICHANNEL_VALUE(temp / NxN);
+        break;
+
+    case XTRACT_LOG_POWER_SPECTRUM:
+        XTRACT_MULTICHANNEL_VALUE(
+            ((temp > XTRACT_LOG_LIMIT ? log(temp / NxN) : XTRACT_LOG_LIMIT_DB)
+                + XTRACT_DB_SCALE_OFFSET) / XTRACT_DB_SCALE_OFFSET);
+        break;
+
+    case XTRACT_SPECTRUM_COEFFICIENTS:
+        /* The FFT backends give the conjugate bins, so the sign of the
+         * imaginary part is flipped to match xtract_spectrum() */
+        XTRACT_MULTICHANNEL_BINS(
+            result[(size_t)2 * m * C + c] = re[c];
+            result[(size_t)(2 * m + 1) * C + c] = -im[c]);
+        for(m = 0; m < M; ++m)
+            for(c = 0; c < C; ++c)
+                max[c] = result[(size_t)m * C + c] > max[c] ? result[(size_t)m * C + c] : max[c];
+        break;
+
+    default:
+        /* MAGNITUDE_SPECTRUM */
+        XTRACT_MULTICHANNEL_VALUE(sqrt(temp) / (double)N);
+        break;
+    }
+
+    if(vector != XTRACT_SPECTRUM_COEFFICIENTS)
+    {
+        for(m = 0; m < M; ++m)
+            for(c = 0; c < C; ++c)
+                result[(size_t)(M + m) * C + c] = (m + offset) * q;
+    }
+
+    if(!normalise)
+        return XTRACT_SUCCESS;
+
+    if(vector == XTRACT_SPECTRUM_COEFFICIENTS)
+    {
+        /* Interleaved formats: find true max magnitude, then scale both components */
+        for(c = 0; c < C; ++c)
+        {
+            if(max[c] == 0.0)
+                continue;
+
+            for(m = 0, max[c] = 0.0; m < M; ++m)
+            {
+                temp = sqrt(XTRACT_SQ(result[(size_t)2 * m * C + c]) + XTRACT_SQ(result[(size_t)(2 * m + 1) * C + c]));
+                if(temp > max[c]) max[c] = temp;
+            }
+
+            if(max[c] != 0.0)
+            {
+                for(m = 0; m < 2 * M; ++m)
+                    result[(size_t)m * C + c] /= max[c];
+            }
+        }
+    }
+    else
+    {
+        for(c = 0; c < C; ++c)
+            max[c] = max[c] != 0.0 ? max[c] : 1.0;
+
+        for(m = 0; m < M; ++m)
+            for(c = 0; c < C; ++c)
+                result[(size_t)m * C + c] /= max[c];
+    }
+
+    return XTRACT_SUCCESS;
+}
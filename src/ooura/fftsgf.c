@@ -0,0 +1,53 @@
+/*
+ * Single precision build of fftsg.c
+ *
+ * The routines are compiled a second time with float in place of double and
+ * an 'f' suffix on every external name, so that both precisions can be linked
+ * into the same library.
+ */
+
+#include <math.h>
+
+#define cdft cdftf
+#define rdft rdftf
+#define ddct ddctf
+#define ddst ddstf
+#define dfct dfctf
+#define dfst dfstf
+#define makewt makewtf
+#define makeipt makeiptf
+#define makect makectf
+#define cftfsub cftfsubf
+#define cftbsub cftbsubf
+#define bitrv2 bitrv2f
+#define bitrv2conj bitrv2conjf
+#define bitrv216 bitrv216f
+#define bitrv216neg bitrv216negf
+#define bitrv208 bitrv208f
+#define bitrv208neg bitrv208negf
+#define cftf1st cftf1stf
+#define cftb1st cftb1stf
+#define cftrec4_th cftrec4_thf
+#define cftrec1_th cftrec1_thf
+#define cftrec2_th cftrec2_thf
+#define cftrec4 cftrec4f
+#define cfttree cfttreef
+#define cftleaf cftleaff
+#define cftmdl1 cftmdl1f
+#define cftmdl2 cftmdl2f
+#define cftfx41 cftfx41f
+#define cftf161 cftf161f
+#define cftf162 cftf162f
+#define cftf081 cftf081f
+#define cftf082 cftf082f
+#define cftf040 cftf040f
+#define cftb040 cftb040f
+#define cftx020 cftx020f
+#define rftfsub rftfsubf
+#define rftbsub rftbsubf
+#define dctsub dctsubf
+#define dstsub dstsubf
+
+#define double float
+
+#include "fftsg.c"
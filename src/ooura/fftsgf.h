@@ -0,0 +1,11 @@
+/* Single precision FFT functions, see fftsgf.c */
+void cdftf(int n, int isgn, float *a, int *ip, float *w);
+void rdftf(int n, int isgn, float *a, int *ip, float *w);
+void ddctf(int n, int isgn, float *a, int *ip, float *w);
+void ddstf(int n, int isgn, float *a, int *ip, float *w);
+void dfctf(int n, float *a, float *t, int *ip, float *w);
+void dfstf(int n, float *a, float *t, int *ip, float *w);
+
+/* Auxiliary functions */
+void makewtf(int nw, int *ip, float *w);
+void makectf(int nc, int *ip, float *c);
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* pipeline.c: runs reading, transforming and feature extraction as stages
+ * on separate threads, connected by lock-free queues */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_pipeline.h"
+#include "xtract_threads_private.h"
+
+/* A bounded single producer, single consumer queue of slots of stride
+ * doubles. head is only written by the producer and tail by the consumer,
+ * so each side needs just an atomic load of the other's counter */
+typedef struct xtract_pipeline_queue_
+{
+    double *slots;
+    int *counts;                /* elements in each slot, 0 for the end of the stream */
+    int capacity;
+    int stride;
+    xtract_atomic head;         /* slots filled */
+    xtract_atomic tail;         /* slots emptied */
+
+    /* Written by the producer */
+    long pushes;
+    long full_waits;
+    long depth_sum;
+    int max_depth;
+
+    /* Written by the consumer */
+    long empty_waits;
+} xtract_pipeline_queue;
+
+struct xtract_pipeline_
+{
+    int N;
+    int hop;
+    double spectrum_argv[4];
+    xtract_stft_stream *stream;
+    xtract_plan *plan;
+    xtract_pipeline_queue queues[XTRACT_PIPELINE_QUEUES];
+
+    /* Set by xtract_pipeline_run() */
+    xtract_pipeline_read_fn read;
+    void *user;
+    xtract_atomic stop;                 /* set to end the stream early */
+    int transform_status;
+};
+
+static int queue_init(xtract_pipeline_queue *queue, int capacity, int stride)
+{
+    memset(queue, 0, sizeof(xtract_pipeline_queue));
+    queue->capacity = capacity;
+    queue->stride = stride;
+    queue->slots = malloc((size_t)capacity * stride * sizeof(double));
+    queue->counts = malloc(capacity * sizeof(int));
+
+    return queue->slots != NULL && queue->counts != NULL;
+}
+
+static void queue_reset(xtract_pipeline_queue *queue)
+{
+    queue->head = queue->tail = 0;
+    queue->pushes = queue->full_waits = queue->depth_sum = queue->empty_waits = 0;
+    queue->max_depth = 0;
+}
+
+/* The slot to fill next, once there is a free one */
+static double *queue_reserve(xtract_pipeline_queue *queue)
+{
+    long head = queue->head;
+
+    if(head - xtract_atomic_load(&queue->tail) == queue->capacity)
+    {
+        ++queue->full_waits;
+
+        while(head - xtract_atomic_load(&queue->tail) == queue->capacity)
+            xtract_thread_yield();
+    }
+
+    return queue->slots + (size_t)(head % queue->capacity) * queue->stride;
+}
+
+/* Hand the reserved slot, holding count elements, to the consumer */
+static void queue_push(xtract_pipeline_queue *queue, int count)
+{
+    long head = queue->head;
+    int depth = (int)(head + 1 - xtract_atomic_load(&queue->tail));
+
+    queue->counts[head % queue->capacity] = count;
+    ++queue->pushes;
+    queue->depth_sum += depth;
+
+    if(depth > queue->max_depth)
+        queue->max_depth = depth;
+
+    xtract_atomic_store(&queue->head, head + 1);
+}
+
+/* The oldest filled slot, once there is one */
+static const double *queue_front(xtract_pipeline_queue *queue, int *count)
+{
+    long tail = queue->tail;
+
+    if(xtract_atomic_load(&queue->head) == tail)
+    {
+        ++queue->empty_waits;
+
+        while(xtract_atomic_load(&queue->head) == tail)
+            xtract_thread_yield();
+    }
+
+    *count = queue->counts[tail % queue->capacity];
+
+    return queue->slots + (size_t)(tail % queue->capacity) * queue->stride;
+}
+
+/* Give the oldest slot back to the producer */
+static void queue_pop(xtract_pipeline_queue *queue)
+{
+    xtract_atomic_store(&queue->tail, queue->tail + 1);
+}
+
+xtract_pipeline *xtract_pipeline_new(const xtract_plan *plan, int hop, int window_type, const double *spectrum_argv, int depth)
+{
+    xtract_pipeline *pipeline;
+    int N = xtract_plan_get_N(plan);
+    int q;
+
+    if(xtract_plan_get_input(plan) != XTRACT_SPECTRAL || hop < 1 || hop > N || depth < 1 || spectrum_argv == NULL)
+    {
+        fprintf(stderr, "libxtract: error: xtract_pipeline_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    pipeline = calloc(1, sizeof(xtract_pipeline));
+
+    if(pipeline == NULL)
+    {
+        perror("could not allocate memory for xtract_pipeline");
+        return NULL;
+    }
+
+    pipeline->N = N;
+    pipeline->hop = hop;
+    memcpy(pipeline->spectrum_argv, spectrum_argv, sizeof(pipeline->spectrum_argv));
+    pipeline->stream = xtract_stft_stream_new(N, hop, window_type);
+    pipeline->plan = xtract_plan_copy(plan);
+
+    if(pipeline->stream == NULL || pipeline->plan == NULL
+       || !queue_init(&pipeline->queues[XTRACT_PIPELINE_SAMPLES], depth, hop)
+       || !queue_init(&pipeline->queues[XTRACT_PIPELINE_SPECTRA], depth, N))
+    {
+        perror("could not allocate memory for xtract_pipeline");
+        xtract_pipeline_delete(pipeline);
+        return NULL;
+    }
+
+    for(q = 0; q < XTRACT_PIPELINE_QUEUES; ++q)
+        queue_reset(&pipeline->queues[q]);
+
+    return pipeline;
+}
+
+void xtract_pipeline_delete(xtract_pipeline *pipeline)
+{
+    int q;
+
+    if(pipeline == NULL)
+        return;
+
+    for(q = 0; q < XTRACT_PIPELINE_QUEUES; ++q)
+    {
+        free(pipeline->queues[q].slots);
+        free(pipeline->queues[q].counts);
+    }
+
+    xtract_stft_stream_delete(pipeline->stream);
+    xtract_plan_delete(pipeline->plan);
+    free(pipeline);
+}
+
+/* Stop the reader and take its samples until it has pushed the end of the
+ * stream, so that it can finish */
+static void pipeline_stop_reader(xtract_pipeline *pipeline)
+{
+    xtract_pipeline_queue *samples = &pipeline->queues[XTRACT_PIPELINE_SAMPLES];
+    int n;
+
+    xtract_atomic_store(&pipeline->stop, 1);
+
+    do
+    {
+        queue_front(samples, &n);
+        queue_pop(samples);
+    }
+    while(n > 0);
+}
+
+static XTRACT_THREAD_FN(pipeline_read, arg)
+{
+    xtract_pipeline *pipeline = arg;
+    xtract_pipeline_queue *samples = &pipeline->queues[XTRACT_PIPELINE_SAMPLES];
+    double *slot;
+    int n;
+
+    do
+    {
+        slot = queue_reserve(samples);
+        n = xtract_atomic_load(&pipeline->stop) ? 0 : pipeline->read(pipeline->user, slot, pipeline->hop);
+
+        if(n < 0)
+            n = 0;
+        else if(n > pipeline->hop)
+            n = pipeline->hop;
+
+        queue_push(samples, n);
+    }
+    while(n > 0);
+
+    return XTRACT_THREAD_RETURN;
+}
+
+static XTRACT_THREAD_FN(pipeline_transform, arg)
+{
+    xtract_pipeline *pipeline = arg;
+    xtract_pipeline_queue *samples = &pipeline->queues[XTRACT_PIPELINE_SAMPLES];
+    xtract_pipeline_queue *spectra = &pipeline->queues[XTRACT_PIPELINE_SPECTRA];
+    const double *block;
+    double *spectrum;
+    int n, rv;
+
+    pipeline->transform_status = XTRACT_SUCCESS;
+
+    do
+    {
+        block = queue_front(samples, &n);
+
+        /* A block is at most hop samples, which always fit once the
+         * frames before them have been taken */
+        xtract_stft_stream_write(pipeline->stream, block, n);
+        queue_pop(samples);
+
+        for(;;)
+        {
+            spectrum = queue_reserve(spectra);
+            rv = xtract_stft_stream_spectrum(pipeline->stream, pipeline->spectrum_argv, spectrum);
+
+            if(rv == XTRACT_NO_RESULT)
+                break;
+
+            /* The stream may not have moved past the frame, and the slot
+             * wasn't filled, so end the stream here rather than push it */
+            if(rv != XTRACT_SUCCESS)
+            {
+                pipeline->transform_status = rv;
+
+                if(n > 0)
+                    pipeline_stop_reader(pipeline);
+
+                n = 0;
+                break;
+            }
+
+            queue_push(spectra, pipeline->N);
+        }
+    }
+    while(n > 0);
+
+    queue_reserve(spectra);
+    queue_push(spectra, 0);
+
+    return XTRACT_THREAD_RETURN;
+}
+
+int xtract_pipeline_run(xtract_pipeline *pipeline, xtract_pipeline_read_fn read, xtract_pipeline_frame_fn frame, void *user)
+{
+    xtract_pipeline_queue *spectra = &pipeline->queues[XTRACT_PIPELINE_SPECTRA];
+    xtract_thread reader, transformer;
+    const double *spectrum;
+    int q, n, rv, frames = 0;
+    int status = XTRACT_SUCCESS;
+
+    pipeline->read = read;
+    pipeline->user = user;
+    pipeline->stop = 0;
+    xtract_stft_stream_reset(pipeline->stream);
+
+    for(q = 0; q < XTRACT_PIPELINE_QUEUES; ++q)
+        queue_reset(&pipeline->queues[q]);
+
+    if(xtract_thread_create(&reader, pipeline_read, pipeline) != 0)
+        return XTRACT_MALLOC_FAILED;
+
+    if(xtract_thread_create(&transformer, pipeline_transform, pipeline) != 0)
+    {
+        pipeline_stop_reader(pipeline);
+        xtract_thread_join(reader);
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    for(;;)
+    {
+        spectrum = queue_front(spectra, &n);
+
+        if(n == 0)
+            break;
+
+        rv = xtract_plan_compute(pipeline->plan, spectrum);
+        queue_pop(spectra);
+
+        if(rv != XTRACT_SUCCESS && status == XTRACT_SUCCESS)
+            status = rv;
+
+        frame(user, frames++, pipeline->plan);
+    }
+
+    xtract_thread_join(reader);
+    xtract_thread_join(transformer);
+
+    if(pipeline->transform_status != XTRACT_SUCCESS)
+        status = pipeline->transform_status;
+
+    return status;
+}
+
+int xtract_pipeline_get_stats(const xtract_pipeline *pipeline, int queue, xtract_pipeline_stats *stats)
+{
+    const xtract_pipeline_queue *q;
+
+    if(queue < 0 || queue >= XTRACT_PIPELINE_QUEUES)
+        return XTRACT_BAD_ARGV;
+
+    q = &pipeline->queues[queue];
+    stats->capacity = q->capacity;
+    stats->max_depth = q->max_depth;
+    stats->mean_depth = q->pushes > 0 ? (double)q->depth_sum / q->pushes : 0.0;
+    stats->pushes = q->pushes;
+    stats->full_waits = q->full_waits;
+    stats->empty_waits = q->empty_waits;
+
+    return XTRACT_SUCCESS;
+}
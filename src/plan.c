@@ -0,0 +1,539 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* plan.c: compiles a set of features into a program ordered by their
+ * descriptors' data formats and argument donors */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_plan.h"
+#include "xtract_macros_private.h"
+
+/* Sources of a node's data other than the result of another node */
+#define XTRACT_PLAN_INPUT   -1
+#define XTRACT_PLAN_NO_DATA -2
+
+typedef int (*xtract_plan_fn)(const double *data, const int N, const void *argv, double *result);
+typedef int (*xtract_plan_ctx_fn)(xtract_context *ctx, const double *data, const int N, const void *argv, double *result);
+
+/* One step of the program: a feature computed from a particular source */
+typedef struct xtract_plan_node_
+{
+    int feature;
+    int source;                         /* node whose result is the data, or XTRACT_PLAN_INPUT or XTRACT_PLAN_NO_DATA */
+    int N;                              /* number of elements of data */
+    int size;                           /* number of elements of result */
+    xtract_plan_fn fn;
+    xtract_plan_ctx_fn ctx_fn;          /* used instead of fn if not NULL */
+    double args[XTRACT_MAXARGS];
+    int uses_args;                      /* argv points to args once the plan is compiled */
+    const void *argv;                   /* the pointer given to xtract_plan_add(), args, or NULL */
+    int donors;                         /* number of arguments filled from other nodes */
+    int donor_arg[XTRACT_MAXARGS];
+    int donor_node[XTRACT_MAXARGS];
+    double *result;
+} xtract_plan_node;
+
+struct xtract_plan_
+{
+    int N;
+    int input;                          /* XTRACT_AUDIO_SAMPLES or XTRACT_SPECTRAL */
+    int compiled;
+
+    /* Set by xtract_plan_add() */
+    char requested[XTRACT_FEATURES];
+    char configured[XTRACT_FEATURES];
+    const void *argv[XTRACT_FEATURES];
+
+    /* Set by xtract_plan_compile(), in the order they are computed */
+    xtract_plan_node *nodes;
+    int n_nodes;
+    int max_nodes;
+    int outputs[XTRACT_FEATURES];       /* node of each requested feature */
+    double *results;
+
+    xtract_context *ctx;
+};
+
+xtract_plan *xtract_plan_new(int N)
+{
+    xtract_plan *plan;
+    int f;
+
+    if(N < 2)
+    {
+        fprintf(stderr, "libxtract: error: xtract_plan_new(): invalid frame size\n");
+        return NULL;
+    }
+
+    plan = calloc(1, sizeof(xtract_plan));
+
+    if(plan == NULL)
+    {
+        perror("could not allocate memory for xtract_plan");
+        return NULL;
+    }
+
+    plan->N = N;
+    plan->input = XTRACT_AUDIO_SAMPLES;
+
+    for(f = 0; f < XTRACT_FEATURES; ++f)
+        plan->outputs[f] = -1;
+
+    return plan;
+}
+
+void xtract_plan_delete(xtract_plan *plan)
+{
+    if(plan == NULL)
+        return;
+
+    xtract_context_delete(plan->ctx);
+    free(plan->nodes);
+    free(plan->results);
+    free(plan);
+}
+
+int xtract_plan_set_input(xtract_plan *plan, int format)
+{
+    if(plan->compiled || (format != XTRACT_AUDIO_SAMPLES && format != XTRACT_SPECTRAL))
+        return XTRACT_BAD_ARGV;
+
+    plan->input = format;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_plan_get_input(const xtract_plan *plan)
+{
+    return plan->input;
+}
+
+int xtract_plan_get_N(const xtract_plan *plan)
+{
+    return plan->N;
+}
+
+int xtract_plan_add(xtract_plan *plan, int feature, const void *argv)
+{
+    if(feature < 0 || feature >= XTRACT_FEATURES || plan->compiled)
+        return XTRACT_BAD_ARGV;
+
+    plan->requested[feature] = 1;
+
+    if(argv != NULL)
+    {
+        plan->configured[feature] = 1;
+        plan->argv[feature] = argv;
+    }
+
+    return XTRACT_SUCCESS;
+}
+
+/* The variants that keep their FFT plans and tracking state in a context,
+ * for the features that have one with the same argv */
+static xtract_plan_ctx_fn plan_ctx_fn(int feature)
+{
+    switch(feature)
+    {
+    case XTRACT_SPECTRUM:
+        return xtract_spectrum_ctx;
+    case XTRACT_AUTOCORRELATION_FFT:
+        return xtract_autocorrelation_fft_ctx;
+    case XTRACT_DCT:
+        return xtract_dct_ctx;
+    case XTRACT_MFCC:
+        return xtract_mfcc_ctx;
+    case XTRACT_GFCC:
+        return xtract_gfcc_ctx;
+    case XTRACT_FAILSAFE_F0:
+        return xtract_failsafe_f0_ctx;
+    case XTRACT_WAVELET_F0:
+        return xtract_wavelet_f0_ctx;
+    case XTRACT_MCLEOD_F0:
+        /* args[1] is 0, which searches every lag as xtract_mcleod_f0() does */
+        return xtract_mcleod_f0_ctx;
+    case XTRACT_YIN_F0:
+        /* args[1] is 0, which selects the default threshold */
+        return xtract_yin_f0_ctx;
+    default:
+        return NULL;
+    }
+}
+
+/* The number of elements a feature writes to result for N elements of data */
+static int plan_result_size(const xtract_function_descriptor_t *d, int N, const void *argv)
+{
+    if(d->is_scalar)
+        return 1;
+
+    switch(d->id)
+    {
+    case XTRACT_PEAK_SPECTRUM:
+        return N * 2;
+    case XTRACT_MFCC:
+    case XTRACT_GFCC:
+    case XTRACT_MEL_SPECTROGRAM:
+    case XTRACT_GAMMATONE_SPECTROGRAM:
+        return ((const xtract_mel_filter *)argv)->n_filters;
+    case XTRACT_BARK_COEFFICIENTS:
+        return XTRACT_BARK_BANDS;
+    case XTRACT_SUBBANDS:
+        return ((const int *)argv)[1];
+    case XTRACT_LPC:
+        return (N - 1) * 2;
+    default:
+        return N;
+    }
+}
+
+/* Return the index of the node computing feature, adding it and everything
+ * it depends on first if it isn't in the plan yet. source and N give the
+ * data for a feature that reads an arbitrary series. Returns minus an error
+ * code on failure */
+static int plan_node(xtract_plan *plan, int feature, int source, int N, int depth)
+{
+    const xtract_function_descriptor_t *d = xtract_get_descriptor(feature);
+    xtract_plan_node node, *grown;
+    int producer = -1, magnitudes = 0, donor, i;
+
+    if(depth > XTRACT_FEATURES)
+    {
+        fprintf(stderr, "libxtract: error: xtract_plan_compile(): %s depends on itself\n", d->algo.name);
+        return -XTRACT_BAD_ARGV;
+    }
+
+    if(d->is_delta)
+    {
+        fprintf(stderr, "libxtract: error: xtract_plan_compile(): %s compares two vectors and can't be planned\n", d->algo.name);
+        return -XTRACT_FEATURE_NOT_IMPLEMENTED;
+    }
+
+    /* Find the data, adding the feature that produces it if needed */
+    switch(d->data.format)
+    {
+    case XTRACT_ARBITRARY_SERIES:
+        break;
+    case XTRACT_AUDIO_SAMPLES:
+        if(plan->input != XTRACT_AUDIO_SAMPLES)
+        {
+            fprintf(stderr, "libxtract: error: xtract_plan_compile(): %s reads audio samples, but the plan's input is a spectrum\n", d->algo.name);
+            return -XTRACT_FEATURE_NOT_IMPLEMENTED;
+        }
+        source = XTRACT_PLAN_INPUT;
+        N = plan->N;
+        break;
+    case XTRACT_NO_DATA:
+        source = XTRACT_PLAN_NO_DATA;
+        N = 0;
+        break;
+    case XTRACT_SPECTRAL_MAGNITUDES:
+        magnitudes = 1;
+        /* fall through */
+    case XTRACT_SPECTRAL:
+        producer = XTRACT_SPECTRUM;
+        break;
+    case XTRACT_SPECTRAL_PEAKS_MAGNITUDES:
+        magnitudes = 1;
+        /* fall through */
+    case XTRACT_SPECTRAL_PEAKS:
+        producer = XTRACT_PEAK_SPECTRUM;
+        break;
+    case XTRACT_SPECTRAL_HARMONICS_MAGNITUDES:
+        magnitudes = 1;
+        /* fall through */
+    case XTRACT_SPECTRAL_HARMONICS:
+        producer = XTRACT_HARMONIC_SPECTRUM;
+        break;
+    case XTRACT_AUTOCORRELATION_COEFFS:
+        producer = XTRACT_AUTOCORRELATION;
+        break;
+    case XTRACT_BARK_COEFFS:
+        producer = XTRACT_BARK_COEFFICIENTS;
+        break;
+    default:
+        fprintf(stderr, "libxtract: error: xtract_plan_compile(): the input of %s can't be produced by a plan\n", d->algo.name);
+        return -XTRACT_FEATURE_NOT_IMPLEMENTED;
+    }
+
+    if(producer == XTRACT_SPECTRUM && plan->input == XTRACT_SPECTRAL)
+    {
+        source = XTRACT_PLAN_INPUT;
+        N = magnitudes ? plan->N >> 1 : plan->N;
+    }
+    else if(producer >= 0)
+    {
+        source = plan_node(plan, producer, XTRACT_PLAN_INPUT, plan->N, depth + 1);
+        if(source < 0)
+            return source;
+        /* Magnitudes are the first half of an [amps | freqs] result */
+        N = magnitudes ? plan->nodes[source].size >> 1 : plan->nodes[source].size;
+    }
+
+    for(i = 0; i < plan->n_nodes; ++i)
+    {
+        if(plan->nodes[i].feature == feature && plan->nodes[i].source == source && plan->nodes[i].N == N)
+            return i;
+    }
+
+    memset(&node, 0, sizeof(node));
+    node.feature = feature;
+    node.source = source;
+    node.N = N;
+    node.fn = xtract[feature];
+    node.ctx_fn = plan_ctx_fn(feature);
+
+    if(d->argc > 0 && d->argc <= XTRACT_MAXARGS && d->argv.type == XTRACT_FLOAT)
+    {
+        node.uses_args = 1;
+
+        for(i = 0; i < d->argc; ++i)
+        {
+            node.args[i] = plan->configured[feature] ? ((const double *)plan->argv[feature])[i] : d->argv.def[i];
+
+            /* The default bin width of a spectrum, or of the spectrum rolloff
+             * reads, is for 1024 point frames rather than the plan's */
+            if(!plan->configured[feature] && i == 0 && (feature == XTRACT_SPECTRUM || feature == XTRACT_ROLLOFF))
+                node.args[i] = XTRACT_SR_DEFAULT / plan->N;
+
+            donor = d->argv.donor[i];
+
+            if(donor < 0 || donor >= XTRACT_FEATURES || !xtract_get_descriptor(donor)->is_scalar)
+                continue;
+
+            /* A donor reading an arbitrary series reads the same data */
+            donor = plan_node(plan, donor, source, N, depth + 1);
+            if(donor < 0)
+                return donor;
+            node.donor_arg[node.donors] = i;
+            node.donor_node[node.donors] = donor;
+            ++node.donors;
+        }
+    }
+    else if(d->argc > 0)
+    {
+        if(!plan->configured[feature])
+        {
+            fprintf(stderr, "libxtract: error: xtract_plan_compile(): %s needs argv to be given to xtract_plan_add()\n", d->algo.name);
+            return -XTRACT_BAD_ARGV;
+        }
+        node.argv = plan->argv[feature];
+    }
+
+    node.size = plan_result_size(d, N, node.argv);
+
+    if(plan->n_nodes == plan->max_nodes)
+    {
+        plan->max_nodes = plan->max_nodes ? plan->max_nodes * 2 : 16;
+        grown = realloc(plan->nodes, plan->max_nodes * sizeof(xtract_plan_node));
+        if(grown == NULL)
+        {
+            perror("could not allocate memory for xtract_plan");
+            return -XTRACT_MALLOC_FAILED;
+        }
+        plan->nodes = grown;
+    }
+
+    plan->nodes[plan->n_nodes] = node;
+
+    return plan->n_nodes++;
+}
+
+/* Give every node of a planned program its result slot and FFT plans */
+static int plan_allocate(xtract_plan *plan)
+{
+    size_t total = 0;
+    int i, rv = XTRACT_SUCCESS;
+
+    if(plan->ctx == NULL)
+        plan->ctx = xtract_context_new();
+
+    if(plan->ctx == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    for(i = 0; i < plan->n_nodes; ++i)
+        total += plan->nodes[i].size;
+
+    plan->results = calloc(total > 0 ? total : 1, sizeof(double));
+
+    if(plan->results == NULL)
+    {
+        perror("could not allocate memory for xtract_plan");
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    for(i = 0, total = 0; i < plan->n_nodes; ++i)
+    {
+        plan->nodes[i].result = plan->results + total;
+        total += plan->nodes[i].size;
+
+        /* The nodes don't move once every one has been added */
+        if(plan->nodes[i].uses_args)
+            plan->nodes[i].argv = plan->nodes[i].args;
+
+        if(plan->nodes[i].feature == XTRACT_SPECTRUM || plan->nodes[i].feature == XTRACT_FAILSAFE_F0)
+            rv = xtract_context_init_fft(plan->ctx, plan->N, XTRACT_SPECTRUM);
+        else if(plan->nodes[i].feature == XTRACT_AUTOCORRELATION_FFT)
+            rv = xtract_context_init_fft(plan->ctx, plan->N, XTRACT_AUTOCORRELATION_FFT);
+
+        if(rv != XTRACT_SUCCESS)
+            return rv;
+    }
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_plan_compile(xtract_plan *plan)
+{
+    int f, node;
+    int rv = XTRACT_SUCCESS;
+
+    if(plan->compiled)
+        return XTRACT_SUCCESS;
+
+    /* Depth first, so every node follows the nodes it depends on */
+    for(f = 0; f < XTRACT_FEATURES && rv == XTRACT_SUCCESS; ++f)
+    {
+        if(!plan->requested[f])
+            continue;
+
+        node = plan_node(plan, f, XTRACT_PLAN_INPUT, plan->N, 0);
+
+        if(node < 0)
+            rv = -node;
+        else
+            plan->outputs[f] = node;
+    }
+
+    if(rv != XTRACT_SUCCESS)
+    {
+        /* Leave the plan as it was so that it can be fixed and recompiled */
+        plan->n_nodes = 0;
+        for(f = 0; f < XTRACT_FEATURES; ++f)
+            plan->outputs[f] = -1;
+        return rv;
+    }
+
+    rv = plan_allocate(plan);
+
+    if(rv != XTRACT_SUCCESS)
+        return rv;
+
+    plan->compiled = 1;
+
+    return XTRACT_SUCCESS;
+}
+
+xtract_plan *xtract_plan_copy(const xtract_plan *plan)
+{
+    xtract_plan *copy;
+
+    if(!plan->compiled)
+    {
+        fprintf(stderr, "libxtract: error: xtract_plan_copy(): plan has not been compiled\n");
+        return NULL;
+    }
+
+    copy = xtract_plan_new(plan->N);
+
+    if(copy == NULL)
+        return NULL;
+
+    copy->input = plan->input;
+    memcpy(copy->requested, plan->requested, sizeof(plan->requested));
+    memcpy(copy->configured, plan->configured, sizeof(plan->configured));
+    memcpy(copy->argv, plan->argv, sizeof(plan->argv));
+    memcpy(copy->outputs, plan->outputs, sizeof(plan->outputs));
+
+    copy->nodes = malloc(plan->n_nodes * sizeof(xtract_plan_node));
+
+    if(copy->nodes == NULL)
+    {
+        perror("could not allocate memory for xtract_plan");
+        xtract_plan_delete(copy);
+        return NULL;
+    }
+
+    memcpy(copy->nodes, plan->nodes, plan->n_nodes * sizeof(xtract_plan_node));
+    copy->n_nodes = copy->max_nodes = plan->n_nodes;
+
+    if(plan_allocate(copy) != XTRACT_SUCCESS)
+    {
+        xtract_plan_delete(copy);
+        return NULL;
+    }
+
+    copy->compiled = 1;
+
+    return copy;
+}
+
+int xtract_plan_compute(xtract_plan *plan, const double *data)
+{
+    xtract_plan_node *node = plan->nodes;
+    const xtract_plan_node *end = plan->nodes + plan->n_nodes;
+    const double *input;
+    int i, rv, status = XTRACT_SUCCESS;
+
+    if(!plan->compiled)
+        return XTRACT_BAD_STATE;
+
+    for(; node < end; ++node)
+    {
+        for(i = 0; i < node->donors; ++i)
+            node->args[node->donor_arg[i]] = plan->nodes[node->donor_node[i]].result[0];
+
+        if(node->source >= 0)
+            input = plan->nodes[node->source].result;
+        else
+            input = node->source == XTRACT_PLAN_INPUT ? data : NULL;
+
+        if(node->ctx_fn != NULL)
+            rv = node->ctx_fn(plan->ctx, input, node->N, node->argv, node->result);
+        else
+            rv = node->fn(input, node->N, node->argv, node->result);
+
+        if(rv != XTRACT_SUCCESS && status == XTRACT_SUCCESS)
+            status = rv;
+    }
+
+    return status;
+}
+
+const double *xtract_plan_result(const xtract_plan *plan, int feature, int *N)
+{
+    int node;
+
+    if(feature < 0 || feature >= XTRACT_FEATURES || plan->outputs[feature] < 0)
+        return NULL;
+
+    node = plan->outputs[feature];
+
+    if(N != NULL)
+        *N = plan->nodes[node].size;
+
+    return plan->nodes[node].result;
+}
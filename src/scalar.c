@@ -44,6 +44,7 @@
 #include "xtract/xtract_helper.h"
 #include "xtract_macros_private.h"
 #include "xtract_globals_private.h"
+#include "xtract_simd_private.h"
 
 int xtract_mean(const double *data, const int N, const void *argv, double *result)
 {
@@ -51,14 +52,7 @@ int xtract_mean(const double *data, const int N, const void *argv, double *resul
 #ifdef __APPLE__
     vDSP_meanvD(data, 1, result, N);
 #else
-    int n = N;
-
-    *result = 0.0;
-
-    while(n--)
-        *result += data[n];
-
-    *result /= N;
+    *result = xtract_simd->sum_pow(data, N, 0.0, 1) / N;
 #endif
 
     return XTRACT_SUCCESS;
@@ -81,15 +75,7 @@ int xtract_variance(const double *data, const int N, const void *argv, double *r
     *result *= (double)N / (N - 1); /* Bessel correction */
     free(shifted);
 #else
-    int n = N;
-    const double arg0 = *(double *)argv;
-
-    *result = 0.0;
-
-    while(n--)
-        *result += XTRACT_SQ(data[n] - arg0);
-
-    *result /= (N - 1);
+    *result = xtract_simd->sum_pow(data, N, *(double *)argv, 2) / (N - 1);
 #endif
 
     return XTRACT_SUCCESS;
@@ -121,15 +107,7 @@ int xtract_average_deviation(const double *data, const int N, const void *argv,
     vDSP_meanvD(temp, 1, result, N);
     free(temp);
 #else
-    int n = N;
-    const double arg0 = *(double *)argv;
-
-    *result = 0.0;
-
-    while(n--)
-        *result += fabs(data[n] - arg0);
-
-    *result /= N;
+    *result = xtract_simd->sum_abs_dev(data, N, *(double *)argv) / N;
 #endif
 
     return XTRACT_SUCCESS;
@@ -138,9 +116,6 @@ int xtract_average_deviation(const double *data, const int N, const void *argv,
 int xtract_skewness(const double *data, const int N, const void *argv,  double *result)
 {
 
-    int n = N;
-
-    double temp = 0.0;
     const double arg0 = ((double *)argv)[0];
     const double arg1 = ((double *)argv)[1];
 
@@ -150,18 +125,7 @@ int xtract_skewness(const double *data, const int N, const void *argv,  double *
       return XTRACT_NO_RESULT;
     }
 
-    *result = 0.0;
-
-    if (arg1 == 0)
-    {
-      return XTRACT_NO_RESULT;
-    }
-
-    while(n--)
-    {
-        temp = (data[n] - arg0) / arg1;
-        *result += XTRACT_POW3(temp);
-    }
+    *result = xtract_simd->sum_pow(data, N, arg0, 3) / XTRACT_POW3(arg1);
 
     *result /= N;
 
@@ -172,9 +136,6 @@ int xtract_skewness(const double *data, const int N, const void *argv,  double *
 int xtract_kurtosis(const double *data, const int N, const void *argv,  double *result)
 {
 
-    int n = N;
-
-    double temp = 0.0;
     const double arg0 = ((double *)argv)[0];
     const double arg1 = ((double *)argv)[1];
 
@@ -184,16 +145,42 @@ int xtract_kurtosis(const double *data, const int N, const void *argv,  double *
         return XTRACT_NO_RESULT;
     }
 
-    *result = 0.0;
+    *result = xtract_simd->sum_pow(data, N, arg0, 4) / XTRACT_POW4(arg1);
 
-    while(n--)
+    *result /= N;
+    *result -= 3.0;
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_moments(const double *data, const int N, xtract_moments_t *moments)
+{
+
+    double sums[5];
+    double mean, sd;
+
+    if(N < 1)
+        return XTRACT_BAD_VECTOR_SIZE;
+
+    mean = xtract_simd->sum_pow(data, N, 0.0, 1) / N;
+
+    xtract_simd->central_sums(data, N, mean, sums);
+
+    /* sums[0] would be 0 with exact arithmetic; subtracting its square
+     * removes the error in the mean from the variance */
+    moments->mean = mean + sums[0] / N;
+    moments->variance = N > 1 ? (sums[2] - sums[0] * sums[0] / N) / (N - 1) : 0.0;
+    moments->standard_deviation = sd = sqrt(moments->variance);
+    moments->average_deviation = sums[1] / N;
+
+    if(sd == 0.0)
     {
-        temp = (data[n] - arg0) / arg1;
-        *result += XTRACT_POW4(temp);
+        moments->skewness = moments->kurtosis = 0.0;
+        return XTRACT_NO_RESULT;
     }
 
-    *result /= N;
-    *result -= 3.0;
+    moments->skewness = sums[3] / XTRACT_POW3(sd) / N;
+    moments->kurtosis = sums[4] / XTRACT_POW4(sd) / N - 3.0;
 
     return XTRACT_SUCCESS;
 }
@@ -213,11 +200,7 @@ int xtract_spectral_centroid(const double *data, const int N, const void *argv,
     vDSP_dotprD(amps, 1, freqs, 1, &FA, n);
     vDSP_sveD(amps, 1, &A, n);
 #else
-    while(n--)
-    {
-        FA += freqs[n] * amps[n];
-        A += amps[n];
-    }
+    FA = xtract_simd->weighted_sum_pow(amps, freqs, n, 0.0, 1, &A);
 #endif
 
     if(A == 0.0)
@@ -248,13 +231,7 @@ int xtract_spectral_variance(const double *data, const int N, const void *argv,
     amps = data;
     freqs = data + m;
 
-    *result = 0.0;
-
-    while(m--)
-    {
-        A += amps[m];
-        *result += XTRACT_SQ(freqs[m] - arg0) * amps[m];
-    }
+    *result = xtract_simd->weighted_sum_pow(amps, freqs, m, arg0, 2, &A);
 
     if (A == 0.0)
     {
@@ -325,11 +302,7 @@ int xtract_spectral_skewness(const double *data, const int N, const void *argv,
 
     double sum_amps = 0.0;
 
-    while(m--)
-    {
-        *result += XTRACT_POW3(freqs[m] - arg0) * amps[m];
-        sum_amps += amps[m];
-    }
+    *result = xtract_simd->weighted_sum_pow(amps, freqs, m, arg0, 3, &sum_amps);
 
     if(sum_amps == 0.0)
     {
@@ -361,14 +334,9 @@ int xtract_spectral_kurtosis(const double *data, const int N, const void *argv,
     amps = data;
     freqs = data + m;
 
-    *result = 0.0;
     double sum_amps = 0.0;
 
-    while(m--)
-    {
-        *result += XTRACT_POW4(freqs[m] - arg0) * amps[m];
-        sum_amps += amps[m];
-    }
+    *result = xtract_simd->weighted_sum_pow(amps, freqs, m, arg0, 4, &sum_amps);
 
     if(sum_amps == 0.0)
     {
@@ -385,13 +353,7 @@ int xtract_spectral_kurtosis(const double *data, const int N, const void *argv,
 int xtract_irregularity_k(const double *data, const int N, const void *argv, double *result)
 {
 
-    int n,
-        M = N - 1;
-
-    *result = 0.0;
-
-    for(n = 1; n < M; n++)
-        *result += fabs(data[n] - (data[n-1] + data[n] + data[n+1]) / 3.0);
+    *result = xtract_simd->sum_irregularity_k(data, N);
 
     return XTRACT_SUCCESS;
 }
@@ -399,15 +361,10 @@ int xtract_irregularity_k(const double *data, const int N, const void *argv, dou
 int xtract_irregularity_j(const double *data, const int N, const void *argv, double *result)
 {
 
-    int n;
+    double num, den;
 
-    double num = 0.0, den = 0.0;
-
-    for(n = 0; n < N - 1; n++)
-        num += XTRACT_SQ(data[n] - data[n+1]);
-
-    for(n = 0; n < N; n++)
-        den += XTRACT_SQ(data[n]);
+    num = xtract_simd->sum_sq_step(data, N);
+    den = xtract_simd->sum_pow(data, N, 0.0, 2);
 
     if(den == 0.0)
     {
@@ -578,13 +535,7 @@ int xtract_spread(const double *data, const int N, const void *argv, double *res
 int xtract_zcr(const double *data, const int N, const void *argv, double *result)
 {
 
-    int n = N;
-    int count = 0;
-
-    for(n = 1; n < N; n++)
-        if(data[n] * data[n-1] < 0) count++;
-
-    *result = (double)count / N;
+    *result = xtract_simd->count_negative_products(data, data + 1, N - 1) / N;
 
     return XTRACT_SUCCESS;
 }
@@ -754,13 +705,7 @@ int xtract_rms_amplitude(const double *data, const int N, const void *argv, doub
 #ifdef __APPLE__
     vDSP_rmsqvD(data, 1, result, N);
 #else
-    int n = N;
-
-    *result = 0.0;
-
-    while(n--) *result += XTRACT_SQ(data[n]);
-
-    *result = sqrt(*result / (double)N);
+    *result = sqrt(xtract_simd->sum_pow(data, N, 0.0, 2) / (double)N);
 #endif
 
     return XTRACT_SUCCESS;
@@ -922,18 +867,76 @@ int xtract_spectral_slope(const double *data, const int N, const void *argv, dou
 
 }
 
-int xtract_lowest_value(const double *data, const int N, const void *argv, double *result)
+int xtract_spectral_shape(const double *data, const int N, const void *argv, xtract_spectral_shape_t *shape)
 {
 
-    int n = N;
+    const double *freqs, *amps;
+    double sums[4], central[3];
+    double A, FA, F, FF, sd, temp, pivot, cumulative;
+    int n, M;
+    int rv = XTRACT_SUCCESS;
 
-    *result = DBL_MAX;
+    n = M = N >> 1;
 
-    while(n--)
+    amps = data;
+    freqs = data + n;
+
+    /* sums of amps, freq * amps, freqs, freq squared */
+    xtract_simd->spectral_sums(amps, freqs, M, sums);
+    A = sums[0];
+    FA = sums[1];
+    F = sums[2];
+    FF = sums[3];
+
+    pivot = A * ((double *)argv)[1] / 100.0;
+    cumulative = 0.0;
+
+    for(n = 0; n < M && cumulative < pivot; n++)
+        cumulative += amps[n];
+
+    shape->rolloff = n * ((double *)argv)[0];
+
+    if(A == 0.0)
+    {
+        shape->centroid = shape->variance = shape->standard_deviation = 0.0;
+        shape->skewness = shape->kurtosis = shape->slope = 0.0;
+        return XTRACT_NO_RESULT;
+    }
+
+    shape->centroid = FA / A;
+
+    temp = (double)M * FF - F * F;
+
+    if(temp == 0.0)
     {
-        if(data[n] > *(double *)argv)
-            *result = XTRACT_MIN(*result, data[n]);
+        shape->slope = 0.0;
+        rv = XTRACT_NO_RESULT;
     }
+    else
+        shape->slope = (1.0 / A) * ((double)M * FA - F * A) / temp;
+
+    xtract_simd->weighted_central_sums(amps, freqs, M, shape->centroid, central);
+
+    shape->variance = central[0] / A;
+    shape->standard_deviation = sd = sqrt(shape->variance);
+
+    if(sd == 0.0)
+    {
+        shape->skewness = shape->kurtosis = 0.0;
+        return XTRACT_NO_RESULT;
+    }
+
+    shape->skewness = central[1] / (A * XTRACT_POW3(sd));
+    shape->kurtosis = central[2] / (A * XTRACT_POW4(sd)) - 3.0;
+
+    return rv;
+
+}
+
+int xtract_lowest_value(const double *data, const int N, const void *argv, double *result)
+{
+
+    *result = xtract_simd->min_above(data, N, *(double *)argv);
 
     if (*result == DBL_MAX)
         return XTRACT_NO_RESULT;
@@ -947,12 +950,7 @@ int xtract_highest_value(const double *data, const int N, const void *argv, doub
 #ifdef __APPLE__
     vDSP_maxvD(data, 1, result, N);
 #else
-    int n = N;
-
-    *result = data[--n];
-
-    while(n--)
-        *result = XTRACT_MAX(*result, data[n]);
+    *result = xtract_simd->max(data, N);
 #endif
 
     return XTRACT_SUCCESS;
@@ -965,12 +963,7 @@ int xtract_sum(const double *data, const int N, const void *argv, double *result
 #ifdef __APPLE__
     vDSP_sveD(data, 1, result, N);
 #else
-    int n = N;
-
-    *result = 0.0;
-
-    while(n--)
-        *result += *data++;
+    *result = xtract_simd->sum_pow(data, N, 0.0, 1);
 #endif
 
     return XTRACT_SUCCESS;
@@ -980,12 +973,7 @@ int xtract_sum(const double *data, const int N, const void *argv, double *result
 int xtract_nonzero_count(const double *data, const int N, const void *argv, double *result)
 {
 
-    int n = N;
-
-    *result = 0.0;
-
-    while(n--)
-        *result += (*data++ ? 1 : 0);
+    *result = xtract_simd->count_nonzero(data, N);
 
     return XTRACT_SUCCESS;
 
@@ -1043,12 +1031,11 @@ int xtract_hps(const double *data, const int N, const void *argv, double *result
     return XTRACT_SUCCESS;
 }
 
-int xtract_f0(const double *data, const int N, const void *argv, double *result)
+static int time_domain_f0(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
 {
 
     int M, tau, n;
     double sr;
-    size_t bytes;
     double f0, err_tau_1, err_tau_x, array_max,
           threshold_peak, threshold_centre,
           *input;
@@ -1057,10 +1044,10 @@ int xtract_f0(const double *data, const int N, const void *argv, double *result)
     if(sr == 0)
         sr = 44100.0;
 
-    input = (double*)malloc(bytes = N * sizeof(double));
+    input = xtract_context_work(ctx, XTRACT_WORK_F0_INPUT, N);
     if(input == NULL)
         return XTRACT_MALLOC_FAILED;
-    input = (double*)memcpy(input, data, bytes);
+    memcpy(input, data, N * sizeof(double));
     /*  threshold_peak = *((double *)argv+1);
     threshold_centre = *((double *)argv+2);
     printf("peak: %.2\tcentre: %.2\n", threshold_peak, threshold_centre);*/
@@ -1119,51 +1106,55 @@ int xtract_f0(const double *data, const int N, const void *argv, double *result)
         {
             f0 = sr / (tau + (err_tau_x / err_tau_1));
             *result = f0;
-            free(input);
             return XTRACT_SUCCESS;
         }
     }
     *result = -0;
-    free(input);
     return XTRACT_NO_RESULT;
 }
 
+int xtract_f0(const double *data, const int N, const void *argv, double *result)
+{
+    return time_domain_f0(&xtract_thread_context, data, N, argv, result);
+}
+
 int xtract_failsafe_f0(const double *data, const int N, const void *argv, double *result)
+{
+    return xtract_failsafe_f0_ctx(&xtract_thread_context, data, N, argv, result);
+}
+
+int xtract_failsafe_f0_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
 {
 
     double *spectrum, argf[4], *peaks, sr;
     int rv;
 
-    rv = xtract_f0(data, N, argv, result);
+    rv = time_domain_f0(ctx, data, N, argv, result);
 
     if(rv == XTRACT_NO_RESULT)
     {
         sr = *(double *)argv;
         if(sr == 0)
             sr = 44100.0;
-        spectrum = (double *)calloc(N, sizeof(double));
-        peaks = (double *)calloc(N, sizeof(double));
+        spectrum = xtract_context_work(ctx, XTRACT_WORK_F0_SPECTRUM, N);
+        peaks = xtract_context_work(ctx, XTRACT_WORK_F0_PEAKS, N);
 
         if(spectrum == NULL || peaks == NULL)
-        {
-            free(spectrum);
-            free(peaks);
             return XTRACT_MALLOC_FAILED;
-        }
+
+        memset(spectrum, 0, N * sizeof(double));
+        memset(peaks, 0, N * sizeof(double));
 
         argf[0] = sr / N;
         argf[1] = XTRACT_MAGNITUDE_SPECTRUM;
         argf[2] = 0.0;
         argf[3] = 0.0;
-        xtract_spectrum(data, N, argf, spectrum);
+        xtract_spectrum_ctx(ctx, data, N, argf, spectrum);
         argf[1] = 10.0;
         xtract_peak_spectrum(spectrum, N >> 1, argf, peaks);
         argf[0] = 0.0;
         rv = xtract_lowest_value(peaks + (N >> 1), N >> 1, argf, result);
 
-        free(spectrum);
-        free(peaks);
-
         if(rv == XTRACT_NO_RESULT)
         {
             *result = 0.0;
@@ -1176,63 +1167,193 @@ int xtract_failsafe_f0(const double *data, const int N, const void *argv, double
 }
 
 int xtract_wavelet_f0(const double *data, const int N, const void *argv, double *result)
+{
+    return xtract_wavelet_f0_ctx(&xtract_thread_context, data, N, argv, result);
+}
+
+int xtract_wavelet_f0_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
 {
     double sr;
+    double *samples;
+    int *work;
+    int size;
 
     if(argv == NULL)
         return XTRACT_BAD_ARGV;
 
     sr = *(double *)argv;
+    if(sr == 0)
+        sr = 44100.0;
+
+    if(N < 2)
+        return XTRACT_NO_RESULT;
 
-    *result = dywapitch_computepitch(&wavelet_f0_state, data, 0, N);
+    size = dywapitch_workspacesize(N);
+    samples = xtract_context_work(ctx, XTRACT_WORK_F0_INPUT, size);
+    work = xtract_context_worki(ctx, XTRACT_WORK_WAVELET, 3 * (size_t)size);
+
+    if(samples == NULL || work == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    *result = dywapitch_computepitch_workspace(&ctx->wavelet_f0_state, data, 0, N, sr, samples, work);
 
     if (*result == 0.0)
     {
         return XTRACT_NO_RESULT;
     }
 
-    /* dywapitchtrack assumes 44100 Hz internally; scale for actual samplerate */
-    *result *= sr / 44100.0;
+    return XTRACT_SUCCESS;
+}
+
+struct xtract_wavelet_f0_state_
+{
+    dywapitchtracker tracker;
+    double samplerate;
+    int max_N;
+    double *samples;
+    int *work;
+};
+
+xtract_wavelet_f0_state *xtract_wavelet_f0_state_new(int max_N, double samplerate)
+{
+    xtract_wavelet_f0_state *state;
+    int size;
+
+    if(max_N < 2 || samplerate <= 0.0)
+    {
+        fprintf(stderr, "libxtract: error: xtract_wavelet_f0_state_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    state = calloc(1, sizeof(xtract_wavelet_f0_state));
+
+    if(state == NULL)
+    {
+        perror("could not allocate memory for xtract_wavelet_f0_state");
+        return NULL;
+    }
+
+    size = dywapitch_workspacesize(max_N);
+    state->samplerate = samplerate;
+    state->max_N = max_N;
+    state->samples = malloc(size * sizeof(double));
+    state->work = malloc(3 * (size_t)size * sizeof(int));
+
+    if(state->samples == NULL || state->work == NULL)
+    {
+        perror("could not allocate memory for xtract_wavelet_f0_state");
+        xtract_wavelet_f0_state_delete(state);
+        return NULL;
+    }
+
+    dywapitch_inittracking(&state->tracker);
+
+    return state;
+}
+
+void xtract_wavelet_f0_state_delete(xtract_wavelet_f0_state *state)
+{
+    if(state == NULL)
+        return;
+
+    free(state->samples);
+    free(state->work);
+    free(state);
+}
+
+void xtract_wavelet_f0_state_reset(xtract_wavelet_f0_state *state)
+{
+    dywapitch_inittracking(&state->tracker);
+}
+
+int xtract_wavelet_f0_state_compute(xtract_wavelet_f0_state *state, const double *data, const int N, const void *argv, double *result)
+{
+    if(N > state->max_N)
+    {
+        fprintf(stderr, "libxtract: error: xtract_wavelet_f0_state_compute(): N is larger than the state's max_N\n");
+        return XTRACT_BAD_STATE;
+    }
+
+    *result = 0.0;
+
+    if(N < 2)
+        return XTRACT_NO_RESULT;
+
+    *result = dywapitch_computepitch_workspace(&state->tracker, data, 0, N, state->samplerate, state->samples, state->work);
+
+    if (*result == 0.0)
+    {
+        return XTRACT_NO_RESULT;
+    }
 
     return XTRACT_SUCCESS;
 }
 
 int xtract_mcleod_f0(const double *data, const int N, const void *argv, double *result)
 {
-    double sr, threshold;
+    double args[2] = {0.0, 0.0};
+
+    if(argv == NULL)
+        return XTRACT_BAD_ARGV;
+
+    args[0] = *(double *)argv;
+
+    return xtract_mcleod_f0_ctx(&xtract_thread_context, data, N, args, result);
+}
+
+int xtract_mcleod_f0_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    double sr, threshold, min_f0;
     double *nsdf;
-    int tau, n, best_tau;
-    double best_val, a, b, c, peak_tau;
+    int tau, n, best_tau, lags, rv;
+    double best_val, a, b, c, peak_tau, m_tau, m_0;
     int positive_crossing;
 
     if(argv == NULL)
         return XTRACT_BAD_ARGV;
 
-    sr = *(double *)argv;
+    sr = ((double *)argv)[0];
+    min_f0 = ((double *)argv)[1];
     if(sr == 0)
         sr = 44100.0;
 
     threshold = 0.8;
 
-    nsdf = (double *)calloc(N, sizeof(double));
-    if(nsdf == NULL)
-        return XTRACT_MALLOC_FAILED;
+    if(N < 3)
+        return XTRACT_NO_RESULT;
+
+    /* Only lags up to the period of min_f0, plus one for the peak
+     * interpolation, are needed */
+    lags = N;
+    if(min_f0 > 0.0 && sr / min_f0 + 2.0 < N)
+        lags = (int)(sr / min_f0) + 2;
+    if(lags < 3)
+        lags = 3;
+
+    /* The unnormalised autocorrelation r(tau), overwritten by the NSDF */
+    rv = xtract_context_autocorrelation(ctx, data, N, lags, &nsdf);
+    if(rv != XTRACT_SUCCESS)
+        return rv;
+
+    /* NSDF(tau) = 2 * r(tau) / m(tau), where the type II normalisation term
+     * m(tau) = sum_{j=0}^{N-tau-1} (x[j]^2 + x[j+tau]^2) loses the squares of
+     * x[tau - 1] and x[N - tau] from one lag to the next */
+    m_0 = 0.0;
+    for(n = 0; n < N; n++)
+        m_0 += 2.0 * XTRACT_SQ(data[n]);
+
+    m_tau = m_0;
 
-    /* Compute the type II normalisation term m(tau) and
-     * the unnormalised autocorrelation r(tau) simultaneously.
-     * NSDF(tau) = 2 * r(tau) / m(tau)
-     * where m(tau) = sum_{j=0}^{N-tau-1} (x[j]^2 + x[j+tau]^2) */
-    for(tau = 0; tau < N; tau++)
+    for(tau = 0; tau < lags; tau++)
     {
-        double r_tau = 0.0;
-        double m_tau = 0.0;
+        if(tau > 0)
+            m_tau -= XTRACT_SQ(data[tau - 1]) + XTRACT_SQ(data[N - tau]);
 
-        for(n = 0; n < N - tau; n++)
-        {
-            r_tau += data[n] * data[n + tau];
-            m_tau += data[n] * data[n] + data[n + tau] * data[n + tau];
-        }
-        nsdf[tau] = (m_tau > 0.0) ? 2.0 * r_tau / m_tau : 0.0;
+        /* Rounding errors in r(tau) swamp lags that barely overlap */
+        if(m_tau > 1e-9 * m_0)
+            nsdf[tau] = XTRACT_MAX(-1.0, XTRACT_MIN(1.0, 2.0 * nsdf[tau] / m_tau));
+        else
+            nsdf[tau] = 0.0;
     }
 
     /* Find the highest NSDF peak using McLeod's key maximum selection:
@@ -1244,7 +1365,7 @@ int xtract_mcleod_f0(const double *data, const int N, const void *argv, double *
     positive_crossing = 0;
 
     /* First pass: find the global NSDF maximum (excluding tau=0) */
-    for(tau = 1; tau < N; tau++)
+    for(tau = 1; tau < lags; tau++)
     {
         if(nsdf[tau] > best_val)
         {
@@ -1257,14 +1378,13 @@ int xtract_mcleod_f0(const double *data, const int N, const void *argv, double *
     {
         /* No significant periodicity found */
         *result = 0.0;
-        free(nsdf);
         return XTRACT_NO_RESULT;
     }
 
     /* Second pass: find the first peak above threshold * max */
     best_tau = -1;
     positive_crossing = 0;
-    for(tau = 1; tau < N - 1; tau++)
+    for(tau = 1; tau < lags - 1; tau++)
     {
         if(nsdf[tau - 1] <= 0.0 && nsdf[tau] > 0.0)
             positive_crossing = 1;
@@ -1286,12 +1406,11 @@ int xtract_mcleod_f0(const double *data, const int N, const void *argv, double *
     if(best_tau < 1)
     {
         *result = 0.0;
-        free(nsdf);
         return XTRACT_NO_RESULT;
     }
 
     /* Parabolic interpolation around the peak for sub-sample accuracy.
-     * best_tau is always in [1, N-2] at this point (guaranteed by the
+     * best_tau is always in [1, lags-2] at this point (guaranteed by the
      * second-pass loop bounds and the best_tau < 1 early return above). */
     {
         double denom;
@@ -1305,7 +1424,130 @@ int xtract_mcleod_f0(const double *data, const int N, const void *argv, double *
 
     *result = sr / peak_tau;
 
-    free(nsdf);
+    return XTRACT_SUCCESS;
+}
+
+int xtract_yin_f0(const double *data, const int N, const void *argv, double *result)
+{
+    double args[2] = {44100.0, 0.0};
+
+    if(argv == NULL)
+        return XTRACT_BAD_ARGV;
+
+    args[0] = *(double *)argv;
+
+    return xtract_yin_f0_ctx(&xtract_thread_context, data, N, args, result);
+}
+
+int xtract_yin_f0_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    double sr, threshold;
+    double *d, *window;
+    double e_0, e_tau, diff, sum, scale, a, b, c, denom, peak_tau;
+    int tau, n, W, M, best_tau;
+    const xtract_fft_plan *plan;
+
+    if(argv == NULL)
+        return XTRACT_BAD_ARGV;
+
+    sr = ((double *)argv)[0];
+    threshold = ((double *)argv)[1];
+    if(sr == 0)
+        sr = 44100.0;
+    if(threshold <= 0.0)
+        threshold = XTRACT_YIN_THRESHOLD_DEFAULT;
+
+    *result = 0.0;
+
+    /* The integration window and the range of lags are both N / 2 */
+    W = N / 2;
+    if(W < 4)
+        return XTRACT_NO_RESULT;
+
+    M = N + (N & 1);
+
+    plan = xtract_context_fft_plan(ctx, &ctx->fft_data_autocorrelation_fft, M, XTRACT_FFT_REAL);
+    if(plan == NULL)
+        return XTRACT_BAD_VECTOR_SIZE;
+
+    d = xtract_context_work(ctx, XTRACT_WORK_FFT, M);
+    window = xtract_context_work(ctx, XTRACT_WORK_YIN, M);
+    if(d == NULL || window == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    /* r(tau) = sum_{j=0}^{W-1} x[j] * x[j+tau] is the cross-correlation of
+     * the first W samples with the whole block. j + tau stays below N for
+     * every lag used, so the circular correlation of size M doesn't wrap */
+    memcpy(d, data, N * sizeof(double));
+    memset(d + N, 0, (M - N) * sizeof(double));
+    memcpy(window, data, W * sizeof(double));
+    memset(window + W, 0, (M - W) * sizeof(double));
+
+    if(xtract_context_rdft(ctx, plan, 1, d) != XTRACT_SUCCESS ||
+            xtract_context_rdft(ctx, plan, 1, window) != XTRACT_SUCCESS)
+        return XTRACT_MALLOC_FAILED;
+
+    d[0] *= window[0];
+    d[1] *= window[1];
+    for(n = 2; n < M; n += 2)
+    {
+        a = d[n] * window[n] + d[n + 1] * window[n + 1];
+        b = d[n + 1] * window[n] - d[n] * window[n + 1];
+        d[n] = a;
+        d[n + 1] = b;
+    }
+
+    if(xtract_context_rdft(ctx, plan, -1, d) != XTRACT_SUCCESS)
+        return XTRACT_MALLOC_FAILED;
+
+    /* The difference function d(tau) = e(0) + e(tau) - 2 * r(tau), where
+     * e(tau) is the energy of x[tau .. tau+W-1] and is kept as a running
+     * sum. d is then replaced in place by its cumulative mean normalised
+     * form d'(tau) = d(tau) * tau / sum_{j=1}^{tau} d(j). The inverse FFT
+     * scales r(tau) by M / 2 */
+    e_0 = 0.0;
+    for(n = 0; n < W; n++)
+        e_0 += XTRACT_SQ(data[n]);
+
+    scale = 4.0 / M;
+    e_tau = e_0;
+    sum = 0.0;
+    d[0] = 1.0;
+
+    for(tau = 1; tau < W; tau++)
+    {
+        e_tau += XTRACT_SQ(data[tau + W - 1]) - XTRACT_SQ(data[tau - 1]);
+        diff = XTRACT_MAX(0.0, e_0 + e_tau - scale * d[tau]);
+        sum += diff;
+        d[tau] = sum > 0.0 ? diff * tau / sum : 1.0;
+    }
+
+    /* Absolute threshold: take the first dip below the threshold and follow
+     * it down to its local minimum */
+    best_tau = -1;
+    for(tau = 2; tau < W - 1; tau++)
+    {
+        if(d[tau] < threshold)
+        {
+            while(tau + 1 < W - 1 && d[tau + 1] < d[tau])
+                tau++;
+            best_tau = tau;
+            break;
+        }
+    }
+
+    if(best_tau < 0)
+        return XTRACT_NO_RESULT;
+
+    /* Parabolic interpolation around the minimum, best_tau is in
+     * [2, W - 2] so both neighbours exist */
+    a = d[best_tau - 1];
+    b = d[best_tau];
+    c = d[best_tau + 1];
+    denom = a - 2.0 * b + c;
+    peak_tau = (denom != 0.0) ? best_tau + 0.5 * (a - c) / denom : (double)best_tau;
+
+    *result = sr / peak_tau;
 
     return XTRACT_SUCCESS;
 }
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* simd.c: instantiates simd_impl.h for each supported instruction set and
+ * dispatches to the best one for the running CPU */
+
+#include <math.h>
+#include <float.h>
+
+#include "xtract_simd_private.h"
+#include "xtract_macros_private.h"
+
+#define XTRACT_SIMD_LAG_BLOCK 1024
+#define XTRACT_SIMD_LANES 16
+
+/* Set out to the sum of TERM for i from 0 to n - 1, in lanes of the given
+ * type. Lane k takes the terms with i % XTRACT_SIMD_LANES == k, and the
+ * remainder goes to the first lanes */
+#define XTRACT_SIMD_SUM_OF(type, n, TERM, out) \
+    do \
+    { \
+        type lane_[XTRACT_SIMD_LANES]; \
+        int i, base_, k_, end_ = (n) - (n) % XTRACT_SIMD_LANES; \
+        for(k_ = 0; k_ < XTRACT_SIMD_LANES; ++k_) \
+            lane_[k_] = 0; \
+        for(base_ = 0; base_ < end_; base_ += XTRACT_SIMD_LANES) \
+            for(k_ = 0; k_ < XTRACT_SIMD_LANES; ++k_) \
+            { \
+                i = base_ + k_; \
+                lane_[k_] += (TERM); \
+            } \
+        for(i = end_; i < (n); ++i) \
+            lane_[i - end_] += (TERM); \
+        (out) = 0; \
+        for(k_ = 0; k_ < XTRACT_SIMD_LANES; ++k_) \
+            (out) += lane_[k_]; \
+    } while(0)
+
+#define XTRACT_SIMD_SUM(n, TERM, out) XTRACT_SIMD_SUM_OF(double, n, TERM, out)
+#define XTRACT_SIMD_SUMF(n, TERM, out) XTRACT_SIMD_SUM_OF(float, n, TERM, out)
+
+/* As XTRACT_SIMD_SUM() for two sums taken in the same pass */
+#define XTRACT_SIMD_SUM2(n, TERM1, TERM2, out1, out2) \
+    do \
+    { \
+        double lane1_[XTRACT_SIMD_LANES], lane2_[XTRACT_SIMD_LANES]; \
+        int i, base_, k_, end_ = (n) - (n) % XTRACT_SIMD_LANES; \
+        for(k_ = 0; k_ < XTRACT_SIMD_LANES; ++k_) \
+            lane1_[k_] = lane2_[k_] = 0.0; \
+        for(base_ = 0; base_ < end_; base_ += XTRACT_SIMD_LANES) \
+            for(k_ = 0; k_ < XTRACT_SIMD_LANES; ++k_) \
+            { \
+                i = base_ + k_; \
+                lane1_[k_] += (TERM1); \
+                lane2_[k_] += (TERM2); \
+            } \
+        for(i = end_; i < (n); ++i) \
+        { \
+            lane1_[i - end_] += (TERM1); \
+            lane2_[i - end_] += (TERM2); \
+        } \
+        (out1) = (out2) = 0.0; \
+        for(k_ = 0; k_ < XTRACT_SIMD_LANES; ++k_) \
+        { \
+            (out1) += lane1_[k_]; \
+            (out2) += lane2_[k_]; \
+        } \
+    } while(0)
+
+#define XTRACT_SIMD_FN(f) simd_##f##_generic
+#define XTRACT_SIMD_TARGET
+#include "simd_impl.h"
+
+#ifdef XTRACT_SIMD_X86_DISPATCH
+
+#define XTRACT_SIMD_FN(f) simd_##f##_avx2
+#define XTRACT_SIMD_TARGET __attribute__((target("avx2,fma")))
+#include "simd_impl.h"
+
+#define XTRACT_SIMD_FN(f) simd_##f##_avx512
+#define XTRACT_SIMD_TARGET __attribute__((target("avx512f")))
+#include "simd_impl.h"
+
+#endif /* XTRACT_SIMD_X86_DISPATCH */
+
+int xtract_simd_isa(void)
+{
+#ifdef XTRACT_SIMD_X86_DISPATCH
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f"))
+        return XTRACT_SIMD_AVX512;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return XTRACT_SIMD_AVX2;
+#endif
+    return XTRACT_SIMD_GENERIC;
+}
+
+const xtract_simd_kernels *xtract_simd = &simd_kernels_generic;
+
+void xtract_simd_init(void)
+{
+    switch(xtract_simd_isa())
+    {
+#ifdef XTRACT_SIMD_X86_DISPATCH
+    case XTRACT_SIMD_AVX512:
+        xtract_simd = &simd_kernels_avx512;
+        break;
+    case XTRACT_SIMD_AVX2:
+        xtract_simd = &simd_kernels_avx2;
+        break;
+#endif
+    default:
+        xtract_simd = &simd_kernels_generic;
+        break;
+    }
+}
@@ -0,0 +1,655 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* simd_impl.h: template for the kernels declared in xtract_simd_private.h.
+ * simd.c includes this file once for each instruction set, with
+ *
+ *   XTRACT_SIMD_FN(f)      the name of function f for this instantiation
+ *   XTRACT_SIMD_TARGET     a function attribute selecting the instruction set
+ *
+ * defined.
+ *
+ * The reductions sum their terms in XTRACT_SIMD_LANES independent lanes,
+ * added together in a fixed order at the end, so the compiler can keep the
+ * lanes in vector registers and every instruction set gives the same result.
+ *
+ * The lag kernels accumulate into result, XTRACT_SIMD_LAG_BLOCK lags at a
+ * time so that the sums stay in the L1 cache. The innermost loop runs over
+ * the lags of a block, adding the terms of one sample to every sum, so it
+ * reads contiguous samples and updates independent sums, which the compiler
+ * vectorises without reordering any sum.
+ *
+ * The channel kernels take blocks of C interleaved channels, with sample n of
+ * channel c at x[n * C + c]. Their innermost loop runs over the channels of
+ * one sample, so each channel is a vector lane and each sum is taken in
+ * sample order whatever the instruction set.
+ */
+
+/* Define FN(name) to compute OP(a, b) summed over the lags from min_lag to
+ * max_lag */
+#define XTRACT_SIMD_LAG_KERNEL(name, OP) \
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(name)(const double *restrict x, int N, int min_lag, int max_lag, double *restrict result) \
+{ \
+    const double *restrict y; \
+    double *restrict acc; \
+    double a, b; \
+    int lo, hi, lags, i, k; \
+\
+    for(k = 0; k <= max_lag - min_lag; ++k) \
+        result[k] = 0.0; \
+\
+    for(lo = min_lag; lo <= max_lag; lo += XTRACT_SIMD_LAG_BLOCK) \
+    { \
+        hi = XTRACT_MIN(lo + XTRACT_SIMD_LAG_BLOCK - 1, max_lag); \
+        acc = result + lo - min_lag; \
+\
+        /* Lag lo + k uses the samples i < N - lo - k */ \
+        for(i = 0; i < N - lo; ++i) \
+        { \
+            a = x[i]; \
+            y = x + i + lo; \
+            lags = XTRACT_MIN(hi, N - 1 - i) - lo + 1; \
+            for(k = 0; k < lags; ++k) \
+            { \
+                b = y[k]; \
+                acc[k] += OP; \
+            } \
+        } \
+    } \
+\
+    for(k = 0; k <= max_lag - min_lag; ++k) \
+        result[k] /= N; \
+}
+
+XTRACT_SIMD_LAG_KERNEL(lags_product, a * b)
+XTRACT_SIMD_LAG_KERNEL(lags_abs_diff, fabs(a - b))
+XTRACT_SIMD_LAG_KERNEL(lags_sq_diff, (a - b) * (a - b))
+
+#undef XTRACT_SIMD_LAG_KERNEL
+
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(lags)(int kind, const double *data, int N, int min_lag, int max_lag, double *result)
+{
+    switch(kind)
+    {
+    case XTRACT_LAGS_PRODUCT:
+        XTRACT_SIMD_FN(lags_product)(data, N, min_lag, max_lag, result);
+        break;
+    case XTRACT_LAGS_ABS_DIFF:
+        XTRACT_SIMD_FN(lags_abs_diff)(data, N, min_lag, max_lag, result);
+        break;
+    default:
+        XTRACT_SIMD_FN(lags_sq_diff)(data, N, min_lag, max_lag, result);
+        break;
+    }
+}
+
+/* Sum of (x[i] - centre)^power, for power 1 to 4 */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(sum_pow)(const double *restrict x, int N, double centre, int power)
+{
+    double total;
+
+    switch(power)
+    {
+    case 1:
+        XTRACT_SIMD_SUM(N, x[i] - centre, total);
+        break;
+    case 2:
+        XTRACT_SIMD_SUM(N, XTRACT_SQ(x[i] - centre), total);
+        break;
+    case 3:
+        XTRACT_SIMD_SUM(N, XTRACT_POW3(x[i] - centre), total);
+        break;
+    default:
+        XTRACT_SIMD_SUM(N, XTRACT_POW4(x[i] - centre), total);
+        break;
+    }
+
+    return total;
+}
+
+/* Sum of |x[i] - centre| */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(sum_abs_dev)(const double *restrict x, int N, double centre)
+{
+    double total;
+
+    XTRACT_SIMD_SUM(N, fabs(x[i] - centre), total);
+
+    return total;
+}
+
+/* Sums of d, |d|, d^2, d^3 and d^4, where d = x[i] - centre */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(central_sums)(const double *restrict x, int N, double centre, double *restrict sums)
+{
+    double s1[XTRACT_SIMD_LANES], sa[XTRACT_SIMD_LANES], s2[XTRACT_SIMD_LANES];
+    double s3[XTRACT_SIMD_LANES], s4[XTRACT_SIMD_LANES];
+    double d, d2;
+    int i, k, end = N - N % XTRACT_SIMD_LANES;
+
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        s1[k] = sa[k] = s2[k] = s3[k] = s4[k] = 0.0;
+
+    for(i = 0; i < end; i += XTRACT_SIMD_LANES)
+    {
+        for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        {
+            d = x[i + k] - centre;
+            d2 = d * d;
+            s1[k] += d;
+            sa[k] += fabs(d);
+            s2[k] += d2;
+            s3[k] += d2 * d;
+            s4[k] += d2 * d2;
+        }
+    }
+
+    for(i = end; i < N; ++i)
+    {
+        d = x[i] - centre;
+        d2 = d * d;
+        s1[i - end] += d;
+        sa[i - end] += fabs(d);
+        s2[i - end] += d2;
+        s3[i - end] += d2 * d;
+        s4[i - end] += d2 * d2;
+    }
+
+    sums[0] = sums[1] = sums[2] = sums[3] = sums[4] = 0.0;
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+    {
+        sums[0] += s1[k];
+        sums[1] += sa[k];
+        sums[2] += s2[k];
+        sums[3] += s3[k];
+        sums[4] += s4[k];
+    }
+}
+
+/* Sum of w[i] * (x[i] - centre)^power, for power 1 to 4, and of w[i] */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(weighted_sum_pow)(const double *restrict w, const double *restrict x, int N, double centre, int power, double *weights)
+{
+    double total;
+
+    switch(power)
+    {
+    case 1:
+        XTRACT_SIMD_SUM2(N, w[i] * (x[i] - centre), w[i], total, *weights);
+        break;
+    case 2:
+        XTRACT_SIMD_SUM2(N, w[i] * XTRACT_SQ(x[i] - centre), w[i], total, *weights);
+        break;
+    case 3:
+        XTRACT_SIMD_SUM2(N, w[i] * XTRACT_POW3(x[i] - centre), w[i], total, *weights);
+        break;
+    default:
+        XTRACT_SIMD_SUM2(N, w[i] * XTRACT_POW4(x[i] - centre), w[i], total, *weights);
+        break;
+    }
+
+    return total;
+}
+
+/* Sums of w[i], w[i] * x[i], x[i] and x[i]^2 */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(spectral_sums)(const double *restrict w, const double *restrict x, int N, double *restrict sums)
+{
+    double sw[XTRACT_SIMD_LANES], swx[XTRACT_SIMD_LANES];
+    double sx[XTRACT_SIMD_LANES], sxx[XTRACT_SIMD_LANES];
+    int i, k, end = N - N % XTRACT_SIMD_LANES;
+
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        sw[k] = swx[k] = sx[k] = sxx[k] = 0.0;
+
+    for(i = 0; i < end; i += XTRACT_SIMD_LANES)
+    {
+        for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        {
+            sw[k] += w[i + k];
+            swx[k] += w[i + k] * x[i + k];
+            sx[k] += x[i + k];
+            sxx[k] += x[i + k] * x[i + k];
+        }
+    }
+
+    for(i = end; i < N; ++i)
+    {
+        sw[i - end] += w[i];
+        swx[i - end] += w[i] * x[i];
+        sx[i - end] += x[i];
+        sxx[i - end] += x[i] * x[i];
+    }
+
+    sums[0] = sums[1] = sums[2] = sums[3] = 0.0;
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+    {
+        sums[0] += sw[k];
+        sums[1] += swx[k];
+        sums[2] += sx[k];
+        sums[3] += sxx[k];
+    }
+}
+
+/* Sums of w[i] * d^2, w[i] * d^3 and w[i] * d^4, where d = x[i] - centre */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(weighted_central_sums)(const double *restrict w, const double *restrict x, int N, double centre, double *restrict sums)
+{
+    double s2[XTRACT_SIMD_LANES], s3[XTRACT_SIMD_LANES], s4[XTRACT_SIMD_LANES];
+    double d, wd2;
+    int i, k, end = N - N % XTRACT_SIMD_LANES;
+
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        s2[k] = s3[k] = s4[k] = 0.0;
+
+    for(i = 0; i < end; i += XTRACT_SIMD_LANES)
+    {
+        for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        {
+            d = x[i + k] - centre;
+            wd2 = w[i + k] * (d * d);
+            s2[k] += wd2;
+            s3[k] += wd2 * d;
+            s4[k] += wd2 * (d * d);
+        }
+    }
+
+    for(i = end; i < N; ++i)
+    {
+        d = x[i] - centre;
+        wd2 = w[i] * (d * d);
+        s2[i - end] += wd2;
+        s3[i - end] += wd2 * d;
+        s4[i - end] += wd2 * (d * d);
+    }
+
+    sums[0] = sums[1] = sums[2] = 0.0;
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+    {
+        sums[0] += s2[k];
+        sums[1] += s3[k];
+        sums[2] += s4[k];
+    }
+}
+
+/* Sum of (x[i] - x[i + 1])^2 for i < N - 1 */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(sum_sq_step)(const double *restrict x, int N)
+{
+    double total;
+
+    XTRACT_SIMD_SUM(N - 1, XTRACT_SQ(x[i] - x[i + 1]), total);
+
+    return total;
+}
+
+/* Sum of |x[i] - (x[i - 1] + x[i] + x[i + 1]) / 3| for 0 < i < N - 1 */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(sum_irregularity_k)(const double *restrict x, int N)
+{
+    const double *restrict y = x + 1;
+    double total;
+
+    XTRACT_SIMD_SUM(N - 2, fabs(y[i] - (y[i - 1] + y[i] + y[i + 1]) / 3.0), total);
+
+    return total;
+}
+
+/* Number of i < N where a[i] * b[i] < 0 */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(count_negative_products)(const double *restrict a, const double *restrict b, int N)
+{
+    double total;
+
+    XTRACT_SIMD_SUM(N, a[i] * b[i] < 0.0 ? 1.0 : 0.0, total);
+
+    return total;
+}
+
+/* Number of non-zero x[i] */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(count_nonzero)(const double *restrict x, int N)
+{
+    double total;
+
+    XTRACT_SIMD_SUM(N, x[i] != 0.0 ? 1.0 : 0.0, total);
+
+    return total;
+}
+
+/* Largest x[i], N must be at least 1 */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(max)(const double *restrict x, int N)
+{
+    double lane[XTRACT_SIMD_LANES];
+    int i, k, end = N - N % XTRACT_SIMD_LANES;
+
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        lane[k] = x[0];
+
+    for(i = 0; i < end; i += XTRACT_SIMD_LANES)
+        for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+            lane[k] = XTRACT_MAX(lane[k], x[i + k]);
+
+    for(i = end; i < N; ++i)
+        lane[0] = XTRACT_MAX(lane[0], x[i]);
+
+    for(k = 1; k < XTRACT_SIMD_LANES; ++k)
+        lane[0] = XTRACT_MAX(lane[0], lane[k]);
+
+    return lane[0];
+}
+
+/* Smallest x[i] above threshold, or DBL_MAX if there is none */
+static XTRACT_SIMD_TARGET double XTRACT_SIMD_FN(min_above)(const double *restrict x, int N, double threshold)
+{
+    double lane[XTRACT_SIMD_LANES];
+    double v;
+    int i, k, end = N - N % XTRACT_SIMD_LANES;
+
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        lane[k] = DBL_MAX;
+
+    for(i = 0; i < end; i += XTRACT_SIMD_LANES)
+    {
+        for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        {
+            v = x[i + k] > threshold ? x[i + k] : DBL_MAX;
+            lane[k] = XTRACT_MIN(lane[k], v);
+        }
+    }
+
+    for(i = end; i < N; ++i)
+        if(x[i] > threshold)
+            lane[0] = XTRACT_MIN(lane[0], x[i]);
+
+    for(k = 1; k < XTRACT_SIMD_LANES; ++k)
+        lane[0] = XTRACT_MIN(lane[0], lane[k]);
+
+    return lane[0];
+}
+
+/* Set sums[c] to the sum over n of x[n * C + c] */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(channels_sum)(const double *restrict x, int N, int C, double *restrict sums)
+{
+    int n, c;
+
+    for(c = 0; c < C; ++c)
+        sums[c] = 0.0;
+
+    for(n = 0; n < N; ++n, x += C)
+        for(c = 0; c < C; ++c)
+            sums[c] += x[c];
+}
+
+/* Set sums[c] to the sum over n of (x[n * C + c] - centre[c])^2, or of
+ * x[n * C + c]^2 if centre is NULL */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(channels_sum_sq_dev)(const double *restrict x, int N, int C, const double *restrict centre, double *restrict sums)
+{
+    int n, c;
+
+    for(c = 0; c < C; ++c)
+        sums[c] = 0.0;
+
+    if(centre == NULL)
+    {
+        for(n = 0; n < N; ++n, x += C)
+            for(c = 0; c < C; ++c)
+                sums[c] += x[c] * x[c];
+    }
+    else
+    {
+        for(n = 0; n < N; ++n, x += C)
+            for(c = 0; c < C; ++c)
+                sums[c] += (x[c] - centre[c]) * (x[c] - centre[c]);
+    }
+}
+
+/* Set counts[c] to the number of 0 < n < N where x[(n - 1) * C + c] *
+ * x[n * C + c] < 0 */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(channels_count_sign_changes)(const double *restrict x, int N, int C, double *restrict counts)
+{
+    const double *restrict y = x + C;
+    int n, c;
+
+    for(c = 0; c < C; ++c)
+        counts[c] = 0.0;
+
+    for(n = 1; n < N; ++n, x += C, y += C)
+        for(c = 0; c < C; ++c)
+            counts[c] += x[c] * y[c] < 0.0 ? 1.0 : 0.0;
+}
+
+/* Set result[c] to the largest x[n * C + c], N must be at least 1 */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(channels_max)(const double *restrict x, int N, int C, double *restrict result)
+{
+    int n, c;
+
+    for(c = 0; c < C; ++c)
+        result[c] = x[c];
+
+    for(n = 1, x += C; n < N; ++n, x += C)
+        for(c = 0; c < C; ++c)
+            result[c] = XTRACT_MAX(result[c], x[c]);
+}
+
+/* Set sums[c] to the sum over n of w[n] * x[n * C + c] */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(channels_weighted_sum)(const double *restrict x, int N, int C, const double *restrict w, double *restrict sums)
+{
+    int n, c;
+
+    for(c = 0; c < C; ++c)
+        sums[c] = 0.0;
+
+    for(n = 0; n < N; ++n, x += C)
+        for(c = 0; c < C; ++c)
+            sums[c] += w[n] * x[c];
+}
+
+/* Real FFT of N = 2M samples in each of C channels, see
+ * xtract_simd_kernels */
+static XTRACT_SIMD_TARGET void XTRACT_SIMD_FN(channels_rdft)(double *restrict re, double *restrict im, int M, int C, const double *restrict tw)
+{
+    const double *twr = tw, *twi = tw + M / 2;
+    const double *wr = tw + M, *wi = wr + M / 2 + 1;
+    double *restrict ar, *restrict ai, *restrict br, *restrict bi;
+    double xr, xi, er, ei, or_, oi, tr, ti;
+    int len, half, step, s, j, k, c;
+
+    /* Radix-2 passes of the complex FFT of M points */
+    for(len = 2; len <= M; len <<= 1)
+    {
+        half = len >> 1;
+        step = M / len;
+
+        for(s = 0; s < M; s += len)
+        {
+            for(j = 0; j < half; ++j)
+            {
+                ar = re + (size_t)(s + j) * C;
+                ai = im + (size_t)(s + j) * C;
+                br = ar + (size_t)half * C;
+                bi = ai + (size_t)half * C;
+                xr = twr[j * step];
+                xi = twi[j * step];
+
+                for(c = 0; c < C; ++c)
+                {
+                    tr = xr * br[c] - xi * bi[c];
+                    ti = xr * bi[c] + xi * br[c];
+                    br[c] = ar[c] - tr;
+                    bi[c] = ai[c] - ti;
+                    ar[c] += tr;
+                    ai[c] += ti;
+                }
+            }
+        }
+    }
+
+    /* Split the transform of the even and odd samples into bins k and M - k */
+    for(c = 0; c < C; ++c)
+    {
+        re[(size_t)M * C + c] = re[c] - im[c];
+        re[c] += im[c];
+        im[c] = im[(size_t)M * C + c] = 0.0;
+    }
+
+    for(k = 1; k <= M / 2; ++k)
+    {
+        ar = re + (size_t)k * C;
+        ai = im + (size_t)k * C;
+        br = re + (size_t)(M - k) * C;
+        bi = im + (size_t)(M - k) * C;
+
+        for(c = 0; c < C; ++c)
+        {
+            er = 0.5 * (ar[c] + br[c]);
+            ei = 0.5 * (ai[c] - bi[c]);
+            or_ = 0.5 * (ai[c] + bi[c]);
+            oi = 0.5 * (br[c] - ar[c]);
+            tr = wr[k] * or_ - wi[k] * oi;
+            ti = wr[k] * oi + wi[k] * or_;
+            ar[c] = er + tr;
+            ai[c] = ei + ti;
+            br[c] = er - tr;
+            bi[c] = ti - ei;
+        }
+    }
+}
+
+/* Single precision sum of (x[i] - centre)^power, for power 1 to 4 */
+static XTRACT_SIMD_TARGET float XTRACT_SIMD_FN(sum_powf)(const float *restrict x, int N, float centre, int power)
+{
+    float total;
+
+    switch(power)
+    {
+    case 1:
+        XTRACT_SIMD_SUMF(N, x[i] - centre, total);
+        break;
+    case 2:
+        XTRACT_SIMD_SUMF(N, XTRACT_SQ(x[i] - centre), total);
+        break;
+    case 3:
+        XTRACT_SIMD_SUMF(N, XTRACT_POW3(x[i] - centre), total);
+        break;
+    default:
+        XTRACT_SIMD_SUMF(N, XTRACT_POW4(x[i] - centre), total);
+        break;
+    }
+
+    return total;
+}
+
+/* Single precision sum of |x[i] - centre| */
+static XTRACT_SIMD_TARGET float XTRACT_SIMD_FN(sum_abs_devf)(const float *restrict x, int N, float centre)
+{
+    float total;
+
+    XTRACT_SIMD_SUMF(N, fabsf(x[i] - centre), total);
+
+    return total;
+}
+
+/* Number of i < N where a[i] * b[i] < 0, in single precision */
+static XTRACT_SIMD_TARGET float XTRACT_SIMD_FN(count_negative_productsf)(const float *restrict a, const float *restrict b, int N)
+{
+    float total;
+
+    XTRACT_SIMD_SUMF(N, a[i] * b[i] < 0.f ? 1.f : 0.f, total);
+
+    return total;
+}
+
+/* Largest x[i] in single precision, N must be at least 1 */
+static XTRACT_SIMD_TARGET float XTRACT_SIMD_FN(maxf)(const float *restrict x, int N)
+{
+    float lane[XTRACT_SIMD_LANES];
+    int i, k, end = N - N % XTRACT_SIMD_LANES;
+
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        lane[k] = x[0];
+
+    for(i = 0; i < end; i += XTRACT_SIMD_LANES)
+        for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+            lane[k] = XTRACT_MAX(lane[k], x[i + k]);
+
+    for(i = end; i < N; ++i)
+        lane[0] = XTRACT_MAX(lane[0], x[i]);
+
+    for(k = 1; k < XTRACT_SIMD_LANES; ++k)
+        lane[0] = XTRACT_MAX(lane[0], lane[k]);
+
+    return lane[0];
+}
+
+/* Smallest x[i] above threshold in single precision, or FLT_MAX if there is
+ * none */
+static XTRACT_SIMD_TARGET float XTRACT_SIMD_FN(min_abovef)(const float *restrict x, int N, float threshold)
+{
+    float lane[XTRACT_SIMD_LANES];
+    float v;
+    int i, k, end = N - N % XTRACT_SIMD_LANES;
+
+    for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        lane[k] = FLT_MAX;
+
+    for(i = 0; i < end; i += XTRACT_SIMD_LANES)
+    {
+        for(k = 0; k < XTRACT_SIMD_LANES; ++k)
+        {
+            v = x[i + k] > threshold ? x[i + k] : FLT_MAX;
+            lane[k] = XTRACT_MIN(lane[k], v);
+        }
+    }
+
+    for(i = end; i < N; ++i)
+        if(x[i] > threshold)
+            lane[0] = XTRACT_MIN(lane[0], x[i]);
+
+    for(k = 1; k < XTRACT_SIMD_LANES; ++k)
+        lane[0] = XTRACT_MIN(lane[0], lane[k]);
+
+    return lane[0];
+}
+
+static const xtract_simd_kernels XTRACT_SIMD_FN(kernels) =
+{
+    XTRACT_SIMD_FN(lags),
+    XTRACT_SIMD_FN(sum_pow),
+    XTRACT_SIMD_FN(sum_abs_dev),
+    XTRACT_SIMD_FN(central_sums),
+    XTRACT_SIMD_FN(weighted_sum_pow),
+    XTRACT_SIMD_FN(spectral_sums),
+    XTRACT_SIMD_FN(weighted_central_sums),
+    XTRACT_SIMD_FN(sum_sq_step),
+    XTRACT_SIMD_FN(sum_irregularity_k),
+    XTRACT_SIMD_FN(count_negative_products),
+    XTRACT_SIMD_FN(count_nonzero),
+    XTRACT_SIMD_FN(max),
+    XTRACT_SIMD_FN(min_above),
+    XTRACT_SIMD_FN(channels_sum),
+    XTRACT_SIMD_FN(channels_sum_sq_dev),
+    XTRACT_SIMD_FN(channels_count_sign_changes),
+    XTRACT_SIMD_FN(channels_max),
+    XTRACT_SIMD_FN(channels_weighted_sum),
+    XTRACT_SIMD_FN(channels_rdft),
+    XTRACT_SIMD_FN(sum_powf),
+    XTRACT_SIMD_FN(sum_abs_devf),
+    XTRACT_SIMD_FN(count_negative_productsf),
+    XTRACT_SIMD_FN(maxf),
+    XTRACT_SIMD_FN(min_abovef)
+};
+
+#undef XTRACT_SIMD_FN
+#undef XTRACT_SIMD_TARGET
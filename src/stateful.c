@@ -26,11 +26,18 @@
 #include "xtract/xtract_stateful.h"
 #include "xtract/libxtract.h"
 
+#include "xtract_macros_private.h"
+
 #include "c-ringbuf/ringbuf.h"
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <float.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327
+#endif
 
 struct xtract_last_n_state_
 {
@@ -90,3 +97,551 @@ int xtract_last_n(const xtract_last_n_state *state, const double *data, const in
     return XTRACT_SUCCESS;
 }
 
+
+/* The last capacity values written to a running statistic, oldest first
+ * from values[written % capacity] once the window is full */
+typedef struct running_window_
+{
+    double *values;
+    size_t capacity;
+    size_t count;       /* values in the window, up to capacity */
+    size_t written;     /* values written since the state was created */
+} running_window;
+
+static int running_window_init(running_window *window, size_t capacity)
+{
+    window->values = malloc(capacity * sizeof(double));
+    window->capacity = capacity;
+    window->count = 0;
+    window->written = 0;
+
+    return window->values != NULL;
+}
+
+/* Store value in the window, setting *oldest to the value it replaces and
+ * returning 1 if the window was full. Returns 0 if nothing was replaced */
+static inline int running_window_push(running_window *window, double value, double *oldest)
+{
+    double *slot = window->values + window->written++ % window->capacity;
+    int full = window->count == window->capacity;
+
+    *oldest = *slot;
+    *slot = value;
+
+    if(!full)
+        ++window->count;
+
+    return full;
+}
+
+/* True when the window has just been filled with new values again, the
+ * point at which running sums are recomputed from it */
+static inline int running_window_refilled(const running_window *window)
+{
+    return window->written % window->capacity == 0;
+}
+
+struct xtract_running_moments_state_
+{
+    running_window window;
+    double mean;
+    double m2;      /* sum of squared deviations from the mean */
+};
+
+xtract_running_moments_state *xtract_running_moments_state_new(size_t capacity)
+{
+    xtract_running_moments_state *state;
+
+    if(capacity == 0)
+    {
+        fprintf(stderr, "libxtract: error: xtract_running_moments_state_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    state = calloc(1, sizeof(xtract_running_moments_state));
+
+    if(state == NULL || !running_window_init(&state->window, capacity))
+    {
+        perror("could not allocate memory for xtract_running_moments_state");
+        free(state);
+        return NULL;
+    }
+
+    return state;
+}
+
+void xtract_running_moments_state_delete(xtract_running_moments_state *state)
+{
+    if(state == NULL)
+        return;
+
+    free(state->window.values);
+    free(state);
+}
+
+int xtract_running_moments(xtract_running_moments_state *state, const double *data, const int N, const void *argv, double *result)
+{
+    running_window *window = &state->window;
+    double x, oldest, mean, d;
+    size_t i;
+    int n;
+
+    for(n = 0; n < N; ++n)
+    {
+        x = data[n];
+
+        if(running_window_push(window, x, &oldest))
+        {
+            /* Replace the oldest value: the count doesn't change */
+            mean = state->mean + (x - oldest) / window->count;
+            state->m2 += (x - oldest) * (x - mean + oldest - state->mean);
+            state->mean = mean;
+        }
+        else
+        {
+            d = x - state->mean;
+            state->mean += d / window->count;
+            state->m2 += d * (x - state->mean);
+        }
+
+        if(running_window_refilled(window))
+        {
+            for(i = 0, mean = 0.0; i < window->count; ++i)
+                mean += window->values[i];
+            mean /= window->count;
+
+            for(i = 0, state->m2 = 0.0; i < window->count; ++i)
+                state->m2 += XTRACT_SQ(window->values[i] - mean);
+            state->mean = mean;
+        }
+    }
+
+    if(window->count == 0)
+    {
+        result[0] = result[1] = 0.0;
+        return XTRACT_NO_RESULT;
+    }
+
+    result[0] = state->mean;
+    result[1] = window->count > 1 && state->m2 > 0.0 ? state->m2 / (window->count - 1) : 0.0;
+
+    return XTRACT_SUCCESS;
+}
+
+/* Positions in the window of values that may yet be the minimum or maximum,
+ * oldest first. Each position is the number of values written before it */
+typedef struct running_queue_
+{
+    size_t *positions;
+    size_t head;
+    size_t size;
+} running_queue;
+
+struct xtract_running_extrema_state_
+{
+    running_window window;
+    running_queue min;  /* values rising from front to back */
+    running_queue max;  /* values falling from front to back */
+};
+
+#define RUNNING_QUEUE_AT(queue, k) (queue)->positions[((queue)->head + (k)) % capacity]
+#define RUNNING_QUEUE_VALUE(position) window->values[(position) % capacity]
+
+/* Add the value at position to queue, first dropping the values that have
+ * left the window from the front, then the values at the back that can't be
+ * the result while the new value is in the window, i.e. those for which
+ * new SUPERSEDES old is true */
+#define RUNNING_QUEUE_PUSH(queue, position, SUPERSEDES) \
+    do \
+    { \
+        double value_ = RUNNING_QUEUE_VALUE(position); \
+        while((queue)->size > 0 && RUNNING_QUEUE_AT(queue, 0) + capacity <= (position)) \
+        { \
+            (queue)->head = ((queue)->head + 1) % capacity; \
+            --(queue)->size; \
+        } \
+        while((queue)->size > 0 && value_ SUPERSEDES RUNNING_QUEUE_VALUE(RUNNING_QUEUE_AT(queue, (queue)->size - 1))) \
+            --(queue)->size; \
+        RUNNING_QUEUE_AT(queue, (queue)->size) = (position); \
+        ++(queue)->size; \
+    } while(0)
+
+xtract_running_extrema_state *xtract_running_extrema_state_new(size_t capacity)
+{
+    xtract_running_extrema_state *state;
+
+    if(capacity == 0)
+    {
+        fprintf(stderr, "libxtract: error: xtract_running_extrema_state_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    state = calloc(1, sizeof(xtract_running_extrema_state));
+
+    if(state == NULL || !running_window_init(&state->window, capacity))
+    {
+        perror("could not allocate memory for xtract_running_extrema_state");
+        free(state);
+        return NULL;
+    }
+
+    state->min.positions = malloc(capacity * sizeof(size_t));
+    state->max.positions = malloc(capacity * sizeof(size_t));
+
+    if(state->min.positions == NULL || state->max.positions == NULL)
+    {
+        perror("could not allocate memory for xtract_running_extrema_state");
+        xtract_running_extrema_state_delete(state);
+        return NULL;
+    }
+
+    return state;
+}
+
+void xtract_running_extrema_state_delete(xtract_running_extrema_state *state)
+{
+    if(state == NULL)
+        return;
+
+    free(state->window.values);
+    free(state->min.positions);
+    free(state->max.positions);
+    free(state);
+}
+
+int xtract_running_extrema(xtract_running_extrema_state *state, const double *data, const int N, const void *argv, double *result)
+{
+    running_window *window = &state->window;
+    const size_t capacity = window->capacity;
+    size_t position;
+    double oldest;
+    int n;
+
+    for(n = 0; n < N; ++n)
+    {
+        position = window->written;
+        running_window_push(window, data[n], &oldest);
+
+        RUNNING_QUEUE_PUSH(&state->min, position, <=);
+        RUNNING_QUEUE_PUSH(&state->max, position, >=);
+    }
+
+    if(window->count == 0)
+    {
+        result[0] = result[1] = 0.0;
+        return XTRACT_NO_RESULT;
+    }
+
+    result[0] = RUNNING_QUEUE_VALUE(RUNNING_QUEUE_AT(&state->min, 0));
+    result[1] = RUNNING_QUEUE_VALUE(RUNNING_QUEUE_AT(&state->max, 0));
+
+    return XTRACT_SUCCESS;
+}
+
+struct xtract_running_rms_state_
+{
+    running_window window;
+    double sum_sq;
+};
+
+xtract_running_rms_state *xtract_running_rms_state_new(size_t capacity)
+{
+    xtract_running_rms_state *state;
+
+    if(capacity == 0)
+    {
+        fprintf(stderr, "libxtract: error: xtract_running_rms_state_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    state = calloc(1, sizeof(xtract_running_rms_state));
+
+    if(state == NULL || !running_window_init(&state->window, capacity))
+    {
+        perror("could not allocate memory for xtract_running_rms_state");
+        free(state);
+        return NULL;
+    }
+
+    return state;
+}
+
+void xtract_running_rms_state_delete(xtract_running_rms_state *state)
+{
+    if(state == NULL)
+        return;
+
+    free(state->window.values);
+    free(state);
+}
+
+int xtract_running_rms(xtract_running_rms_state *state, const double *data, const int N, const void *argv, double *result)
+{
+    running_window *window = &state->window;
+    double oldest;
+    size_t i;
+    int n;
+
+    for(n = 0; n < N; ++n)
+    {
+        if(running_window_push(window, data[n], &oldest))
+            state->sum_sq -= oldest * oldest;
+
+        state->sum_sq += data[n] * data[n];
+
+        if(running_window_refilled(window))
+        {
+            for(i = 0, state->sum_sq = 0.0; i < window->count; ++i)
+                state->sum_sq += window->values[i] * window->values[i];
+        }
+    }
+
+    if(window->count == 0)
+    {
+        *result = 0.0;
+        return XTRACT_NO_RESULT;
+    }
+
+    *result = state->sum_sq > 0.0 ? sqrt(state->sum_sq / window->count) : 0.0;
+
+    return XTRACT_SUCCESS;
+}
+
+struct xtract_sliding_dft_state_
+{
+    int N;
+    int n_bins;         /* bins tracked */
+    int all_bins;       /* every bin from 0 to N / 2 is tracked, in order */
+    int *bins;
+    double *cos;        /* cos(2 pi j / N) for j < N */
+    double *sin;
+    double *wr;         /* e^(2 pi i k / N) for each tracked bin k */
+    double *wi;
+    double *re;         /* the tracked bins of the last frame, as e^(-2 pi i n k / N) */
+    double *im;
+    double *history;    /* the last N samples, oldest at written % N */
+    size_t written;     /* samples written since the last reset */
+};
+
+xtract_sliding_dft_state *xtract_sliding_dft_state_new(int N, const int *bins, int n_bins)
+{
+    xtract_sliding_dft_state *state;
+    int k, j;
+
+    if(N < 2 || N % 2 != 0 || (bins != NULL && n_bins < 1))
+    {
+        fprintf(stderr, "libxtract: error: xtract_sliding_dft_state_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    for(k = 0; bins != NULL && k < n_bins; ++k)
+    {
+        if(bins[k] < 0 || bins[k] > N / 2)
+        {
+            fprintf(stderr, "libxtract: error: xtract_sliding_dft_state_new(): bin %d is out of range\n", bins[k]);
+            return NULL;
+        }
+    }
+
+    state = calloc(1, sizeof(xtract_sliding_dft_state));
+
+    if(state == NULL)
+    {
+        perror("could not allocate memory for xtract_sliding_dft_state");
+        return NULL;
+    }
+
+    state->N = N;
+    state->all_bins = bins == NULL;
+    state->n_bins = bins == NULL ? N / 2 + 1 : n_bins;
+    state->bins = malloc(state->n_bins * sizeof(int));
+    state->cos = malloc(N * sizeof(double));
+    state->sin = malloc(N * sizeof(double));
+    state->wr = malloc(state->n_bins * sizeof(double));
+    state->wi = malloc(state->n_bins * sizeof(double));
+    state->re = malloc(state->n_bins * sizeof(double));
+    state->im = malloc(state->n_bins * sizeof(double));
+    state->history = malloc(N * sizeof(double));
+
+    if(state->bins == NULL || state->cos == NULL || state->sin == NULL || state->wr == NULL ||
+            state->wi == NULL || state->re == NULL || state->im == NULL || state->history == NULL)
+    {
+        perror("could not allocate memory for xtract_sliding_dft_state");
+        xtract_sliding_dft_state_delete(state);
+        return NULL;
+    }
+
+    for(j = 0; j < N; ++j)
+    {
+        state->cos[j] = cos(2.0 * M_PI * j / N);
+        state->sin[j] = sin(2.0 * M_PI * j / N);
+    }
+
+    for(k = 0; k < state->n_bins; ++k)
+    {
+        state->bins[k] = bins == NULL ? k : bins[k];
+        state->wr[k] = state->cos[state->bins[k]];
+        state->wi[k] = state->sin[state->bins[k]];
+    }
+
+    xtract_sliding_dft_state_reset(state);
+
+    return state;
+}
+
+void xtract_sliding_dft_state_delete(xtract_sliding_dft_state *state)
+{
+    if(state == NULL)
+        return;
+
+    free(state->bins);
+    free(state->cos);
+    free(state->sin);
+    free(state->wr);
+    free(state->wi);
+    free(state->re);
+    free(state->im);
+    free(state->history);
+    free(state);
+}
+
+void xtract_sliding_dft_state_reset(xtract_sliding_dft_state *state)
+{
+    memset(state->re, 0, state->n_bins * sizeof(double));
+    memset(state->im, 0, state->n_bins * sizeof(double));
+    memset(state->history, 0, state->N * sizeof(double));
+    state->written = 0;
+}
+
+/* Recompute the tracked bins from the history, which is in order when
+ * written is a multiple of N */
+static void sliding_dft_anchor(xtract_sliding_dft_state *state)
+{
+    const int N = state->N;
+    double re, im;
+    int k, n, j;
+
+    for(k = 0; k < state->n_bins; ++k)
+    {
+        re = im = 0.0;
+
+        for(n = 0, j = 0; n < N; ++n, j = (j + state->bins[k]) % N)
+        {
+            re += state->history[n] * state->cos[j];
+            im -= state->history[n] * state->sin[j];
+        }
+
+        state->re[k] = re;
+        state->im[k] = im;
+    }
+}
+
+int xtract_sliding_dft(xtract_sliding_dft_state *state, const double *data, const int N, const void *argv, double *result)
+{
+    const int frame = state->N;
+    const int M = frame >> 1;
+    double *restrict re = state->re, *restrict im = state->im;
+    const double *restrict wr = state->wr, *restrict wi = state->wi;
+    double NxN = XTRACT_SQ((double)frame);
+    double *slot, delta, real, imag, temp, q, max = 0.0;
+    int vector, withDC, normalise, count, offset;
+    int n, k, m;
+
+    for(n = 0; n < N; ++n)
+    {
+        slot = state->history + state->written++ % frame;
+        delta = data[n] - *slot;
+        *slot = data[n];
+
+        /* X_k <- (X_k - oldest + newest) e^(2 pi i k / N) */
+        for(k = 0; k < state->n_bins; ++k)
+        {
+            real = re[k] + delta;
+            imag = im[k];
+            re[k] = real * wr[k] - imag * wi[k];
+            im[k] = real * wi[k] + imag * wr[k];
+        }
+
+        if(state->written % frame == 0)
+            sliding_dft_anchor(state);
+    }
+
+    if(state->written < (size_t)frame)
+        return XTRACT_NO_RESULT;
+
+    q = *(double *)argv;
+    vector = (int)*((double *)argv+1);
+    withDC = (int)*((double *)argv+2);
+    normalise = (int)*((double *)argv+3);
+
+    if(!q)
+        q = XTRACT_SR_DEFAULT / frame;
+
+    /* Every bin gives the N / 2 bins of xtract_spectrum(), which discards DC
+     * and keeps Nyquist unless withDC */
+    count = state->all_bins ? M : state->n_bins;
+    offset = state->all_bins && !withDC ? 1 : 0;
+
+    for(m = 0; m < count; ++m)
+    {
+        k = m + offset;
+        real = re[k];
+        imag = -im[k]; /* xtract_spectrum() gives the conjugate */
+        temp = XTRACT_SQ(real) + XTRACT_SQ(imag);
+
+        switch(vector)
+        {
+        case XTRACT_LOG_MAGNITUDE_SPECTRUM:
+            temp = temp > XTRACT_LOG_LIMIT ? log(sqrt(temp) / (double)frame) : XTRACT_LOG_LIMIT_DB;
+            result[m] = (temp + XTRACT_DB_SCALE_OFFSET) / XTRACT_DB_SCALE_OFFSET;
+            break;
+        case XTRACT_POWER_SPECTRUM:
+            result[m] = temp / NxN;
+            break;
+        case XTRACT_LOG_POWER_SPECTRUM:
+            temp = temp > XTRACT_LOG_LIMIT ? log(temp / NxN) : XTRACT_LOG_LIMIT_DB;
+            result[m] = (temp + XTRACT_DB_SCALE_OFFSET) / XTRACT_DB_SCALE_OFFSET;
+            break;
+        case XTRACT_SPECTRUM_COEFFICIENTS:
+            result[m * 2] = real;
+            result[m * 2 + 1] = imag;
+            continue;
+        default:
+            /* MAGNITUDE_SPECTRUM */
+            result[m] = sqrt(temp) / (double)frame;
+            break;
+        }
+
+        result[count + m] = state->bins[k] * q;
+        max = result[m] > max ? result[m] : max;
+    }
+
+    if(!normalise)
+        return XTRACT_SUCCESS;
+
+    if(vector == XTRACT_SPECTRUM_COEFFICIENTS)
+    {
+        for(m = 0; m < count; ++m)
+            max = result[m] > max ? result[m] : max;
+
+        if(max == 0.0)
+            return XTRACT_SUCCESS;
+
+        /* Interleaved formats: find true max magnitude, then scale both components */
+        for(m = 0, max = 0.0; m < count; ++m)
+        {
+            temp = sqrt(XTRACT_SQ(result[m * 2]) + XTRACT_SQ(result[m * 2 + 1]));
+            max = temp > max ? temp : max;
+        }
+
+        for(m = 0; max != 0.0 && m < 2 * count; ++m)
+            result[m] /= max;
+    }
+    else if(max != 0.0)
+    {
+        for(m = 0; m < count; ++m)
+            result[m] /= max;
+    }
+
+    return XTRACT_SUCCESS;
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* stream.c: cuts a stream of samples into overlapping windowed frames */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_stream.h"
+
+#include "c-ringbuf/ringbuf.h"
+
+/* Frames of buffer space in the ring, see xtract_stft_stream_write() */
+#define XTRACT_STREAM_FRAMES 4
+
+struct xtract_stft_stream_
+{
+    int N;
+    int hop;
+    int window_type;
+    ringbuf_t ringbuf;
+    size_t consumed;            /* bytes of the last frame's hop still in the ring */
+    double *window;
+    double *frame;
+    xtract_context *ctx;        /* allocated by the first xtract_stft_stream_spectrum() */
+};
+
+xtract_stft_stream *xtract_stft_stream_new(int N, int hop, int window_type)
+{
+    xtract_stft_stream *stream;
+
+    if(N < 2 || hop < 1 || hop > N)
+    {
+        fprintf(stderr, "libxtract: error: xtract_stft_stream_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    stream = calloc(1, sizeof(xtract_stft_stream));
+
+    if(stream == NULL)
+    {
+        perror("could not allocate memory for xtract_stft_stream");
+        return NULL;
+    }
+
+    stream->N = N;
+    stream->hop = hop;
+    stream->window_type = window_type;
+
+    /* c-ringbuf keeps one byte spare to tell full from empty. Asking for one
+     * byte less than a whole number of doubles makes the buffer itself a
+     * whole number of doubles, so every sample stays aligned across the wrap
+     * and frames can be read in place */
+    stream->ringbuf = ringbuf_new(XTRACT_STREAM_FRAMES * N * sizeof(double) - 1);
+    stream->window = xtract_init_window(N, window_type);
+    stream->frame = malloc(N * sizeof(double));
+
+    if(stream->ringbuf == NULL || stream->window == NULL || stream->frame == NULL)
+    {
+        perror("could not allocate memory for xtract_stft_stream");
+        xtract_stft_stream_delete(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+void xtract_stft_stream_delete(xtract_stft_stream *stream)
+{
+    if(stream == NULL)
+        return;
+
+    if(stream->ringbuf != NULL)
+        ringbuf_free(&stream->ringbuf);
+
+    xtract_context_delete(stream->ctx);
+    xtract_free_window(stream->window);
+    free(stream->frame);
+    free(stream);
+}
+
+void xtract_stft_stream_reset(xtract_stft_stream *stream)
+{
+    ringbuf_reset(stream->ringbuf);
+    stream->consumed = 0;
+}
+
+/* Drop the hop of the last frame, which was kept so that a frame returned
+ * in place stays valid until the next call */
+static void stream_release(xtract_stft_stream *stream)
+{
+    ringbuf_discard(stream->ringbuf, stream->consumed);
+    stream->consumed = 0;
+}
+
+int xtract_stft_stream_write(xtract_stft_stream *stream, const double *data, int n)
+{
+    size_t space;
+
+    if(n <= 0)
+        return 0;
+
+    stream_release(stream);
+
+    space = ringbuf_bytes_free(stream->ringbuf) / sizeof(double);
+
+    if((size_t)n > space)
+        n = (int)space;
+
+    ringbuf_memcpy_into(stream->ringbuf, data, n * sizeof(double));
+
+    return n;
+}
+
+int xtract_stft_stream_frame(xtract_stft_stream *stream, const double **frame)
+{
+    const size_t bytes = stream->N * sizeof(double);
+    const double *samples;
+    int n;
+
+    stream_release(stream);
+
+    if(ringbuf_bytes_used(stream->ringbuf) < bytes)
+        return XTRACT_NO_RESULT;
+
+    if(ringbuf_bytes_contiguous(stream->ringbuf) >= bytes)
+    {
+        samples = ringbuf_tail(stream->ringbuf);
+    }
+    else
+    {
+        /* The frame wraps around the end of the ring */
+        ringbuf_memcpy_from(stream->frame, stream->ringbuf, bytes, false);
+        samples = stream->frame;
+    }
+
+    if(stream->window_type == XTRACT_RECTANGULAR)
+    {
+        *frame = samples;
+    }
+    else
+    {
+        for(n = 0; n < stream->N; ++n)
+            stream->frame[n] = samples[n] * stream->window[n];
+
+        *frame = stream->frame;
+    }
+
+    stream->consumed = stream->hop * sizeof(double);
+
+    return XTRACT_SUCCESS;
+}
+
+int xtract_stft_stream_spectrum(xtract_stft_stream *stream, const void *argv, double *result)
+{
+    const double *frame;
+    int rv;
+
+    if(stream->ctx == NULL)
+    {
+        stream->ctx = xtract_context_new();
+
+        if(stream->ctx == NULL)
+            return XTRACT_MALLOC_FAILED;
+
+        rv = xtract_context_init_fft(stream->ctx, stream->N, XTRACT_SPECTRUM);
+
+        if(rv != XTRACT_SUCCESS)
+        {
+            xtract_context_delete(stream->ctx);
+            stream->ctx = NULL;
+            return rv;
+        }
+    }
+
+    rv = xtract_stft_stream_frame(stream, &frame);
+
+    if(rv != XTRACT_SUCCESS)
+        return rv;
+
+    return xtract_spectrum_ctx(stream->ctx, frame, stream->N, argv, result);
+}
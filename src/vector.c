@@ -31,343 +31,96 @@
 
 #include "xtract/libxtract.h"
 #include "xtract_macros_private.h"
+#include "xtract_filterbank_private.h"
 #include "xtract_globals_private.h"
+#include "xtract_simd_private.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846264338327
 #endif
 
-thread_local double** dct_cos_table = NULL;
-thread_local int dct_cos_table_dim = 0;
-
-int xtract_spectrum(const double *data, const int N, const void *argv, double *result)
+/* Spectrum values for one bin, given its real and imaginary parts */
+static inline double spectrum_log_magnitude(double real, double imag, double N)
 {
+    double temp = XTRACT_SQ(real) + XTRACT_SQ(imag);
 
-    int vector     = 0;
-    int withDC     = 0;
-    int normalise  = 0;
-    double q        = 0.0;
-    double temp     = 0.0;
-    double max      = 0.0;
-    double NxN      = XTRACT_SQ((double)N);
-    double real = 0.0;
-    double imag = 0.0;
-    unsigned int n = 0;
-    unsigned int m = 0;
-    unsigned int M = N >> 1;
-#ifdef USE_OOURA
-    double *fft = NULL;
-#else 
-    DSPDoubleSplitComplex *fft = NULL;
-#endif
-
-    q = *(double *)argv;
-    vector = (int)*((double *)argv+1);
-    withDC = (int)*((double *)argv+2);
-    normalise = (int)*((double *)argv+3);
-
-    XTRACT_CHECK_q;
-#ifdef USE_OOURA
-    if(!ooura_data_spectrum.initialised)
-#else
-    if(!vdsp_data_spectrum.initialised)
-#endif
+    if (temp > XTRACT_LOG_LIMIT)
     {
-        fprintf(stderr,
-                "libxtract: error: xtract_spectrum() failed, "
-                "fft data unitialised.\n");
-        return XTRACT_NO_RESULT;
+        temp = log(sqrt(temp) / N);
+    }
+    else
+    {
+        temp = XTRACT_LOG_LIMIT_DB;
     }
+    /* Scaling */
+    return (temp + XTRACT_DB_SCALE_OFFSET) / XTRACT_DB_SCALE_OFFSET;
+}
 
-#ifdef USE_OOURA
-    /* ooura is in-place
-     * the output format is
-     * a[0] - DC, a[1] - nyquist, a[2...N-1] - remaining bins
-     */
-    fft = (double*)malloc(N * sizeof(double));
-    if(fft == NULL)
-        return XTRACT_MALLOC_FAILED;
-    memcpy(fft, data, N * sizeof(double));
-
-    rdft(N, 1, fft, ooura_data_spectrum.ooura_ip, 
-            ooura_data_spectrum.ooura_w);
-#else
-    fft = &vdsp_data_spectrum.fft;
-    vDSP_ctozD((DSPDoubleComplex *)data, 2, fft, 1, N >> 1);
-    vDSP_fft_zripD(vdsp_data_spectrum.setup, fft, 1, 
-            vdsp_data_spectrum.log2N, FFT_FORWARD);
-#endif
+static inline double spectrum_log_power(double real, double imag, double NxN)
+{
+    double temp = XTRACT_SQ(real) + XTRACT_SQ(imag);
 
-    switch(vector)
-    {
+    if (temp > XTRACT_LOG_LIMIT)
+        temp = log(temp / NxN);
+    else
+        temp = XTRACT_LOG_LIMIT_DB;
 
-        case XTRACT_LOG_MAGNITUDE_SPECTRUM:
-        for(n = 0, m = 0; m < M; ++n, ++m)
-        {
-            if(n==0 && !withDC) /* discard DC and keep Nyquist */
-            {
-                ++n;
-            }
-#ifdef USE_OOURA
-			/*
-            if(n==1 && withDC) // discard Nyquist
-            {
-                ++n;
-            }
-			*/
-			// OOURA discards the always 0 imaginary of DC and Nyquists
-			if (n == M && !withDC)
-			{
-				real = fft[1];
-				imag = 0.0;
-			}
-			else if (n == 0 && withDC) {
-				real = fft[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft[n * 2];
-				imag = fft[n * 2 + 1];
-			}
-#else
-			if (n == M && !withDC)
-			{
-				real = fft->imagp[0];
-				imag = 0.0;
-		}
-			else if (n == 0 && withDC) {
-				real = fft->realp[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft->realp[n];
-				imag = fft->imagp[n];
-			}
-#endif
+    return (temp + XTRACT_DB_SCALE_OFFSET) / XTRACT_DB_SCALE_OFFSET;
+}
 
-            temp = XTRACT_SQ(real) + XTRACT_SQ(imag);
-            if (temp > XTRACT_LOG_LIMIT)
-            {
-                temp = log(sqrt(temp) / (double)N);
-            }
-            else
-            {
-                temp = XTRACT_LOG_LIMIT_DB;
-            }
-            result[m] =
-                /* Scaling */
-                (temp + XTRACT_DB_SCALE_OFFSET) /
-                XTRACT_DB_SCALE_OFFSET;
+/* Convert a forward real FFT of size N into the spectrum requested by vector.
+ * The FFT is in packed form: re[0] is DC, im[0] is Nyquist, and bin n is
+ * re[n * stride] + i * im[n * stride] for 0 < n < N / 2 */
+static void spectrum_from_fft(const double *re, const double *im, const int stride, const int N, const int vector, const int withDC, const int normalise, const double q, double *result)
+{
+    double NxN = XTRACT_SQ((double)N);
+    double max = 0.0;
+    double real = 0.0;
+    double imag = 0.0;
+    int M = N >> 1;
+    int offset = withDC ? 0 : 1; /* discard DC and keep Nyquist unless withDC */
+    int n, m;
 
+    switch(vector)
+    {
+
+    case XTRACT_LOG_MAGNITUDE_SPECTRUM:
+        XTRACT_SPECTRUM_BINS(
+            result[m] = spectrum_log_magnitude(real, imag, (double)N);
             XTRACT_SET_FREQUENCY;
-            XTRACT_GET_MAX;
-        }
+            XTRACT_GET_MAX);
         break;
 
     case XTRACT_POWER_SPECTRUM:
-        for(n = 0, m = 0; m < M; ++n, ++m)
-        {
-            if(n==0 && !withDC) /* discard DC and keep Nyquist */
-            {
-                ++n;
-            }
-#ifdef USE_OOURA
-			/*
-			if(n==1 && withDC) // discard Nyquist
-			{
-				++n;
-			}
-			*/
-			// OOURA discards the always 0 imaginary of DC and Nyquists
-			if (n == M && !withDC)
-			{
-				real = fft[1];
-				imag = 0.0;
-			}
-			else if (n == 0 && withDC) {
-				real = fft[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft[n * 2];
-				imag = fft[n * 2 + 1];
-			}
-#else
-			if (n == M && !withDC)
-			{
-				real = fft->imagp[0];
-				imag = 0.0;
-		}
-			else if (n == 0 && withDC) {
-				real = fft->realp[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft->realp[n];
-				imag = fft->imagp[n];
-			}
-#endif
-
+        XTRACT_SPECTRUM_BINS(
             result[m] = (XTRACT_SQ(real) + XTRACT_SQ(imag)) / NxN;
             XTRACT_SET_FREQUENCY;
-            XTRACT_GET_MAX;
-        }
+            XTRACT_GET_MAX);
         break;
 
     case XTRACT_LOG_POWER_SPECTRUM:
-        for(n = 0, m = 0; m < M; ++n, ++m)
-        {
-            if(n==0 && !withDC) /* discard DC and keep Nyquist */
-            {
-                ++n;
-            }
-#ifdef USE_OOURA
-			/*
-			if(n==1 && withDC) // discard Nyquist
-			{
-				++n;
-			}
-			*/
-			// OOURA discards the always 0 imaginary of DC and Nyquists
-			if (n == M && !withDC)
-			{
-				real = fft[1];
-				imag = 0.0;
-			}
-			else if (n == 0 && withDC) {
-				real = fft[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft[n * 2];
-				imag = fft[n * 2 + 1];
-			}
-#else
-			if (n == M && !withDC)
-			{
-				real = fft->imagp[0];
-				imag = 0.0;
-		}
-			else if (n == 0 && withDC) {
-				real = fft->realp[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft->realp[n];
-				imag = fft->imagp[n];
-			}
-#endif
-
-            if ((temp = XTRACT_SQ(real) + XTRACT_SQ(imag)) >
-                    XTRACT_LOG_LIMIT)
-                temp = log(temp / NxN);
-            else
-                temp = XTRACT_LOG_LIMIT_DB;
-
-            result[m] = (temp + XTRACT_DB_SCALE_OFFSET) /
-                        XTRACT_DB_SCALE_OFFSET;
+        XTRACT_SPECTRUM_BINS(
+            result[m] = spectrum_log_power(real, imag, NxN);
             XTRACT_SET_FREQUENCY;
-            XTRACT_GET_MAX;
-        }
+            XTRACT_GET_MAX);
         break;
 
     case XTRACT_SPECTRUM_COEFFICIENTS:
-        for(n = 0, m = 0; m < M; ++n, ++m)
-        {
-            if(n==0 && !withDC) /* discard DC and keep Nyquist */
-            {
-                ++n;
-            }
-#ifdef USE_OOURA
-			/*
-			if(n==1 && withDC) // discard Nyquist
-			{
-				++n;
-			}
-			*/
-			// OOURA discards the always 0 imaginary of DC and Nyquists
-			if (n == M && !withDC)
-			{
-				real = fft[1];
-				imag = 0.0;
-			}
-			else if (n == 0 && withDC) {
-				real = fft[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft[n * 2];
-				imag = fft[n * 2 + 1];
-			}
-#else
-			if (n == M && !withDC)
-			{
-				real = fft->imagp[0];
-				imag = 0.0;
-		    }
-			else if (n == 0 && withDC) {
-				real = fft->realp[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft->realp[n];
-				imag = fft->imagp[n];
-			}
-#endif
+        XTRACT_SPECTRUM_BINS(
             result[m*2] = real;
-            result[m*2+1] = imag;
+            result[m*2+1] = imag);
+        for(m = 0; m < M; ++m)
+        {
             XTRACT_GET_MAX;
-            }
+        }
         break;
 
     default:
         /* MAGNITUDE_SPECTRUM */
-        for(n = 0, m = 0; m < M; ++n, ++m)
-        {
-            if(n==0 && !withDC) /* discard DC and keep Nyquist */
-            {
-                ++n;
-            }
-#ifdef USE_OOURA
-			/*
-			if(n==1 && withDC) // discard Nyquist
-			{
-				++n;
-			}
-			*/
-			// OOURA discards the always 0 imaginary of DC and Nyquists
-			if (n == M && !withDC)
-			{
-				real = fft[1];
-				imag = 0.0;
-			}
-			else if (n == 0 && withDC) {
-				real = fft[0];
-				imag = 0.0;
-			}
-			else {
-				real = fft[n * 2];
-				imag = fft[n * 2 + 1];
-			}
-#else
-            if (n == M && !withDC)
-            {
-                real = fft->imagp[0];
-                imag = 0.0;
-            }
-            else if (n == 0 && withDC) {
-                real = fft->realp[0];
-                imag = 0.0;
-            }
-            else {
-                real = fft->realp[n];
-                imag = fft->imagp[n];
-            }
-#endif
+        XTRACT_SPECTRUM_BINS(
             result[m] = sqrt(XTRACT_SQ(real) + XTRACT_SQ(imag)) / (double)N;
             XTRACT_SET_FREQUENCY;
-            XTRACT_GET_MAX;
-        }
+            XTRACT_GET_MAX);
         break;
     }
 
@@ -397,35 +150,109 @@ int xtract_spectrum(const double *data, const int N, const void *argv, double *r
                 result[n] /= max;
         }
     }
+}
 
-#ifdef USE_OOURA
-    free(fft);
-#endif
+int xtract_spectrum(const double *data, const int N, const void *argv, double *result)
+{
+    return xtract_spectrum_batch_ctx(&xtract_thread_context, data, N, 1, N, argv, result);
+}
+
+int xtract_spectrum_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    return xtract_spectrum_batch_ctx(ctx, data, N, 1, N, argv, result);
+}
+
+int xtract_spectrum_batch(const double *data, const int N, const int frames, const int hop, const void *argv, double *result)
+{
+    return xtract_spectrum_batch_ctx(&xtract_thread_context, data, N, frames, hop, argv, result);
+}
+
+int xtract_spectrum_batch_ctx(xtract_context *ctx, const double *data, const int N, const int frames, const int hop, const void *argv, double *result)
+{
+
+    int vector     = 0;
+    int withDC     = 0;
+    int normalise  = 0;
+    double q        = 0.0;
+    int frame = 0;
+    double *fft = NULL;
+    const xtract_fft_plan *plan = NULL;
+
+    q = *(double *)argv;
+    vector = (int)*((double *)argv+1);
+    withDC = (int)*((double *)argv+2);
+    normalise = (int)*((double *)argv+3);
+
+    XTRACT_CHECK_q;
+    if(!ctx->fft_data_spectrum.initialised)
+    {
+        fprintf(stderr,
+                "libxtract: error: xtract_spectrum() failed, "
+                "fft data unitialised.\n");
+        return XTRACT_NO_RESULT;
+    }
+
+    if(frames < 0 || hop < 0)
+        return XTRACT_BAD_ARGV;
+
+    plan = xtract_context_fft_plan(ctx, &ctx->fft_data_spectrum, N, XTRACT_FFT_REAL);
+    if(plan == NULL)
+        return XTRACT_BAD_VECTOR_SIZE;
+
+    fft = xtract_context_work(ctx, XTRACT_WORK_FFT, N);
+    if(fft == NULL)
+        return XTRACT_MALLOC_FAILED;
+
+    for(frame = 0; frame < frames; ++frame, data += hop, result += N)
+    {
+        /* the FFT is in-place
+         * the output format is
+         * a[0] - DC, a[1] - nyquist, a[2...N-1] - remaining bins
+         */
+        memcpy(fft, data, N * sizeof(double));
+        if(xtract_context_rdft(ctx, plan, 1, fft) != XTRACT_SUCCESS)
+            return XTRACT_MALLOC_FAILED;
+        spectrum_from_fft(fft, fft + 1, 2, N, vector, withDC, normalise, q, result);
+    }
 
     return XTRACT_SUCCESS;
 }
 
 int xtract_autocorrelation_fft(const double *data, const int N, const void *argv, double *result)
+{
+    return xtract_autocorrelation_fft_ctx(&xtract_thread_context, data, N, argv, result);
+}
+
+int xtract_autocorrelation_fft_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
 {
 
     int n        = 0;
     int M        = N << 1;
 
-#ifdef USE_OOURA
     double *rfft = NULL;
-#else
-    DSPDoubleSplitComplex *fft = NULL;
-    double M_double = 0.0;
-#endif
+    const xtract_fft_plan *plan = NULL;
 
+    if(!ctx->fft_data_autocorrelation_fft.initialised)
+    {
+        fprintf(stderr,
+                "libxtract: error: xtract_autocorrelation_fft() failed, "
+                "fft data unitialised.\n");
+        return XTRACT_NO_RESULT;
+    }
+
+    plan = xtract_context_fft_plan(ctx, &ctx->fft_data_autocorrelation_fft, M, XTRACT_FFT_REAL);
+    if(plan == NULL)
+        return XTRACT_BAD_VECTOR_SIZE;
 
-#ifdef USE_OOURA
     /* Zero pad the input vector */
-    rfft = (double *)calloc(M, sizeof(double));
+    rfft = xtract_context_work(ctx, XTRACT_WORK_FFT, M);
+    if(rfft == NULL)
+        return XTRACT_MALLOC_FAILED;
     memcpy(rfft, data, N * sizeof(double));
+    memset(rfft + N, 0, (M - N) * sizeof(double));
     
-    rdft(M, 1, rfft, ooura_data_autocorrelation_fft.ooura_ip, 
-            ooura_data_autocorrelation_fft.ooura_w);
+    if(xtract_context_rdft(ctx, plan, 1, rfft) != XTRACT_SUCCESS)
+        return XTRACT_MALLOC_FAILED;
 
     for(n = 2; n < M; n += 2)
     {
@@ -436,40 +263,14 @@ int xtract_autocorrelation_fft(const double *data, const int N, const void *argv
     rfft[0] = XTRACT_SQ(rfft[0]);
     rfft[1] = XTRACT_SQ(rfft[1]);
 
-    rdft(M, -1, rfft, ooura_data_autocorrelation_fft.ooura_ip,
-            ooura_data_autocorrelation_fft.ooura_w);
-
-#else
-    /* vDSP has its own autocorrelation function, but it doesn't fit the 
-     * LibXtract model, e.g. we can't guarantee it's going to use
-     * an FFT for all values of N */
-    fft = &vdsp_data_autocorrelation_fft.fft;
-    vDSP_ctozD((DSPDoubleComplex *)data, 2, fft, 1, N);
-    vDSP_fft_zripD(vdsp_data_autocorrelation_fft.setup, fft, 1, 
-            vdsp_data_autocorrelation_fft.log2N, FFT_FORWARD);
-
-    for(n = 0; n < N; ++n)
-    {
-        fft->realp[n] = XTRACT_SQ(fft->realp[n]) + XTRACT_SQ(fft->imagp[n]);
-        fft->imagp[n] = 0.0;
-    }
-
-    vDSP_fft_zripD(vdsp_data_autocorrelation_fft.setup, fft, 1, 
-            vdsp_data_autocorrelation_fft.log2N, FFT_INVERSE);
-#endif
+    if(xtract_context_rdft(ctx, plan, -1, rfft) != XTRACT_SUCCESS)
+        return XTRACT_MALLOC_FAILED;
 
     /* Normalisation factor */
     M = M * N;
 
-#ifdef USE_OOURA
     for(n = 0; n < N; n++)
         result[n] = rfft[n] / (double)M;
-    free(rfft);
-#else
-    M_double = (double)M;
-    vDSP_ztocD(fft, 1, (DOUBLE_COMPLEX *)result, 2, N);
-    vDSP_vsdivD(result, 1, &M_double, result, 1, N);
-#endif
 
     return XTRACT_SUCCESS;
 }
@@ -477,16 +278,15 @@ int xtract_autocorrelation_fft(const double *data, const int N, const void *argv
 static int filterbank_spectrogram(const double *data, const int N, const xtract_mel_filter *f, double *result)
 {
 
-    int n, filter;
+    const double *band;
+    int n, filter, start, length;
 
     for(filter = 0; filter < f->n_filters; filter++)
     {
+        band = xtract_filter_band(f, filter, N, &start, &length);
         result[filter] = 0.0;
-        for(n = 0; n < N; n++)
-        {
-            if(f->filters[filter][n] != 0)
-                result[filter] += data[n] * f->filters[filter][n];
-        }
+        for(n = 0; n < length; n++)
+            result[filter] += data[start + n] * band[n];
         if(result[filter] < XTRACT_LOG_LIMIT)
             result[filter] = XTRACT_LOG_LIMIT_DB;
         else
@@ -496,20 +296,18 @@ static int filterbank_spectrogram(const double *data, const int N, const xtract_
     return XTRACT_SUCCESS;
 }
 
-static int cepstral_coefficients(const double *data, const int N, const xtract_mel_filter *f, double *result)
+static int cepstral_coefficients(xtract_context *ctx, const double *data, const int N, const xtract_mel_filter *f, double *result)
 {
 
     double *temp;
 
-    temp = (double *)calloc(f->n_filters, sizeof(double));
+    temp = xtract_context_work(ctx, XTRACT_WORK_CEPSTRUM, f->n_filters);
     if(temp == NULL)
         return XTRACT_MALLOC_FAILED;
 
     filterbank_spectrogram(data, N, f, temp);
-    xtract_dct(temp, f->n_filters, NULL, result);
-    free(temp);
 
-    return XTRACT_SUCCESS;
+    return xtract_dct_ctx(ctx, temp, f->n_filters, NULL, result);
 }
 
 int xtract_mel_spectrogram(const double *data, const int N, const void *argv, double *result)
@@ -519,7 +317,12 @@ int xtract_mel_spectrogram(const double *data, const int N, const void *argv, do
 
 int xtract_mfcc(const double *data, const int N, const void *argv, double *result)
 {
-    return cepstral_coefficients(data, N, (const xtract_mel_filter *)argv, result);
+    return cepstral_coefficients(&xtract_thread_context, data, N, (const xtract_mel_filter *)argv, result);
+}
+
+int xtract_mfcc_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    return cepstral_coefficients(ctx, data, N, (const xtract_mel_filter *)argv, result);
 }
 
 int xtract_gammatone_spectrogram(const double *data, const int N, const void *argv, double *result)
@@ -529,14 +332,189 @@ int xtract_gammatone_spectrogram(const double *data, const int N, const void *ar
 
 int xtract_gfcc(const double *data, const int N, const void *argv, double *result)
 {
-    return cepstral_coefficients(data, N, (const xtract_mel_filter *)argv, result);
+    return cepstral_coefficients(&xtract_thread_context, data, N, (const xtract_mel_filter *)argv, result);
+}
+
+int xtract_gfcc_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    return cepstral_coefficients(ctx, data, N, (const xtract_mel_filter *)argv, result);
+}
+
+struct xtract_cepstrum_state_
+{
+    int N;
+    int spectrum_type;
+    xtract_mel_filter filter;       /* sparse copy, freed with xtract_free_mel_filter() */
+    const xtract_fft_plan *fft_plan;
+    const xtract_fft_plan *dct_plan;
+    double *window;
+    double *fft;                    /* N, then the FFT backend scratch */
+    double *spectrum;               /* N, bins then frequencies */
+    double *dct_work;
+};
+
+/* Make a sparse copy of the first M bins of filter in copy */
+static int cepstrum_copy_filter(const xtract_mel_filter *filter, int M, xtract_mel_filter *copy)
+{
+    const double *band;
+    int n, k, start, length;
+    size_t total = 0;
+    double *w;
+
+    copy->n_filters = filter->n_filters;
+    copy->filters = NULL;
+    copy->start = (int *)malloc(2 * filter->n_filters * sizeof(int));
+    copy->weights = (double **)malloc(filter->n_filters * sizeof(double *));
+
+    if(copy->start == NULL || copy->weights == NULL)
+    {
+        free(copy->start);
+        free(copy->weights);
+        copy->start = NULL;
+        copy->weights = NULL;
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    copy->length = copy->start + filter->n_filters;
+
+    /* Trim the zeros at either end of each filter */
+    for(n = 0; n < filter->n_filters; n++)
+    {
+        band = xtract_filter_band(filter, n, M, &start, &length);
+
+        for(k = 0; k < length && band[k] == 0.0; k++)
+            ;
+        for(; length > k && band[length - 1] == 0.0; length--)
+            ;
+
+        copy->start[n] = start + k;
+        copy->length[n] = length - k;
+        total += length - k;
+    }
+
+    w = (double *)malloc((total > 0 ? total : 1) * sizeof(double));
+
+    if(w == NULL)
+    {
+        copy->weights[0] = NULL;
+        xtract_free_mel_filter(copy);
+        return XTRACT_MALLOC_FAILED;
+    }
+
+    for(n = 0; n < filter->n_filters; n++)
+    {
+        band = xtract_filter_band(filter, n, M, &start, &length);
+        copy->weights[n] = w;
+        memcpy(w, band + copy->start[n] - start, copy->length[n] * sizeof(double));
+        w += copy->length[n];
+    }
+
+    return XTRACT_SUCCESS;
+}
+
+xtract_cepstrum_state *xtract_cepstrum_state_new(int N, int window_type, int spectrum_type, const xtract_mel_filter *filter)
+{
+    xtract_cepstrum_state *state;
+    size_t fft_size;
+
+    if(N < 2 || N & 1 || filter == NULL || filter->n_filters < 1)
+    {
+        fprintf(stderr, "libxtract: error: xtract_cepstrum_state_new(): invalid arguments\n");
+        return NULL;
+    }
+
+    state = (xtract_cepstrum_state *)calloc(1, sizeof(xtract_cepstrum_state));
+
+    if(state == NULL)
+    {
+        perror("could not allocate memory for xtract_cepstrum_state");
+        return NULL;
+    }
+
+    state->N = N;
+    state->spectrum_type = spectrum_type;
+    state->fft_plan = xtract_fft_plan_get(N, XTRACT_FFT_REAL);
+    state->dct_plan = xtract_fft_plan_get(filter->n_filters, XTRACT_FFT_DCT);
+
+    if(state->fft_plan == NULL || state->dct_plan == NULL ||
+            cepstrum_copy_filter(filter, N >> 1, &state->filter) != XTRACT_SUCCESS)
+    {
+        xtract_cepstrum_state_delete(state);
+        return NULL;
+    }
+
+    fft_size = N + state->fft_plan->work_size;
+    state->window = xtract_init_window(N, window_type);
+    state->fft = (double *)malloc(fft_size * sizeof(double));
+    state->spectrum = (double *)malloc(N * sizeof(double));
+    state->dct_work = (double *)malloc((state->dct_plan->work_size + 1) * sizeof(double));
+
+    if(state->window == NULL || state->fft == NULL || state->spectrum == NULL || state->dct_work == NULL)
+    {
+        perror("could not allocate memory for xtract_cepstrum_state");
+        xtract_cepstrum_state_delete(state);
+        return NULL;
+    }
+
+    return state;
+}
+
+void xtract_cepstrum_state_delete(xtract_cepstrum_state *state)
+{
+    if(state == NULL)
+        return;
+
+    /* The plans belong to the plan cache */
+    if(state->filter.start != NULL)
+        xtract_free_mel_filter(&state->filter);
+    free(state->window);
+    free(state->fft);
+    free(state->spectrum);
+    free(state->dct_work);
+    free(state);
+}
+
+int xtract_cepstrum(xtract_cepstrum_state *state, const double *data, const int N, const void *argv, double *result)
+{
+    return xtract_cepstrum_batch(state, data, N, 1, N, argv, result);
+}
+
+int xtract_cepstrum_batch(xtract_cepstrum_state *state, const double *data, const int N, const int frames, const int hop, const void *argv, double *result)
+{
+    const int n_filters = state->filter.n_filters;
+    double *fft = state->fft;
+    double *work = state->fft_plan->work_size > 0 ? state->fft + N : NULL;
+    int frame, n;
+
+    if(N != state->N)
+    {
+        fprintf(stderr, "libxtract: error: xtract_cepstrum(): inconsistent size\n");
+        return XTRACT_BAD_STATE;
+    }
+
+    if(frames < 0 || hop < 0)
+        return XTRACT_BAD_ARGV;
+
+    for(frame = 0; frame < frames; ++frame, data += hop, result += n_filters)
+    {
+        for(n = 0; n < N; ++n)
+            fft[n] = data[n] * state->window[n];
+
+        state->fft_plan->backend->rdft(state->fft_plan, 1, fft, work);
+        spectrum_from_fft(fft, fft + 1, 2, N, state->spectrum_type, 0, 0, 0.0, state->spectrum);
+        filterbank_spectrogram(state->spectrum, N >> 1, &state->filter, result);
+        state->dct_plan->backend->dct(state->dct_plan, result, state->dct_work);
+    }
+
+    return XTRACT_SUCCESS;
 }
 
 int xtract_mmbses(const double *data, const int N, const void *argv, double *result)
 {
     /* NOTE: data must contain 2*N doubles (N complex pairs as real/imag interleaved) */
     xtract_mel_filter *f;
-    int n, filter;
+    const double *band;
+    int n, filter, start, length;
     double* real = (double*)malloc(sizeof(double)*N);
     double* imag = (double*)malloc(sizeof(double)*N);
 
@@ -558,12 +536,13 @@ int xtract_mmbses(const double *data, const int N, const void *argv, double *res
         double energy = 0;
 
         result[filter] = 0.0;
-        for(n = 0; n < N; n++)
+        band = xtract_filter_band(f, filter, N, &start, &length);
+        for(n = 0; n < length; n++)
         {
-          double tempReal = data[n*2]*f->filters[filter][n];
-          double tempImag = data[n*2+1]*f->filters[filter][n];
+          double tempReal = data[(start + n)*2]*band[n];
+          double tempImag = data[(start + n)*2+1]*band[n];
 
-            if (f->filters[filter][n] != 0)
+            if (band[n] != 0)
             {
                 real[count] = tempReal;
                 imag[count] = tempImag;
@@ -627,7 +606,8 @@ int xtract_mmbses(const double *data, const int N, const void *argv, double *res
 int xtract_spectral_subband_centroids(const double *data, const int N, const void *argv, double *result)
 {
     xtract_mel_filter *f = (xtract_mel_filter *)argv;
-    int n, filter;
+    const double *band;
+    int n, filter, start, length;
     const double *freqs = data;
     const double *amps = data+N;
 
@@ -635,11 +615,12 @@ int xtract_spectral_subband_centroids(const double *data, const int N, const voi
     {
         double FA = 0.0, A = 0.0;
 
-        for(n = 0; n < N; n++)
+        band = xtract_filter_band(f, filter, N, &start, &length);
+        for(n = 0; n < length; n++)
         {
-            double Multiplier = amps[n]*f->filters[filter][n];
+            double Multiplier = amps[start + n]*band[n];
 
-            FA += freqs[n]*f->filters[filter][n]*Multiplier;
+            FA += freqs[start + n]*band[n]*Multiplier;
             A += Multiplier;
         }
         if (FA == 0.0 || A == 0.0)
@@ -652,110 +633,187 @@ int xtract_spectral_subband_centroids(const double *data, const int N, const voi
 
 int xtract_dct(const double *data, const int N, const void *argv, double *result)
 {
-    int n, m;
-    // Extra variable to hold a reference for the dct lookup table since
-    // accessing the thread local storage is expensive.
-    double** temp_dct_table;
+    return xtract_dct_ctx(&xtract_thread_context, data, N, argv, result);
+}
 
-    // Free the dct table if the cached dimension is different from the new dimension
-    if (dct_cos_table != NULL && dct_cos_table_dim != N)
-    {
-        for (n = 0; n < dct_cos_table_dim; ++n)
-        {
-          free(dct_cos_table[n]);
-        }
-        free(dct_cos_table);
-        dct_cos_table = NULL;
-    }
-    // Allocate the dct cache table
-    if (dct_cos_table == NULL)
-    {
-        dct_cos_table_dim = N;
-        dct_cos_table = calloc(N, sizeof(double*));
-        for (n = 0; n < N; ++n)
-        {
-            dct_cos_table[n] = calloc(N, sizeof(double));
-            for (m = 1; m <= N; ++m)
-            {
-                dct_cos_table[n][m-1] = cos(M_PI * (n / (double)N)*(m - 0.5));
-            }
-        }
-    }
-    // Calculate the dct transformation
-    temp_dct_table = dct_cos_table;
-    memset(result, 0, N * sizeof(double));
-    for (n = 0; n < N; ++n)
-    {
-        for (m = 0; m < N; ++m)
-            result[n] += data[m]*temp_dct_table[n][m];
-    }
+int xtract_dct_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    const xtract_fft_plan *plan;
 
-    return XTRACT_SUCCESS;
+    /* DCT plans are cached per size, so no initialisation is needed */
+    plan = xtract_context_fft_plan(ctx, &ctx->fft_data_dct, N, XTRACT_FFT_DCT);
+    if(plan == NULL)
+        return XTRACT_BAD_VECTOR_SIZE;
+
+    memmove(result, data, N * sizeof(double));
+
+    return xtract_context_dct(ctx, plan, result);
 }
 
 int xtract_autocorrelation(const double *data, const int N, const void *argv, double *result)
 {
+    xtract_simd->lags(XTRACT_LAGS_PRODUCT, data, N, 0, N - 1, result);
 
-    /* Naive time domain implementation  */
+    return XTRACT_SUCCESS;
+}
 
-    int n = N, i;
+int xtract_amdf(const double *data, const int N, const void *argv, double *result)
+{
+    xtract_simd->lags(XTRACT_LAGS_ABS_DIFF, data, N, 0, N - 1, result);
 
-    double corr;
+    return XTRACT_SUCCESS;
+}
 
-    while(n--)
+int xtract_asdf(const double *data, const int N, const void *argv, double *result)
+{
+    xtract_simd->lags(XTRACT_LAGS_SQ_DIFF, data, N, 0, N - 1, result);
+
+    return XTRACT_SUCCESS;
+}
+
+/* Read and check the {min_lag, max_lag} argument of the lag range functions */
+static int lag_range(const int N, const void *argv, int *min_lag, int *max_lag)
+{
+    const double *lags = (const double *)argv;
+
+    if(argv == NULL)
+        return XTRACT_BAD_ARGV;
+
+    /* Written so that NaN fails too, before the lags are converted */
+    if(!(lags[0] >= 0.0 && lags[0] <= lags[1] && lags[1] < N))
+        return XTRACT_BAD_ARGV;
+
+    *min_lag = (int)lags[0];
+    *max_lag = (int)lags[1];
+
+    return XTRACT_SUCCESS;
+}
+
+/* Whether a lag range is cheaper to compute from an FFT of at least
+ * N + max_lag + 1 samples than directly. The direct method costs about one
+ * multiply-add per sample and lag, the FFT method about XTRACT_LAGS_FFT_COST
+ * per sample and octave of FFT size */
+static int lags_use_fft(const int N, const int min_lag, const int max_lag)
+{
+    double direct, fft;
+    int M = xtract_fft_fast_size(N + max_lag + 1);
+
+    direct = (double)(max_lag - min_lag + 1) * (N - (min_lag + max_lag) / 2);
+    fft = XTRACT_LAGS_FFT_COST * M * log2(M);
+
+    return direct > fft;
+}
+
+int xtract_autocorrelation_lags(const double *data, const int N, const void *argv, double *result)
+{
+    return xtract_autocorrelation_lags_ctx(&xtract_thread_context, data, N, argv, result);
+}
+
+int xtract_autocorrelation_lags_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    double *r;
+    int min_lag, max_lag, lag, rv;
+
+    rv = lag_range(N, argv, &min_lag, &max_lag);
+    if(rv != XTRACT_SUCCESS)
+        return rv;
+
+    if(!lags_use_fft(N, min_lag, max_lag))
     {
-        corr = 0;
-        for(i = 0; i < N - n; i++)
-        {
-            corr += data[i] * data[i + n];
-        }
-        result[n] = corr / N;
+        xtract_simd->lags(XTRACT_LAGS_PRODUCT, data, N, min_lag, max_lag, result);
+        return XTRACT_SUCCESS;
     }
 
+    rv = xtract_context_autocorrelation(ctx, data, N, max_lag + 1, &r);
+    if(rv != XTRACT_SUCCESS)
+        return rv;
+
+    for(lag = min_lag; lag <= max_lag; lag++)
+        result[lag - min_lag] = r[lag] / N;
+
     return XTRACT_SUCCESS;
 }
 
-int xtract_amdf(const double *data, const int N, const void *argv, double *result)
+int xtract_amdf_lags(const double *data, const int N, const void *argv, double *result)
 {
+    int min_lag, max_lag, rv;
 
-    int n = N, i;
+    rv = lag_range(N, argv, &min_lag, &max_lag);
+    if(rv != XTRACT_SUCCESS)
+        return rv;
 
-    double md, temp;
+    xtract_simd->lags(XTRACT_LAGS_ABS_DIFF, data, N, min_lag, max_lag, result);
 
-    while(n--)
+    return XTRACT_SUCCESS;
+}
+
+/* ASDF(lag) = e_head(lag) + e_tail(lag) - 2 r(lag), divided by N, where
+ * e_head and e_tail are the energies of the first and last N - lag samples,
+ * kept as running sums, and r is the autocorrelation taken by FFT */
+static int asdf_fft(xtract_context *ctx, const double *data, const int N, const int min_lag, const int max_lag, double *result)
+{
+    double *r;
+    double e_head, e_tail;
+    int lag, n, rv;
+
+    rv = xtract_context_autocorrelation(ctx, data, N, max_lag + 1, &r);
+    if(rv != XTRACT_SUCCESS)
+        return rv;
+
+    e_head = 0.0;
+    for(n = 0; n < N; n++)
+        e_head += XTRACT_SQ(data[n]);
+    e_tail = e_head;
+
+    for(lag = 0; lag <= max_lag; lag++)
     {
-        md = 0.0;
-        for(i = 0; i < N - n; i++)
+        if(lag > 0)
         {
-            temp = data[i] - data[i + n];
-            temp = (temp < 0 ? -temp : temp);
-            md += temp;
+            e_head -= XTRACT_SQ(data[N - lag]);
+            e_tail -= XTRACT_SQ(data[lag - 1]);
         }
-        result[n] = md / (double)N;
+
+        /* Rounding can take a zero difference slightly below zero */
+        if(lag >= min_lag)
+            result[lag - min_lag] = XTRACT_MAX(0.0, e_head + e_tail - 2.0 * r[lag]) / N;
     }
 
     return XTRACT_SUCCESS;
 }
 
-int xtract_asdf(const double *data, const int N, const void *argv, double *result)
+int xtract_asdf_lags(const double *data, const int N, const void *argv, double *result)
 {
+    return xtract_asdf_lags_ctx(&xtract_thread_context, data, N, argv, result);
+}
 
-    int n = N, i;
+int xtract_asdf_lags_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    int min_lag, max_lag, rv;
 
-    double sd;
+    rv = lag_range(N, argv, &min_lag, &max_lag);
+    if(rv != XTRACT_SUCCESS)
+        return rv;
 
-    while(n--)
+    if(!lags_use_fft(N, min_lag, max_lag))
     {
-        sd = 0.0;
-        for(i = 0; i < N - n; i++)
-        {
-            /*sd = 1;*/
-            sd += XTRACT_SQ(data[i] - data[i + n]);
-        }
-        result[n] = sd / (double)N;
+        xtract_simd->lags(XTRACT_LAGS_SQ_DIFF, data, N, min_lag, max_lag, result);
+        return XTRACT_SUCCESS;
     }
 
-    return XTRACT_SUCCESS;
+    return asdf_fft(ctx, data, N, min_lag, max_lag, result);
+}
+
+int xtract_asdf_fft(const double *data, const int N, const void *argv, double *result)
+{
+    return xtract_asdf_fft_ctx(&xtract_thread_context, data, N, argv, result);
+}
+
+int xtract_asdf_fft_ctx(xtract_context *ctx, const double *data, const int N, const void *argv, double *result)
+{
+    if(N < 1)
+        return XTRACT_BAD_VECTOR_SIZE;
+
+    return asdf_fft(ctx, data, N, 0, N - 1, result);
 }
 
 int xtract_bark_coefficients(const double *data, const int N, const void *argv, double *result)
@@ -204,3 +204,12 @@ void blackman_harris(double *window, const int N)
         window[n] = a0 - term1 + term2 - term3;
     }
 }
+
+void rectangular(double *window, const int N)
+{
+
+    int n;
+
+    for (n = 0; n < N; n++)
+        window[n] = 1.0;
+}
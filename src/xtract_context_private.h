@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* xtract_context_private.h: defines the layout of xtract_context */
+
+#ifndef XTRACT_CONTEXT_PRIVATE_H
+#define XTRACT_CONTEXT_PRIVATE_H
+
+#include <stddef.h>
+
+#include "fft.h"
+#include "dywapitchtrack/dywapitchtrack.h"
+#include "xtract/xtract_context.h"
+
+#define XTRACT_CONTEXT_RECENT_PLANS 8
+
+/* Work buffers owned by a context. Functions that call one another use
+ * different slots, so a buffer is never in use twice at the same time */
+enum xtract_context_work_
+{
+    XTRACT_WORK_FFT,            /* in-place FFT buffer for spectrum and autocorrelation, and xtractf_dct() */
+    XTRACT_WORK_FFT_BACKEND,    /* scratch memory for the FFT backend */
+    XTRACT_WORK_CEPSTRUM,       /* filterbank output for mfcc and gfcc */
+    XTRACT_WORK_F0_INPUT,       /* clipped copy of the input for xtract_f0(), decimated input for xtract_wavelet_f0() */
+    XTRACT_WORK_F0_SPECTRUM,    /* spectrum for the xtract_failsafe_f0() fallback */
+    XTRACT_WORK_F0_PEAKS,       /* peaks for the xtract_failsafe_f0() fallback */
+    XTRACT_WORK_YIN,            /* transform of the lag window for xtract_yin_f0() */
+    XTRACT_WORK_WAVELET,        /* extrema and distance histogram for xtract_wavelet_f0() */
+    XTRACT_CONTEXT_WORK_BUFFERS
+};
+
+struct xtract_context_
+{
+    xtract_fft_data fft_data_dct;
+    xtract_fft_data fft_data_mfcc;
+    xtract_fft_data fft_data_spectrum;
+    xtract_fft_data fft_data_autocorrelation_fft;
+    /* Bound on demand by xtractf_spectrum() once XTRACT_SPECTRUM is initialised */
+    xtract_fft_data fft_data_spectrum_float;
+
+    /* Plans most recently bound in this context, so that alternating between
+     * a few sizes doesn't need to take the plan cache lock */
+    const xtract_fft_plan *recent_plans[XTRACT_CONTEXT_RECENT_PLANS];
+    int recent_plans_next;
+
+    dywapitchtracker wavelet_f0_state;
+
+    /* Work memory, grown on demand and kept between calls so that steady
+     * state processing doesn't allocate */
+    double *work[XTRACT_CONTEXT_WORK_BUFFERS];
+    size_t work_size[XTRACT_CONTEXT_WORK_BUFFERS];
+};
+
+/* Return at least n doubles of the work buffer in the given slot of ctx, or
+ * NULL if it could not be allocated. The contents are undefined on return and
+ * are only valid until the next call that uses the same slot */
+double *xtract_context_work(xtract_context *ctx, int slot, size_t n);
+
+/* As xtract_context_work(), but returning at least n floats */
+float *xtract_context_workf(xtract_context *ctx, int slot, size_t n);
+
+/* As xtract_context_work(), but returning at least n ints */
+int *xtract_context_worki(xtract_context *ctx, int slot, size_t n);
+
+/* Return the plan of size N and the given kind for fft_data, binding it first
+ * if fft_data currently holds a plan of a different size or backend. Returns
+ * NULL if N is odd or the plan could not be created */
+const xtract_fft_plan *xtract_context_fft_plan(xtract_context *ctx, xtract_fft_data *fft_data, int N, int kind);
+
+/* Run plan's real FFT in place on a, using the backend scratch memory of ctx.
+ * Returns XTRACT_MALLOC_FAILED if the scratch memory could not be allocated */
+int xtract_context_rdft(xtract_context *ctx, const xtract_fft_plan *plan, int isgn, double *a);
+
+/* As xtract_context_rdft() for single precision plans */
+int xtract_context_rdftf(xtract_context *ctx, const xtract_fft_plan *plan, int isgn, float *a);
+
+/* Run the DCT of an XTRACT_FFT_DCT plan in place on a, as xtract_context_rdft() */
+int xtract_context_dct(xtract_context *ctx, const xtract_fft_plan *plan, double *a);
+
+/* Compute r(tau) = sum_{i < N - tau} data[i] * data[i + tau] for tau < lags
+ * with a real FFT of N + lags samples, bound to the autocorrelation fft_data
+ * of ctx. On success *r points to the lags values in the XTRACT_WORK_FFT slot
+ * of ctx */
+int xtract_context_autocorrelation(xtract_context *ctx, const double *data, int N, int lags, double **r);
+
+/* Free everything owned by ctx without freeing ctx itself */
+void xtract_context_release(xtract_context *ctx);
+
+#endif /* Header guard */
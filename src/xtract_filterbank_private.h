@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* xtract_filterbank_private.h: access to the filters of an xtract_mel_filter */
+
+#ifndef XTRACT_FILTERBANK_PRIVATE_H
+#define XTRACT_FILTERBANK_PRIVATE_H
+
+#include "xtract/libxtract.h"
+
+/* Return the coefficients of filter k of f for a spectrum of N bins and set
+ * *start and *length to the bins they apply to, for either the dense or the
+ * sparse form of xtract_mel_filter */
+static inline const double *xtract_filter_band(const xtract_mel_filter *f, int k, int N, int *start, int *length)
+{
+    if(f->filters != NULL)
+    {
+        *start = 0;
+        *length = N;
+        return f->filters[k];
+    }
+
+    *start = f->start[k];
+    *length = f->start[k] >= N ? 0 : f->length[k] < N - f->start[k] ? f->length[k] : N - f->start[k];
+
+    return f->weights[k];
+}
+
+#endif /* Header guard */
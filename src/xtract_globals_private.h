@@ -26,8 +26,7 @@
 #ifndef XTRACT_GLOBALS_PRIVATE_H
 #define XTRACT_GLOBALS_PRIVATE_H
 
-#include "fft.h"
-#include "dywapitchtrack/dywapitchtrack.h"
+#include "xtract_context_private.h"
 
 #ifdef __cplusplus
 #define GLOBAL extern "C"
@@ -55,19 +54,8 @@
 # endif
 #endif
 
-#ifdef USE_OOURA
-GLOBAL thread_local struct xtract_ooura_data_ ooura_data_dct;
-GLOBAL thread_local struct xtract_ooura_data_ ooura_data_mfcc;
-GLOBAL thread_local struct xtract_ooura_data_ ooura_data_spectrum;
-GLOBAL thread_local struct xtract_ooura_data_ ooura_data_autocorrelation_fft;
-#else
-GLOBAL thread_local xtract_vdsp_data vdsp_data_dct;
-GLOBAL thread_local xtract_vdsp_data vdsp_data_mfcc;
-GLOBAL thread_local xtract_vdsp_data vdsp_data_spectrum;
-GLOBAL thread_local xtract_vdsp_data vdsp_data_autocorrelation_fft;
-#endif
-
-GLOBAL thread_local dywapitchtracker wavelet_f0_state;
+/* The context used by the functions that do not take one explicitly */
+GLOBAL thread_local xtract_context xtract_thread_context;
 
 
 #endif /* Header guard */
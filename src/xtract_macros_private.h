@@ -42,6 +42,8 @@
 #define XTRACT_SR_LOWER_LIMIT 22050.0
 #define XTRACT_SR_DEFAULT 44100.0
 #define XTRACT_FUNDAMENTAL_DEFAULT 440.0
+#define XTRACT_YIN_THRESHOLD_DEFAULT 0.1
+#define XTRACT_LAGS_FFT_COST 4.0 /* relative cost of an FFT lag computation, see lags_use_fft() */
 #define XTRACT_CHECK_nyquist if(!nyquist) nyquist = XTRACT_SR_DEFAULT / 2
 #define XTRACT_CHECK_q if(!q) q = XTRACT_SR_DEFAULT / N
 #define XTRACT_GET_MAX max = result[m] > max ? result[m] : max
@@ -57,4 +59,21 @@
 #define XTRACT_SPEC_BW_DEF 43.066 /* SR_DEFAULT / FFT_BANDS_DEF */
 #define XTRACT_ARRAY_ELEMENTS(_array) (sizeof(_array)/sizeof(_array[0]))
 
+/* Run STORE for every output bin of a packed real FFT. Bins 1 to M - 1 are
+ * handled in a branch free loop, then DC or Nyquist, whichever is kept, is
+ * peeled out since its imaginary part isn't stored in the packed format */
+#define XTRACT_SPECTRUM_BINS(STORE) \
+    for(n = 1; n < M; ++n) \
+    { \
+        real = re[n * stride]; \
+        imag = im[n * stride]; \
+        m = n - offset; \
+        STORE; \
+    } \
+    n = withDC ? 0 : M; \
+    real = withDC ? re[0] : im[0]; \
+    imag = 0.0; \
+    m = n - offset; \
+    STORE
+
 #endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* xtract_simd_private.h: declares the kernels that are compiled for several
+ * instruction sets, with the best one chosen for the running CPU */
+
+#ifndef XTRACT_SIMD_PRIVATE_H
+#define XTRACT_SIMD_PRIVATE_H
+
+#ifdef _MSC_VER
+#define restrict __restrict
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define XTRACT_SIMD_X86_DISPATCH
+#endif
+
+enum xtract_simd_isa_
+{
+    XTRACT_SIMD_GENERIC,
+    XTRACT_SIMD_AVX2,
+    XTRACT_SIMD_AVX512
+};
+
+/* The best instruction set supported by the running CPU */
+int xtract_simd_isa(void);
+
+/* The per lag measures computed by the lags kernel */
+enum xtract_simd_lag_kind_
+{
+    XTRACT_LAGS_PRODUCT,    /* sum of x[i] * x[i + lag], as xtract_autocorrelation() */
+    XTRACT_LAGS_ABS_DIFF,   /* sum of |x[i] - x[i + lag]|, as xtract_amdf() */
+    XTRACT_LAGS_SQ_DIFF     /* sum of (x[i] - x[i + lag])^2, as xtract_asdf() */
+};
+
+/* Kernels for one instruction set. The sums are taken in the same order by
+ * every instruction set, so the choice doesn't change any result */
+typedef struct xtract_simd_kernels_
+{
+    /* Set result[lag - min_lag] to the measure of the given kind over
+     * i < N - lag, divided by N, for each lag from min_lag to max_lag.
+     * Requires 0 <= min_lag <= max_lag < N. Each sum is taken in the same
+     * order as a plain loop over i */
+    void (*lags)(int kind, const double *data, int N, int min_lag, int max_lag, double *result);
+
+    /* Sum of (x[i] - centre)^power, for power 1 to 4 */
+    double (*sum_pow)(const double *x, int N, double centre, int power);
+
+    /* Sum of |x[i] - centre| */
+    double (*sum_abs_dev)(const double *x, int N, double centre);
+
+    /* Store the sums of d, |d|, d^2, d^3 and d^4, where d = x[i] - centre, in
+     * sums[0] to sums[4], in one pass over x */
+    void (*central_sums)(const double *x, int N, double centre, double *sums);
+
+    /* Sum of w[i] * (x[i] - centre)^power, for power 1 to 4, with the sum of
+     * w[i] stored in *weights */
+    double (*weighted_sum_pow)(const double *w, const double *x, int N, double centre, int power, double *weights);
+
+    /* Store the sums of w[i], w[i] * x[i], x[i] and x[i]^2 in sums[0] to
+     * sums[3], in one pass over w and x */
+    void (*spectral_sums)(const double *w, const double *x, int N, double *sums);
+
+    /* Store the sums of w[i] * d^2, w[i] * d^3 and w[i] * d^4, where
+     * d = x[i] - centre, in sums[0] to sums[2] */
+    void (*weighted_central_sums)(const double *w, const double *x, int N, double centre, double *sums);
+
+    /* Sum of (x[i] - x[i + 1])^2 for i < N - 1 */
+    double (*sum_sq_step)(const double *x, int N);
+
+    /* Sum of |x[i] - (x[i - 1] + x[i] + x[i + 1]) / 3| for 0 < i < N - 1 */
+    double (*sum_irregularity_k)(const double *x, int N);
+
+    /* Number of i < N where a[i] * b[i] < 0. Sign changes are counted by
+     * passing x and x + 1 rather than indexing x[i - 1] in the kernel, which
+     * the compiler won't vectorise */
+    double (*count_negative_products)(const double *a, const double *b, int N);
+
+    /* Number of non-zero x[i] */
+    double (*count_nonzero)(const double *x, int N);
+
+    /* Largest x[i], N must be at least 1 */
+    double (*max)(const double *x, int N);
+
+    /* Smallest x[i] above threshold, or DBL_MAX if there is none */
+    double (*min_above)(const double *x, int N, double threshold);
+
+    /* The channel kernels below take blocks of C interleaved channels, with
+     * sample n of channel c at x[n * C + c], and give one result per channel */
+
+    /* Set sums[c] to the sum over n of x[n * C + c] */
+    void (*channels_sum)(const double *x, int N, int C, double *sums);
+
+    /* Set sums[c] to the sum over n of (x[n * C + c] - centre[c])^2, or of
+     * x[n * C + c]^2 if centre is NULL */
+    void (*channels_sum_sq_dev)(const double *x, int N, int C, const double *centre, double *sums);
+
+    /* Set counts[c] to the number of sign changes between successive samples
+     * of channel c, as counted by count_negative_products */
+    void (*channels_count_sign_changes)(const double *x, int N, int C, double *counts);
+
+    /* Set result[c] to the largest sample of channel c, N must be at least 1 */
+    void (*channels_max)(const double *x, int N, int C, double *result);
+
+    /* Set sums[c] to the sum over n of w[n] * x[n * C + c] */
+    void (*channels_weighted_sum)(const double *x, int N, int C, const double *w, double *sums);
+
+    /* Forward real FFT of N = 2M samples in each of C channels. On entry
+     * re[m * C + c] + i * im[m * C + c] holds samples 2m and 2m + 1 of
+     * channel c at m in bit reversed order, for m < M. On return the rows
+     * 0 to M of re and im hold bins 0 to M as e^(-2 pi i n k / N), with the
+     * imaginary parts of bins 0 and M zero. tw holds cos and -sin of
+     * 2 pi j / M for j < M / 2, then cos and -sin of 2 pi k / N for
+     * k <= M / 2 */
+    void (*channels_rdft)(double *re, double *im, int M, int C, const double *tw);
+
+    /* Single precision counterparts of the kernels above of the same name,
+     * for the xtractf_ functions. Their lanes are floats, so twice as many
+     * fit in a vector register */
+
+    float (*sum_powf)(const float *x, int N, float centre, int power);
+    float (*sum_abs_devf)(const float *x, int N, float centre);
+    float (*count_negative_productsf)(const float *a, const float *b, int N);
+    float (*maxf)(const float *x, int N);
+
+    /* Smallest x[i] above threshold, or FLT_MAX if there is none */
+    float (*min_abovef)(const float *x, int N, float threshold);
+} xtract_simd_kernels;
+
+/* The kernels for the running CPU, set by xtract_simd_init() when the library
+ * is loaded. Until then the generic kernels are used */
+extern const xtract_simd_kernels *xtract_simd;
+
+/* Select the kernels for the running CPU */
+void xtract_simd_init(void);
+
+#endif /* Header guard */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2012 Jamie Bullock
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+/* xtract_threads_private.h: minimal portable mutexes, threads and atomic counters for state shared between threads */
+
+#ifndef XTRACT_THREADS_PRIVATE_H
+#define XTRACT_THREADS_PRIVATE_H
+
+#if defined(_MSC_VER) && !defined(__cplusplus)
+#define inline __inline
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+
+typedef SRWLOCK xtract_mutex;
+#define XTRACT_MUTEX_INITIALIZER SRWLOCK_INIT
+
+static inline void xtract_mutex_lock(xtract_mutex *mutex)
+{
+    AcquireSRWLockExclusive(mutex);
+}
+
+static inline void xtract_mutex_unlock(xtract_mutex *mutex)
+{
+    ReleaseSRWLockExclusive(mutex);
+}
+
+static inline void xtract_mutex_init(xtract_mutex *mutex)
+{
+    InitializeSRWLock(mutex);
+}
+
+static inline void xtract_mutex_destroy(xtract_mutex *mutex)
+{
+    (void)mutex;
+}
+
+typedef HANDLE xtract_thread;
+typedef LPTHREAD_START_ROUTINE xtract_thread_fn;
+#define XTRACT_THREAD_FN(name, arg) DWORD WINAPI name(LPVOID arg)
+#define XTRACT_THREAD_RETURN 0
+
+static inline int xtract_thread_create(xtract_thread *thread, xtract_thread_fn fn, void *arg)
+{
+    *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return *thread == NULL;
+}
+
+static inline void xtract_thread_join(xtract_thread thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+static inline void xtract_thread_yield(void)
+{
+    SwitchToThread();
+}
+
+/* A counter written by one thread and read by another. The store publishes
+ * everything written before it to a thread that loads the new value */
+typedef volatile LONG xtract_atomic;
+
+static inline long xtract_atomic_load(xtract_atomic *atomic)
+{
+    return InterlockedCompareExchange(atomic, 0, 0);
+}
+
+static inline void xtract_atomic_store(xtract_atomic *atomic, long value)
+{
+    InterlockedExchange(atomic, value);
+}
+#else
+#include <pthread.h>
+#include <sched.h>
+
+typedef pthread_mutex_t xtract_mutex;
+#define XTRACT_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+
+static inline void xtract_mutex_lock(xtract_mutex *mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+static inline void xtract_mutex_unlock(xtract_mutex *mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+static inline void xtract_mutex_init(xtract_mutex *mutex)
+{
+    pthread_mutex_init(mutex, NULL);
+}
+
+static inline void xtract_mutex_destroy(xtract_mutex *mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+typedef pthread_t xtract_thread;
+typedef void *(*xtract_thread_fn)(void *);
+#define XTRACT_THREAD_FN(name, arg) void *name(void *arg)
+#define XTRACT_THREAD_RETURN NULL
+
+static inline int xtract_thread_create(xtract_thread *thread, xtract_thread_fn fn, void *arg)
+{
+    return pthread_create(thread, NULL, fn, arg);
+}
+
+static inline void xtract_thread_join(xtract_thread thread)
+{
+    pthread_join(thread, NULL);
+}
+
+static inline void xtract_thread_yield(void)
+{
+    sched_yield();
+}
+
+/* A counter written by one thread and read by another. The store publishes
+ * everything written before it to a thread that loads the new value */
+typedef long xtract_atomic;
+
+static inline long xtract_atomic_load(xtract_atomic *atomic)
+{
+    return __atomic_load_n(atomic, __ATOMIC_ACQUIRE);
+}
+
+static inline void xtract_atomic_store(xtract_atomic *atomic, long value)
+{
+    __atomic_store_n(atomic, value, __ATOMIC_RELEASE);
+}
+#endif
+
+#endif /* Header guard */
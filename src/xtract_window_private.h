@@ -99,3 +99,11 @@ void kaiser(double *window, const int N, const double alpha);
  */
 void blackman_harris(double *window, const int N);
 
+/** \brief generate a rectangular window, i.e. all ones
+ *
+ * \param *window a pointer to an array to contain the window data
+ * \param N the number of elements in the array pointed to by *window
+ *
+ */
+void rectangular(double *window, const int N);
+
@@ -10,6 +10,13 @@
 #include "xtract/xtract_macros.h"
 #include "xtract/xtract_delta.h"
 #include "xtract/xtract_stateful.h"
+#include "xtract/xtract_context.h"
+#include "xtract/xtract_plan.h"
+#include "xtract/xtract_stream.h"
+#include "xtract/xtract_engine.h"
+#include "xtract/xtract_pipeline.h"
+#include "xtract/xtract_multichannel.h"
+#include "xtract/xtract_float.h"
 #include "xtract/libxtract.h"
 %}
 
@@ -104,6 +111,13 @@
 
 %include "xtract/xtract_vector.h"
 %include "xtract/xtract_stateful.h"
+%include "xtract/xtract_context.h"
+%include "xtract/xtract_plan.h"
+%include "xtract/xtract_stream.h"
+%include "xtract/xtract_engine.h"
+%include "xtract/xtract_pipeline.h"
+%include "xtract/xtract_multichannel.h"
+%include "xtract/xtract_float.h"
 %include "xtract/xtract_helper.h"
 %include "xtract/xtract_macros.h"
 %include "xtract/libxtract.h"
@@ -0,0 +1,328 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_context.h"
+#include "xttest_util.hpp"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/*
+ * Unit tests for the reentrant xtract_context API.
+ *
+ * The context variants must give exactly the results of the functions that
+ * operate on the per-thread default context.
+ */
+
+TEST_CASE("xtract_context spectra of different sizes", "[context][fft]")
+{
+    double data[512];
+    double expected[512];
+    double actual[512];
+    double argv[] = {44100.0 / 512, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+
+    xttest_gen_sine(data, 512, 44100, 344.53125, 1.0);
+
+    xtract_context *ctx_512 = xtract_context_new();
+    xtract_context *ctx_256 = xtract_context_new();
+    REQUIRE(ctx_512 != NULL);
+    REQUIRE(ctx_256 != NULL);
+
+    REQUIRE(xtract_context_init_fft(ctx_512, 512, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+    REQUIRE(xtract_context_init_fft(ctx_256, 256, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+
+    SECTION("interleaved calls on two contexts match the default context")
+    {
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            xtract_init_fft(512, XTRACT_SPECTRUM);
+            xtract_spectrum(data, 512, argv, expected);
+            xtract_spectrum_ctx(ctx_512, data, 512, argv, actual);
+
+            for (int n = 0; n < 512; ++n)
+                REQUIRE(actual[n] == expected[n]);
+
+            argv[0] = 44100.0 / 256;
+            xtract_init_fft(256, XTRACT_SPECTRUM);
+            xtract_spectrum(data, 256, argv, expected);
+            xtract_spectrum_ctx(ctx_256, data, 256, argv, actual);
+
+            for (int n = 0; n < 256; ++n)
+                REQUIRE(actual[n] == expected[n]);
+
+            argv[0] = 44100.0 / 512;
+        }
+    }
+
+    SECTION("an uninitialised context gives no result")
+    {
+        xtract_context *ctx = xtract_context_new();
+        REQUIRE(xtract_spectrum_ctx(ctx, data, 512, argv, actual) == XTRACT_NO_RESULT);
+        xtract_context_delete(ctx);
+    }
+
+    xtract_free_fft();
+    xtract_context_delete(ctx_512);
+    xtract_context_delete(ctx_256);
+}
+
+TEST_CASE("xtract_context switches FFT size without re-initialising", "[context][fft]")
+{
+    double data[512];
+    double expected[512];
+    double actual[512];
+    double argv[] = {0.0, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+
+    xttest_gen_sine(data, 512, 44100, 344.53125, 1.0);
+
+    xtract_context *reference = xtract_context_new();
+    xtract_context *ctx = xtract_context_new();
+
+    REQUIRE(xtract_context_init_fft(ctx, 512, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+
+    SECTION("sizes used after initialisation match a dedicated context")
+    {
+        for (int frame = 0; frame < 2; ++frame)
+        {
+            for (int N = 512; N >= 64; N >>= 1)
+            {
+                argv[0] = 44100.0 / N;
+                REQUIRE(xtract_context_init_fft(reference, N, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+                xtract_spectrum_ctx(reference, data, N, argv, expected);
+                REQUIRE(xtract_spectrum_ctx(ctx, data, N, argv, actual) == XTRACT_SUCCESS);
+
+                for (int n = 0; n < N; ++n)
+                    REQUIRE(actual[n] == expected[n]);
+            }
+        }
+    }
+
+    SECTION("an odd size is rejected")
+    {
+        argv[0] = 44100.0 / 101;
+        REQUIRE(xtract_spectrum_ctx(ctx, data, 101, argv, actual) == XTRACT_BAD_VECTOR_SIZE);
+    }
+
+    xtract_context_delete(reference);
+    xtract_context_delete(ctx);
+}
+
+TEST_CASE("xtract_context FFT autocorrelation has the shape of the direct method", "[context][fft]")
+{
+    const int N = 64;
+    double data[N];
+    double expected[N];
+    double actual[N];
+
+    xttest_gen_sine(data, N, 44100, 2756.25, 1.0);
+    xtract_autocorrelation(data, N, NULL, expected);
+
+    xtract_context *ctx = xtract_context_new();
+
+    REQUIRE(xtract_autocorrelation_fft_ctx(ctx, data, N, NULL, actual) == XTRACT_NO_RESULT);
+    REQUIRE(xtract_context_init_fft(ctx, N, XTRACT_AUTOCORRELATION_FFT) == XTRACT_SUCCESS);
+    REQUIRE(xtract_autocorrelation_fft_ctx(ctx, data, N, NULL, actual) == XTRACT_SUCCESS);
+
+    for (int n = 0; n < N; ++n)
+        REQUIRE(actual[n] / actual[0] == Approx(expected[n] / expected[0]).margin(1e-9));
+
+    xtract_context_delete(ctx);
+}
+
+TEST_CASE("xtract_context FFT plans are shared between threads", "[context][fft]")
+{
+    const int threads = 4;
+    const int frames = 50;
+    double data[1024];
+    double expected[2][1024];
+    double argv[2][4] = {
+        {44100.0 / 1024, (double)XTRACT_POWER_SPECTRUM, 0.0, 0.0},
+        {44100.0 / 256, (double)XTRACT_POWER_SPECTRUM, 0.0, 0.0}
+    };
+    const int sizes[2] = {1024, 256};
+    std::vector<int> mismatches(threads, 0);
+    std::vector<std::thread> workers;
+
+    xttest_gen_sine(data, 1024, 44100, 440.0, 1.0);
+
+    xtract_context *reference = xtract_context_new();
+    for (int s = 0; s < 2; ++s)
+    {
+        xtract_context_init_fft(reference, sizes[s], XTRACT_SPECTRUM);
+        xtract_spectrum_ctx(reference, data, sizes[s], argv[s], expected[s]);
+    }
+    xtract_context_delete(reference);
+
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.push_back(std::thread([&, t]()
+        {
+            double result[1024];
+            xtract_context *ctx = xtract_context_new();
+            xtract_context_init_fft(ctx, sizes[t % 2], XTRACT_SPECTRUM);
+
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                int s = (frame + t) % 2;
+                xtract_spectrum_ctx(ctx, data, sizes[s], argv[s], result);
+                if (memcmp(result, expected[s], sizes[s] * sizeof(double)) != 0)
+                    ++mismatches[t];
+            }
+
+            xtract_context_delete(ctx);
+        }));
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    for (int t = 0; t < threads; ++t)
+        REQUIRE(mismatches[t] == 0);
+}
+
+TEST_CASE("xtract_context work buffers are reused across sizes", "[context][f0]")
+{
+    double samplerate = 44100.0;
+    double data[1024];
+    double expected = 0.0;
+    double actual = 0.0;
+
+    xtract_context *ctx = xtract_context_new();
+    REQUIRE(xtract_context_init_fft(ctx, 1024, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+    REQUIRE(xtract_init_fft(1024, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+
+    /* Grow and shrink the buffers a few times, each result must match a
+     * fresh computation on the default context */
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int N = 128; N <= 1024; N <<= 1)
+        {
+            xttest_gen_sine(data, N, samplerate, 689.0625, 1.0);
+            xtract_failsafe_f0(data, N, &samplerate, &expected);
+            REQUIRE(xtract_failsafe_f0_ctx(ctx, data, N, &samplerate, &actual) == XTRACT_SUCCESS);
+            REQUIRE(actual == expected);
+        }
+    }
+
+    xtract_free_fft();
+    xtract_context_delete(ctx);
+}
+
+TEST_CASE("xtract_context DCT tables are independent", "[context][dct]")
+{
+    double data4[] = {1.0, 0.0, 0.0, 0.0};
+    double data8[] = {1.0, 2.0, 3.0, 4.0, 4.0, 3.0, 2.0, 1.0};
+    double result4[4];
+    double result8[8];
+    double expected8[8];
+
+    xtract_context *a = xtract_context_new();
+    xtract_context *b = xtract_context_new();
+
+    xtract_dct(data8, 8, NULL, expected8);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        xtract_dct_ctx(a, data4, 4, NULL, result4);
+        xtract_dct_ctx(b, data8, 8, NULL, result8);
+    }
+
+    REQUIRE(result4[0] == Approx(1.0));
+    REQUIRE(result4[1] == Approx(cos(M_PI / 8.0)));
+    REQUIRE(result4[2] == Approx(cos(M_PI / 4.0)));
+    REQUIRE(result4[3] == Approx(cos(3.0 * M_PI / 8.0)));
+
+    for (int n = 0; n < 8; ++n)
+        REQUIRE(result8[n] == Approx(expected8[n]));
+
+    xtract_context_delete(a);
+    xtract_context_delete(b);
+}
+
+TEST_CASE("xtract_context wavelet f0 trackers are independent", "[context][f0]")
+{
+    const int N = 1024;
+    double samplerate = 44100.0;
+    double low[N], high[N];
+    double f0_low = 0.0, f0_high = 0.0;
+
+    xttest_gen_sine(low, N, samplerate, 220.5, 1.0);
+    xttest_gen_sine(high, N, samplerate, 441.0, 1.0);
+
+    xtract_context *a = xtract_context_new();
+    xtract_context *b = xtract_context_new();
+
+    for (int i = 0; i < 4; ++i)
+    {
+        xtract_wavelet_f0_ctx(a, low, N, &samplerate, &f0_low);
+        xtract_wavelet_f0_ctx(b, high, N, &samplerate, &f0_high);
+    }
+
+    REQUIRE(xttest_ftom(f0_low) == xttest_ftom(220.5));
+    REQUIRE(xttest_ftom(f0_high) == xttest_ftom(441.0));
+
+    xtract_context_delete(a);
+    xtract_context_delete(b);
+}
+
+TEST_CASE("xtract_wavelet_f0_state tracks many streams at their own sample rate", "[context][f0]")
+{
+    const int N = 2048;
+    const double rates[] = {44100.0, 48000.0, 96000.0};
+    const double pitches[] = {220.5, 320.0, 480.0};
+    double data[3][N];
+    double f0[3] = {0.0, 0.0, 0.0};
+    xtract_wavelet_f0_state *states[3];
+
+    REQUIRE(xtract_wavelet_f0_state_new(1, 44100.0) == NULL);
+    REQUIRE(xtract_wavelet_f0_state_new(N, 0.0) == NULL);
+
+    for (int s = 0; s < 3; ++s)
+    {
+        xttest_gen_sine(data[s], N, rates[s], pitches[s], 1.0);
+        states[s] = xtract_wavelet_f0_state_new(N, rates[s]);
+        REQUIRE(states[s] != NULL);
+    }
+
+    SECTION("interleaved streams each find their own pitch")
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int s = 0; s < 3; ++s)
+                REQUIRE(xtract_wavelet_f0_state_compute(states[s], data[s], N, NULL, &f0[s]) == XTRACT_SUCCESS);
+
+        for (int s = 0; s < 3; ++s)
+            REQUIRE(xttest_ftom(f0[s]) == xttest_ftom(pitches[s]));
+    }
+
+    SECTION("a state at 44100 Hz matches xtract_wavelet_f0_ctx()")
+    {
+        double samplerate = 44100.0;
+        double expected = 0.0;
+        xtract_context *ctx = xtract_context_new();
+
+        for (int i = 0; i < 4; ++i)
+        {
+            xtract_wavelet_f0_ctx(ctx, data[0], N, &samplerate, &expected);
+            xtract_wavelet_f0_state_compute(states[0], data[0], N, NULL, &f0[0]);
+            REQUIRE(f0[0] == expected);
+        }
+
+        xtract_context_delete(ctx);
+    }
+
+    SECTION("blocks larger than max_N are rejected")
+    {
+        REQUIRE(xtract_wavelet_f0_state_compute(states[0], data[0], N + 1, NULL, &f0[0]) == XTRACT_BAD_STATE);
+    }
+
+    for (int s = 0; s < 3; ++s)
+        xtract_wavelet_f0_state_delete(states[s]);
+}
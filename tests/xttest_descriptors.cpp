@@ -0,0 +1,43 @@
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+
+#include <cstring>
+
+/*
+ * Unit tests for the feature descriptors.
+ *
+ * Every feature must be found by its own name, so a stale name hash fails
+ * here when a feature is added or renamed.
+ */
+
+TEST_CASE("every feature is found by the name in its descriptor", "[descriptors]")
+{
+    for(int feature = 0; feature < XTRACT_FEATURES; ++feature)
+    {
+        const xtract_function_descriptor_t *d = xtract_get_descriptor(feature);
+
+        REQUIRE(d != NULL);
+        REQUIRE(d->id == feature);
+        REQUIRE(xtract_feature_from_name(d->algo.name) == feature);
+    }
+
+    REQUIRE(xtract_feature_from_name("spectral_centroid") == XTRACT_SPECTRAL_CENTROID);
+    REQUIRE(xtract_feature_from_name("spectral_centroi") == XTRACT_ANY);
+    REQUIRE(xtract_feature_from_name("") == XTRACT_ANY);
+    REQUIRE(xtract_feature_from_name(NULL) == XTRACT_ANY);
+    REQUIRE(xtract_get_descriptor(-1) == NULL);
+    REQUIRE(xtract_get_descriptor(XTRACT_FEATURES) == NULL);
+}
+
+TEST_CASE("xtract_make_descriptors() returns a copy of the descriptors", "[descriptors]")
+{
+    xtract_function_descriptor_t *fd = xtract_make_descriptors();
+
+    REQUIRE(fd != NULL);
+    REQUIRE(std::memcmp(fd, xtract_get_descriptor(0), XTRACT_FEATURES * sizeof(*fd)) == 0);
+    REQUIRE(fd[XTRACT_SKEWNESS].argv.donor[0] == XTRACT_MEAN);
+    REQUIRE(fd[XTRACT_SKEWNESS].argv.donor[1] == XTRACT_STANDARD_DEVIATION);
+
+    xtract_free_descriptors(fd);
+}
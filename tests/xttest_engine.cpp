@@ -0,0 +1,144 @@
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_engine.h"
+#include "xttest_util.hpp"
+
+#include <vector>
+
+/*
+ * Unit tests for xtract_engine.
+ *
+ * However many threads compute the frames, the result matrix must hold
+ * exactly what the plan gives frame by frame.
+ */
+
+SCENARIO("An engine computes a plan over every frame of a signal", "[engine]")
+{
+    const int N = 512;
+    const int hop = 256;
+    const int frames = 101;
+    const int length = (frames - 1) * hop + N;
+    double spectrum_argv[] = {44100.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+    std::vector<double> signal(length);
+
+    /* A rising pitch, so that every frame differs */
+    for(int f = 0; f < frames; ++f)
+        xttest_gen_sine(&signal[f * hop], f < frames - 1 ? hop : N, 44100, 200.0 + f * 10.0, 0.8);
+
+    xtract_plan *plan = xtract_plan_new(N);
+    REQUIRE(plan != NULL);
+    REQUIRE(xtract_plan_add(plan, XTRACT_SPECTRUM, spectrum_argv) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_SPECTRAL_CENTROID, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_KURTOSIS, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_RMS_AMPLITUDE, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_compile(plan) == XTRACT_SUCCESS);
+
+    /* The expected matrix, one frame at a time */
+    const int features[] = {XTRACT_KURTOSIS, XTRACT_SPECTRAL_CENTROID, XTRACT_RMS_AMPLITUDE, XTRACT_SPECTRUM};
+    const int columns = 3 + N;
+    std::vector<double> expected(frames * columns);
+
+    for(int f = 0; f < frames; ++f)
+    {
+        REQUIRE(xtract_plan_compute(plan, &signal[f * hop]) == XTRACT_SUCCESS);
+
+        for(int i = 0, column = 0; i < 4; ++i)
+        {
+            int size;
+            const double *result = xtract_plan_result(plan, features[i], &size);
+
+            for(int n = 0; n < size; ++n)
+                expected[f * columns + column + n] = result[n];
+
+            column += size;
+        }
+    }
+
+    for(int threads = 1; threads <= 4; threads += 3)
+    {
+        GIVEN("an engine with " << threads << " threads")
+        {
+            xtract_engine *engine = xtract_engine_new(plan, threads);
+            REQUIRE(engine != NULL);
+
+            THEN("the columns follow the order of the features")
+            {
+                int size;
+
+                REQUIRE(xtract_engine_columns(engine) == columns);
+                REQUIRE(xtract_engine_column(engine, XTRACT_KURTOSIS, &size) == 0);
+                REQUIRE(size == 1);
+                REQUIRE(xtract_engine_column(engine, XTRACT_SPECTRUM, &size) == 3);
+                REQUIRE(size == N);
+                REQUIRE(xtract_engine_column(engine, XTRACT_MEAN, NULL) == -1);
+            }
+
+            THEN("the result matrix matches the plan frame by frame")
+            {
+                std::vector<double> result(frames * columns);
+
+                REQUIRE(xtract_engine_compute(engine, &signal[0], frames, hop, &result[0]) == XTRACT_SUCCESS);
+
+                for(int i = 0; i < frames * columns; ++i)
+                    REQUIRE(result[i] == expected[i]);
+            }
+
+            xtract_engine_delete(engine);
+        }
+    }
+
+    xtract_plan_delete(plan);
+}
+
+TEST_CASE("An engine rejects plans it can't compute frame by frame", "[engine]")
+{
+    double argv[] = {44100.0};
+    xtract_plan *plan = xtract_plan_new(512);
+
+    REQUIRE(plan != NULL);
+    REQUIRE(xtract_engine_new(plan, 2) == NULL);
+
+    REQUIRE(xtract_plan_add(plan, XTRACT_WAVELET_F0, argv) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_compile(plan) == XTRACT_SUCCESS);
+    REQUIRE(xtract_engine_new(plan, 2) == NULL);
+
+    xtract_plan_delete(plan);
+}
+
+TEST_CASE("An engine computes features that use the thread's own context", "[engine]")
+{
+    const int N = 512;
+    const int frames = 16;
+    double argv[] = {44100.0};
+    std::vector<double> signal(frames * N), result(frames), expected(frames);
+
+    for(int f = 0; f < frames; ++f)
+        xttest_gen_sine(&signal[f * N], N, 44100, 200.0 + f * 20.0, 0.8);
+
+    xtract_plan *plan = xtract_plan_new(N);
+    REQUIRE(plan != NULL);
+    REQUIRE(xtract_plan_add(plan, XTRACT_F0, argv) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_compile(plan) == XTRACT_SUCCESS);
+
+    for(int f = 0; f < frames; ++f)
+    {
+        xtract_plan_compute(plan, &signal[f * N]);
+        expected[f] = *xtract_plan_result(plan, XTRACT_F0, NULL);
+    }
+
+    xtract_engine *engine = xtract_engine_new(plan, 4);
+    REQUIRE(engine != NULL);
+
+    /* Each call starts new threads, whose work buffers must be freed */
+    for(int call = 0; call < 3; ++call)
+    {
+        xtract_engine_compute(engine, &signal[0], frames, N, &result[0]);
+
+        for(int f = 0; f < frames; ++f)
+            REQUIRE(result[f] == expected[f]);
+    }
+
+    xtract_engine_delete(engine);
+    xtract_plan_delete(plan);
+}
@@ -0,0 +1,282 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_context.h"
+#include "xttest_util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/*
+ * Unit tests for the FFT backends.
+ *
+ * Every available backend must agree with the Ooura backend, which is the
+ * reference for the packed layout and scaling used throughout the library.
+ */
+
+static std::vector<int> xttest_available_fft_backends(void)
+{
+    const int candidates[] = {XTRACT_FFT_BACKEND_NATIVE, XTRACT_FFT_BACKEND_VDSP};
+    std::vector<int> backends;
+
+    for (int backend : candidates)
+    {
+        if (xtract_set_fft_backend(backend) == XTRACT_SUCCESS)
+            backends.push_back(backend);
+    }
+
+    xtract_set_fft_backend(XTRACT_FFT_BACKEND_DEFAULT);
+
+    return backends;
+}
+
+TEST_CASE("xtract_set_fft_backend", "[fft]")
+{
+    int original = xtract_get_fft_backend();
+
+    REQUIRE(xtract_set_fft_backend(XTRACT_FFT_BACKEND_OOURA) == XTRACT_SUCCESS);
+    REQUIRE(xtract_get_fft_backend() == XTRACT_FFT_BACKEND_OOURA);
+    REQUIRE(std::strcmp(xtract_get_fft_backend_name(), "ooura") == 0);
+
+    REQUIRE(xtract_set_fft_backend(XTRACT_FFT_BACKEND_NATIVE) == XTRACT_SUCCESS);
+    REQUIRE(std::strncmp(xtract_get_fft_backend_name(), "native", 6) == 0);
+
+    REQUIRE(xtract_set_fft_backend(-1) == XTRACT_FEATURE_NOT_IMPLEMENTED);
+    REQUIRE(xtract_get_fft_backend() == XTRACT_FFT_BACKEND_NATIVE);
+
+    REQUIRE(xtract_set_fft_backend(XTRACT_FFT_BACKEND_DEFAULT) == XTRACT_SUCCESS);
+    REQUIRE(xtract_get_fft_backend() == original);
+}
+
+TEST_CASE("xtract_set_fft_backend while other threads compute spectra", "[fft][context]")
+{
+    const int N = 1024;
+    const int frames = 2000;
+    double data[N], expected[N];
+    double argv[] = {44100.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+    std::atomic<bool> done(false);
+    int mismatches = 0;
+
+    xttest_gen_sine(data, N, 44100, 440.0, 1.0);
+
+    xtract_context *reference = xtract_context_new();
+    xtract_context_init_fft(reference, N, XTRACT_SPECTRUM);
+    xtract_spectrum_ctx(reference, data, N, argv, expected);
+    xtract_context_delete(reference);
+
+    std::thread worker([&]()
+    {
+        double result[N];
+        xtract_context *ctx = xtract_context_new();
+        xtract_context_init_fft(ctx, N, XTRACT_SPECTRUM);
+
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            xtract_spectrum_ctx(ctx, data, N, argv, result);
+            for (int n = 0; n < N; ++n)
+                if (std::fabs(result[n] - expected[n]) > 1e-9)
+                {
+                    ++mismatches;
+                    break;
+                }
+        }
+
+        xtract_context_delete(ctx);
+        done = true;
+    });
+
+    /* Each transform uses one backend or the other */
+    for (int i = 0; !done; ++i)
+        xtract_set_fft_backend(i % 2 ? XTRACT_FFT_BACKEND_OOURA : XTRACT_FFT_BACKEND_DEFAULT);
+
+    worker.join();
+    xtract_set_fft_backend(XTRACT_FFT_BACKEND_DEFAULT);
+
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("FFT backends agree with the Ooura backend", "[fft]")
+{
+    const int max_N = 4096;
+    std::vector<double> data(max_N);
+    std::vector<double> expected(max_N);
+    std::vector<double> actual(max_N);
+    xtract_context *reference = xtract_context_new();
+    xtract_context *ctx = xtract_context_new();
+
+    std::vector<double> sine(max_N);
+
+    /* The noise table only has 1024 samples, so add a sine to avoid a
+     * periodic signal at the larger sizes */
+    for (int n = 0; n < max_N; n += 1024)
+        xttest_gen_noise(data.data() + n, 1024, 0.5);
+    xttest_gen_sine(sine.data(), max_N, 44100, 1234.5, 0.5);
+    xttest_add(data.data(), sine.data(), max_N);
+
+    for (int backend : xttest_available_fft_backends())
+    {
+        CAPTURE(backend);
+
+        for (int N = 4; N <= max_N; N <<= 1)
+        {
+            double argv[] = {44100.0 / N, (double)XTRACT_SPECTRUM_COEFFICIENTS, 1.0, 0.0};
+
+            CAPTURE(N);
+
+            /* Forward transform */
+            {
+                xtract_set_fft_backend(XTRACT_FFT_BACKEND_OOURA);
+                REQUIRE(xtract_context_init_fft(reference, N, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+                REQUIRE(xtract_spectrum_ctx(reference, data.data(), N, argv, expected.data()) == XTRACT_SUCCESS);
+
+                xtract_set_fft_backend(backend);
+                REQUIRE(xtract_context_init_fft(ctx, N, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+                REQUIRE(xtract_spectrum_ctx(ctx, data.data(), N, argv, actual.data()) == XTRACT_SUCCESS);
+
+                for (int n = 0; n < N; ++n)
+                    REQUIRE(actual[n] == Approx(expected[n]).margin(1e-12));
+            }
+
+            /* Forward and inverse transform */
+            {
+                int M = N >> 1;
+
+                xtract_set_fft_backend(XTRACT_FFT_BACKEND_OOURA);
+                REQUIRE(xtract_context_init_fft(reference, M, XTRACT_AUTOCORRELATION_FFT) == XTRACT_SUCCESS);
+                REQUIRE(xtract_autocorrelation_fft_ctx(reference, data.data(), M, NULL, expected.data()) == XTRACT_SUCCESS);
+
+                xtract_set_fft_backend(backend);
+                REQUIRE(xtract_context_init_fft(ctx, M, XTRACT_AUTOCORRELATION_FFT) == XTRACT_SUCCESS);
+                REQUIRE(xtract_autocorrelation_fft_ctx(ctx, data.data(), M, NULL, actual.data()) == XTRACT_SUCCESS);
+
+                for (int n = 0; n < M; ++n)
+                    REQUIRE(actual[n] == Approx(expected[n]).margin(1e-12));
+            }
+
+            /* Single precision */
+            {
+                std::vector<float> dataf(data.begin(), data.begin() + N);
+                std::vector<float> expectedf(N);
+                std::vector<float> actualf(N);
+                float argvf[] = {44100.0f / N, (float)XTRACT_SPECTRUM_COEFFICIENTS, 1.0f, 0.0f};
+
+                xtract_set_fft_backend(XTRACT_FFT_BACKEND_OOURA);
+                REQUIRE(xtract_context_init_fft(reference, N, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+                REQUIRE(xtractf_spectrum_ctx(reference, dataf.data(), N, argvf, expectedf.data()) == XTRACT_SUCCESS);
+
+                xtract_set_fft_backend(backend);
+                REQUIRE(xtract_context_init_fft(ctx, N, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+                REQUIRE(xtractf_spectrum_ctx(ctx, dataf.data(), N, argvf, actualf.data()) == XTRACT_SUCCESS);
+
+                /* Rounding errors scale with the largest coefficient */
+                float peak = 0.0f;
+                for (int n = 0; n < N; ++n)
+                    peak = std::max(peak, std::fabs(expectedf[n]));
+
+                for (int n = 0; n < N; ++n)
+                    REQUIRE(actualf[n] == Approx(expectedf[n]).margin(1e-5 * peak));
+            }
+        }
+    }
+
+    xtract_set_fft_backend(XTRACT_FFT_BACKEND_DEFAULT);
+    xtract_context_delete(reference);
+    xtract_context_delete(ctx);
+}
+
+TEST_CASE("FFT sizes that are not powers of two match a direct DFT", "[fft]")
+{
+    /* Mixed radix sizes, and sizes with a factor above 5 that use Bluestein's algorithm */
+    const int sizes[] = {2, 6, 10, 14, 30, 90, 480, 882, 1000, 1470};
+    const int max_N = 1470;
+    /* One extra sample for the odd length autocorrelation of max_N + 1 */
+    std::vector<double> data(max_N + 1);
+    std::vector<double> expected(max_N);
+    std::vector<double> actual(max_N);
+    std::vector<double> sine(max_N + 1);
+    xtract_context *ctx = xtract_context_new();
+
+    xttest_gen_noise(data.data(), 1024, 0.5);
+    xttest_gen_noise(data.data() + 1024, max_N + 1 - 1024, 0.5);
+    xttest_gen_sine(sine.data(), max_N + 1, 44100, 1234.5, 0.5);
+    xttest_add(data.data(), sine.data(), max_N + 1);
+
+    /* Ooura only handles powers of two, so it must fall back to the native backend */
+    const int backends[] = {XTRACT_FFT_BACKEND_NATIVE, XTRACT_FFT_BACKEND_OOURA};
+
+    for (int backend : backends)
+    {
+        CAPTURE(backend);
+        xtract_set_fft_backend(backend);
+
+        for (int N : sizes)
+        {
+            double argv[] = {44100.0 / N, (double)XTRACT_SPECTRUM_COEFFICIENTS, 1.0, 0.0};
+
+            CAPTURE(N);
+
+            /* Coefficients are Re and -Im of bin k, with DC first */
+            for (int k = 0; k < N / 2; ++k)
+            {
+                double re = 0.0, im = 0.0;
+
+                for (int j = 0; j < N; ++j)
+                {
+                    double phase = 2.0 * M_PI * (double)((long)j * k % N) / N;
+                    re += data[j] * cos(phase);
+                    im += data[j] * sin(phase);
+                }
+
+                expected[2 * k] = re;
+                expected[2 * k + 1] = k == 0 ? 0.0 : im;
+            }
+
+            REQUIRE(xtract_context_init_fft(ctx, N, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+            REQUIRE(xtract_spectrum_ctx(ctx, data.data(), N, argv, actual.data()) == XTRACT_SUCCESS);
+
+            for (int n = 0; n < N; ++n)
+                REQUIRE(actual[n] == Approx(expected[n]).margin(1e-10 * N));
+
+            /* Single precision */
+            {
+                std::vector<float> dataf(data.begin(), data.begin() + N);
+                std::vector<float> actualf(N);
+                float argvf[] = {44100.0f / N, (float)XTRACT_SPECTRUM_COEFFICIENTS, 1.0f, 0.0f};
+
+                REQUIRE(xtractf_spectrum_ctx(ctx, dataf.data(), N, argvf, actualf.data()) == XTRACT_SUCCESS);
+
+                for (int n = 0; n < N; ++n)
+                    REQUIRE(actualf[n] == Approx(expected[n]).margin(2e-6 * N));
+            }
+
+            /* Forward and inverse transform of size 2N on an odd length */
+            {
+                int M = N + 1;
+                std::vector<double> direct(M);
+                std::vector<double> actual_m(M);
+
+                xtract_autocorrelation(data.data(), M, NULL, direct.data());
+                REQUIRE(xtract_context_init_fft(ctx, M, XTRACT_AUTOCORRELATION_FFT) == XTRACT_SUCCESS);
+                REQUIRE(xtract_autocorrelation_fft_ctx(ctx, data.data(), M, NULL, actual_m.data()) == XTRACT_SUCCESS);
+
+                for (int n = 0; n < M; ++n)
+                    REQUIRE(actual_m[n] / actual_m[0] == Approx(direct[n] / direct[0]).margin(1e-9));
+            }
+        }
+    }
+
+    xtract_set_fft_backend(XTRACT_FFT_BACKEND_DEFAULT);
+    REQUIRE(xtract_context_init_fft(ctx, 101, XTRACT_SPECTRUM) == XTRACT_ARGUMENT_ERROR);
+
+    xtract_context_delete(ctx);
+}
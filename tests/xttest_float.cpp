@@ -0,0 +1,267 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_float.h"
+#include "xttest_util.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * Unit tests for the single precision API.
+ *
+ * Each xtractf_ function is checked against the double precision function of
+ * the same name, to within single precision tolerances.
+ */
+
+static void xttest_to_float(const double *in, float *out, int N)
+{
+    for (int n = 0; n < N; ++n)
+        out[n] = (float)in[n];
+}
+
+TEST_CASE("xtractf scalar reductions match the double API", "[float][scalar]")
+{
+    const int N = 512;
+    double data[N];
+    float dataf[N];
+    double expected;
+    float actual;
+
+    xttest_gen_sawtooth(data, N, 44100, 440.0, 0.8);
+    xttest_to_float(data, dataf, N);
+
+    double mean, variance, sd;
+    xtract_mean(data, N, NULL, &mean);
+    xtract_variance(data, N, &mean, &variance);
+    xtract_standard_deviation(data, N, &variance, &sd);
+    double moments[] = {mean, sd};
+
+    float meanf = (float)mean, variancef = (float)variance;
+    float momentsf[] = {(float)mean, (float)sd};
+
+    SECTION("mean")
+    {
+        xtractf_mean(dataf, N, NULL, &actual);
+        REQUIRE(actual == Approx(mean).margin(1e-5));
+    }
+
+    SECTION("variance, standard deviation and average deviation")
+    {
+        xtractf_variance(dataf, N, &meanf, &actual);
+        REQUIRE(actual == Approx(variance).epsilon(1e-5));
+
+        xtractf_standard_deviation(dataf, N, &variancef, &actual);
+        REQUIRE(actual == Approx(sd).epsilon(1e-5));
+
+        xtract_average_deviation(data, N, &mean, &expected);
+        xtractf_average_deviation(dataf, N, &meanf, &actual);
+        REQUIRE(actual == Approx(expected).epsilon(1e-5));
+    }
+
+    SECTION("skewness and kurtosis")
+    {
+        xtract_skewness(data, N, moments, &expected);
+        xtractf_skewness(dataf, N, momentsf, &actual);
+        REQUIRE(actual == Approx(expected).margin(1e-4));
+
+        xtract_kurtosis(data, N, moments, &expected);
+        xtractf_kurtosis(dataf, N, momentsf, &actual);
+        REQUIRE(actual == Approx(expected).margin(1e-4));
+    }
+
+    SECTION("zcr, rms, extrema and sum")
+    {
+        xtract_zcr(data, N, NULL, &expected);
+        xtractf_zcr(dataf, N, NULL, &actual);
+        REQUIRE(actual == Approx(expected));
+
+        xtract_rms_amplitude(data, N, NULL, &expected);
+        xtractf_rms_amplitude(dataf, N, NULL, &actual);
+        REQUIRE(actual == Approx(expected).epsilon(1e-5));
+
+        double limit = 0.0;
+        float limitf = 0.f;
+        xtract_lowest_value(data, N, &limit, &expected);
+        xtractf_lowest_value(dataf, N, &limitf, &actual);
+        REQUIRE(actual == Approx(expected).epsilon(1e-6));
+
+        xtract_highest_value(data, N, NULL, &expected);
+        xtractf_highest_value(dataf, N, NULL, &actual);
+        REQUIRE(actual == Approx(expected).epsilon(1e-6));
+
+        xtract_sum(data, N, NULL, &expected);
+        xtractf_sum(dataf, N, NULL, &actual);
+        REQUIRE(actual == Approx(expected).margin(1e-3));
+    }
+}
+
+TEST_CASE("xtractf reductions cover a partial block of lanes", "[float][scalar]")
+{
+    /* Not a multiple of any vector width, so the remainder loops are run */
+    const int N = 509;
+    double data[N];
+    float dataf[N];
+    double expected;
+    float actual;
+
+    xttest_gen_sawtooth(data, N, 44100, 1234.5, 0.8);
+    data[N - 1] = 0.9;
+    data[N - 2] = 0.0001;
+    xttest_to_float(data, dataf, N);
+
+    double mean;
+    float meanf;
+    xtract_mean(data, N, NULL, &mean);
+    xtractf_mean(dataf, N, NULL, &meanf);
+    REQUIRE(meanf == Approx(mean).margin(1e-5));
+
+    xtract_variance(data, N, &mean, &expected);
+    xtractf_variance(dataf, N, &meanf, &actual);
+    REQUIRE(actual == Approx(expected).epsilon(1e-5));
+
+    xtract_average_deviation(data, N, &mean, &expected);
+    xtractf_average_deviation(dataf, N, &meanf, &actual);
+    REQUIRE(actual == Approx(expected).epsilon(1e-5));
+
+    xtract_zcr(data, N, NULL, &expected);
+    xtractf_zcr(dataf, N, NULL, &actual);
+    REQUIRE(actual == Approx(expected));
+
+    double limit = 0.0;
+    float limitf = 0.f;
+    xtract_lowest_value(data, N, &limit, &expected);
+    xtractf_lowest_value(dataf, N, &limitf, &actual);
+    REQUIRE(actual == (float)expected);
+
+    xtractf_highest_value(dataf, N, NULL, &actual);
+    REQUIRE(actual == 0.9f);
+
+    limitf = 1.f;
+    REQUIRE(xtractf_lowest_value(dataf, N, &limitf, &actual) == XTRACT_NO_RESULT);
+}
+
+TEST_CASE("xtractf_spectrum matches xtract_spectrum", "[float][fft]")
+{
+    const int N = 256;
+    double data[N];
+    float dataf[N];
+    double expected[N];
+    float actual[N];
+
+    xttest_gen_sine(data, N, 44100, 689.0625, 1.0);
+    xttest_to_float(data, dataf, N);
+
+    xtract_init_fft(N, XTRACT_SPECTRUM);
+
+    for (int type = XTRACT_MAGNITUDE_SPECTRUM; type <= XTRACT_SPECTRUM_COEFFICIENTS; type++)
+    {
+        for (int withDC = 0; withDC < 2; withDC++)
+        {
+            double argv[] = {44100.0 / N, (double)type, (double)withDC, 0.0};
+            float argvf[] = {44100.f / N, (float)type, (float)withDC, 0.f};
+
+            xtract_spectrum(data, N, argv, expected);
+            REQUIRE(xtractf_spectrum(dataf, N, argvf, actual) == XTRACT_SUCCESS);
+
+            for (int n = 0; n < N; n++)
+            {
+                /* Log spectra of bins holding only rounding noise differ
+                 * between precisions, so only compare bins with energy */
+                bool is_log = type == XTRACT_LOG_MAGNITUDE_SPECTRUM || type == XTRACT_LOG_POWER_SPECTRUM;
+                if (is_log && n < N / 2 && expected[n] < 0.9)
+                    continue;
+                REQUIRE(actual[n] == Approx(expected[n]).margin(1e-3));
+            }
+        }
+    }
+
+    xtract_free_fft();
+}
+
+TEST_CASE("xtractf DCT and MFCC match the double API", "[float][dct]")
+{
+    const int N = 128;
+    const int n_filters = 13;
+    double spectrum[N];
+    float spectrumf[N];
+    double expected[16];
+    float actual[16];
+
+    for (int n = 0; n < N; n++)
+        spectrum[n] = 1.0 / (1.0 + n);
+    xttest_to_float(spectrum, spectrumf, N);
+
+    SECTION("dct")
+    {
+        xtract_dct(spectrum, 16, NULL, expected);
+        xtractf_dct(spectrumf, 16, NULL, actual);
+
+        for (int n = 0; n < 16; n++)
+            REQUIRE(actual[n] == Approx(expected[n]).margin(1e-5));
+    }
+
+    SECTION("mfcc")
+    {
+        xtract_mel_filter mel_filters;
+        mel_filters.n_filters = n_filters;
+        mel_filters.filters = (double **)malloc(n_filters * sizeof(double *));
+        for (int i = 0; i < n_filters; i++)
+            mel_filters.filters[i] = (double *)calloc(N, sizeof(double));
+
+        xtract_init_mfcc(N, 22050.0 / 2, XTRACT_EQUAL_GAIN, 20, 8000, n_filters, mel_filters.filters);
+
+        xtract_mfcc(spectrum, N, &mel_filters, expected);
+        REQUIRE(xtractf_mfcc(spectrumf, N, &mel_filters, actual) == XTRACT_SUCCESS);
+
+        for (int n = 0; n < n_filters; n++)
+            REQUIRE(actual[n] == Approx(expected[n]).margin(1e-4));
+
+        for (int i = 0; i < n_filters; i++)
+            free(mel_filters.filters[i]);
+        free(mel_filters.filters);
+    }
+}
+
+TEST_CASE("xtractf windowing and function table", "[float][helper]")
+{
+    const int N = 64;
+    float ones[N];
+    float windowed[N];
+
+    for (int n = 0; n < N; n++)
+        ones[n] = 1.f;
+
+    SECTION("a window applied to ones gives the window")
+    {
+        double *window = xtract_init_window(N, XTRACT_HANN);
+        float *windowf = xtractf_init_window(N, XTRACT_HANN);
+        REQUIRE(windowf != NULL);
+
+        xtractf_windowed(ones, N, windowf, windowed);
+
+        for (int n = 0; n < N; n++)
+            REQUIRE(windowed[n] == Approx(window[n]).margin(1e-7));
+
+        xtract_free_window(window);
+        xtractf_free_window(windowf);
+    }
+
+    SECTION("xtractf[] is indexed like xtract[]")
+    {
+        float mean = 0.f;
+        REQUIRE(xtractf[XTRACT_MEAN] == xtractf_mean);
+        REQUIRE(xtractf[XTRACT_SPECTRUM] == xtractf_spectrum);
+        REQUIRE(xtractf[XTRACT_WINDOWED] == xtractf_windowed);
+        REQUIRE(xtractf[XTRACT_LPC] == NULL);
+        REQUIRE(xtractf[XTRACT_MEAN](ones, N, NULL, &mean) == XTRACT_SUCCESS);
+        REQUIRE(mean == 1.f);
+    }
+}
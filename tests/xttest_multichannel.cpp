@@ -0,0 +1,174 @@
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_multichannel.h"
+#include "xttest_util.hpp"
+
+#include <vector>
+
+/*
+ * Unit tests for the multichannel features.
+ *
+ * Each channel of an interleaved block must give what the single channel
+ * function gives for that channel on its own. The number of channels isn't
+ * a multiple of any vector width, so the remainder lanes are covered too.
+ */
+
+namespace
+{
+    const int channels = 7;
+
+    /* Channel c of interleaved, as a contiguous array */
+    std::vector<double> channel(const std::vector<double> &interleaved, int c)
+    {
+        std::vector<double> result(interleaved.size() / channels);
+
+        for(size_t n = 0; n < result.size(); ++n)
+            result[n] = interleaved[n * channels + c];
+
+        return result;
+    }
+}
+
+SCENARIO("Multichannel features match the single channel features of each channel", "[multichannel]")
+{
+    const int N = 512;
+    std::vector<double> block(N * channels);
+    std::vector<double> result(N * channels);
+    double expected;
+
+    for(int c = 0; c < channels; ++c)
+    {
+        std::vector<double> signal(N);
+
+        xttest_gen_sawtooth(&signal[0], N, 44100, 110.0 * (c + 1), 0.1 * (c + 1));
+        for(int n = 0; n < N; ++n)
+            block[n * channels + c] = signal[n] - 0.01 * c;
+    }
+
+    GIVEN("the scalar reductions")
+    {
+        std::vector<double> mean(channels);
+
+        REQUIRE(xtract_multichannel_mean(&block[0], N, channels, NULL, &mean[0]) == XTRACT_SUCCESS);
+
+        for(int c = 0; c < channels; ++c)
+        {
+            std::vector<double> x = channel(block, c);
+
+            xtract_mean(&x[0], N, NULL, &expected);
+            REQUIRE(mean[c] == Approx(expected).margin(1e-12));
+
+            REQUIRE(xtract_multichannel_variance(&block[0], N, channels, &mean[0], &result[0]) == XTRACT_SUCCESS);
+            xtract_variance(&x[0], N, &mean[c], &expected);
+            REQUIRE(result[c] == Approx(expected));
+
+            REQUIRE(xtract_multichannel_rms_amplitude(&block[0], N, channels, NULL, &result[0]) == XTRACT_SUCCESS);
+            xtract_rms_amplitude(&x[0], N, NULL, &expected);
+            REQUIRE(result[c] == Approx(expected));
+
+            REQUIRE(xtract_multichannel_zcr(&block[0], N, channels, NULL, &result[0]) == XTRACT_SUCCESS);
+            xtract_zcr(&x[0], N, NULL, &expected);
+            REQUIRE(result[c] == expected);
+
+            REQUIRE(xtract_multichannel_highest_value(&block[0], N, channels, NULL, &result[0]) == XTRACT_SUCCESS);
+            xtract_highest_value(&x[0], N, NULL, &expected);
+            REQUIRE(result[c] == expected);
+        }
+
+        REQUIRE(xtract_multichannel_mean(&block[0], N, 0, NULL, &result[0]) == XTRACT_BAD_VECTOR_SIZE);
+    }
+
+    GIVEN("a window")
+    {
+        double *window = xtract_init_window(N, XTRACT_HAMMING);
+        std::vector<double> single(N);
+
+        REQUIRE(xtract_multichannel_windowed(&block[0], N, channels, window, &result[0]) == XTRACT_SUCCESS);
+
+        for(int c = 0; c < channels; ++c)
+        {
+            std::vector<double> x = channel(block, c);
+            std::vector<double> y = channel(result, c);
+
+            xtract_windowed(&x[0], N, window, &single[0]);
+            for(int n = 0; n < N; ++n)
+                REQUIRE(y[n] == single[n]);
+        }
+
+        xtract_free_window(window);
+    }
+
+    GIVEN("a multichannel FFT with a Hann window")
+    {
+        const int types[] = {XTRACT_MAGNITUDE_SPECTRUM, XTRACT_LOG_MAGNITUDE_SPECTRUM, XTRACT_POWER_SPECTRUM,
+                             XTRACT_LOG_POWER_SPECTRUM, XTRACT_SPECTRUM_COEFFICIENTS};
+        xtract_multichannel_fft *fft = xtract_multichannel_fft_new(N, channels, XTRACT_HANN);
+        double *window = xtract_init_window(N, XTRACT_HANN);
+        std::vector<double> windowed(N), single(N);
+
+        REQUIRE(fft != NULL);
+        xtract_init_fft(N, XTRACT_SPECTRUM);
+
+        for(int type = 0; type < 5; ++type)
+        {
+            for(int flags = 0; flags < 4; ++flags)
+            {
+                double argv[] = {44100.0 / N, (double)types[type], (double)(flags & 1), (double)(flags >> 1)};
+
+                REQUIRE(xtract_multichannel_spectrum(fft, &block[0], N, argv, &result[0]) == XTRACT_SUCCESS);
+
+                for(int c = 0; c < channels; ++c)
+                {
+                    std::vector<double> x = channel(block, c);
+                    std::vector<double> y = channel(result, c);
+
+                    xtract_windowed(&x[0], N, window, &windowed[0]);
+                    xtract_spectrum(&windowed[0], N, argv, &single[0]);
+
+                    for(int n = 0; n < N; ++n)
+                        REQUIRE(y[n] == Approx(single[n]).margin(1e-9));
+                }
+            }
+        }
+
+        THEN("the mel energies of each channel match")
+        {
+            const int n_filters = 20;
+            double argv[] = {44100.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+            std::vector<double> mel(n_filters * channels), single_mel(n_filters);
+            xtract_mel_filter filter;
+
+            REQUIRE(xtract_init_mfcc_sparse(N >> 1, 22050.0, XTRACT_EQUAL_GAIN, 20, 8000, n_filters, &filter) == XTRACT_SUCCESS);
+            REQUIRE(xtract_multichannel_spectrum(fft, &block[0], N, argv, &result[0]) == XTRACT_SUCCESS);
+            REQUIRE(xtract_multichannel_mel_spectrogram(&result[0], N >> 1, channels, &filter, &mel[0]) == XTRACT_SUCCESS);
+
+            for(int c = 0; c < channels; ++c)
+            {
+                std::vector<double> y = channel(result, c);
+
+                xtract_mel_spectrogram(&y[0], N >> 1, &filter, &single_mel[0]);
+                for(int k = 0; k < n_filters; ++k)
+                    REQUIRE(mel[k * channels + c] == Approx(single_mel[k]));
+            }
+
+            xtract_free_mel_filter(&filter);
+        }
+
+        REQUIRE(xtract_multichannel_spectrum(fft, &block[0], N / 2, NULL, &result[0]) == XTRACT_BAD_VECTOR_SIZE);
+
+        xtract_free_fft();
+        xtract_free_window(window);
+        xtract_multichannel_fft_delete(fft);
+    }
+}
+
+TEST_CASE("A multichannel FFT needs a power of two frames", "[multichannel]")
+{
+    REQUIRE(xtract_multichannel_fft_new(384, 2, XTRACT_HANN) == NULL);
+    REQUIRE(xtract_multichannel_fft_new(512, 0, XTRACT_HANN) == NULL);
+
+    xtract_multichannel_fft *fft = xtract_multichannel_fft_new(2, 3, XTRACT_RECTANGULAR);
+    REQUIRE(fft != NULL);
+    xtract_multichannel_fft_delete(fft);
+}
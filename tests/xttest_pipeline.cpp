@@ -0,0 +1,196 @@
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_pipeline.h"
+#include "xttest_util.hpp"
+
+#include <vector>
+
+/*
+ * Unit tests for xtract_pipeline.
+ *
+ * Running the stages on their own threads must give the features of the
+ * same frames, in the same order, as running them one after another.
+ */
+
+namespace
+{
+    struct pipeline_job
+    {
+        const std::vector<double> *signal;
+        size_t offset;
+        int reads;
+        std::vector<double> centroid;
+        std::vector<double> crest;
+    };
+
+    int read_signal(void *user, double *samples, int n)
+    {
+        pipeline_job *job = static_cast<pipeline_job *>(user);
+        size_t left = job->signal->size() - job->offset;
+
+        /* Short reads, as from a decoder */
+        if(++job->reads % 3 == 0 && n > 1)
+            n /= 2;
+
+        if((size_t)n > left)
+            n = (int)left;
+
+        for(int i = 0; i < n; ++i)
+            samples[i] = (*job->signal)[job->offset + i];
+
+        job->offset += n;
+
+        return n;
+    }
+
+    void collect_frame(void *user, int frame, const xtract_plan *plan)
+    {
+        pipeline_job *job = static_cast<pipeline_job *>(user);
+
+        REQUIRE(frame == (int)job->centroid.size());
+        job->centroid.push_back(*xtract_plan_result(plan, XTRACT_SPECTRAL_CENTROID, NULL));
+        job->crest.push_back(*xtract_plan_result(plan, XTRACT_CREST, NULL));
+    }
+}
+
+SCENARIO("A pipeline gives the features of every frame in order", "[pipeline]")
+{
+    const int N = 512;
+    const int hop = 128;
+    const int length = 20000;
+    double spectrum_argv[] = {44100.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+    double spectrum[512];
+    std::vector<double> signal(length);
+
+    xttest_gen_sawtooth(&signal[0], length, 44100, 440, 0.8);
+
+    GIVEN("a plan reading spectra")
+    {
+        xtract_plan *plan = xtract_plan_new(N);
+        REQUIRE(plan != NULL);
+        REQUIRE(xtract_plan_set_input(plan, XTRACT_SPECTRAL) == XTRACT_SUCCESS);
+        REQUIRE(xtract_plan_add(plan, XTRACT_SPECTRAL_CENTROID, NULL) == XTRACT_SUCCESS);
+        REQUIRE(xtract_plan_add(plan, XTRACT_CREST, NULL) == XTRACT_SUCCESS);
+        REQUIRE(xtract_plan_compile(plan) == XTRACT_SUCCESS);
+
+        /* The stages one after another */
+        std::vector<double> centroid, crest;
+        xtract_stft_stream *stream = xtract_stft_stream_new(N, hop, XTRACT_HANN);
+        REQUIRE(stream != NULL);
+
+        for(int offset = 0; offset < length; offset += hop)
+        {
+            xtract_stft_stream_write(stream, &signal[offset], offset + hop <= length ? hop : length - offset);
+
+            while(xtract_stft_stream_spectrum(stream, spectrum_argv, spectrum) == XTRACT_SUCCESS)
+            {
+                REQUIRE(xtract_plan_compute(plan, spectrum) == XTRACT_SUCCESS);
+                centroid.push_back(*xtract_plan_result(plan, XTRACT_SPECTRAL_CENTROID, NULL));
+                crest.push_back(*xtract_plan_result(plan, XTRACT_CREST, NULL));
+            }
+        }
+
+        xtract_stft_stream_delete(stream);
+
+        WHEN("the stages run as a pipeline")
+        {
+            xtract_pipeline *pipeline = xtract_pipeline_new(plan, hop, XTRACT_HANN, spectrum_argv, 4);
+            pipeline_job job = {&signal, 0, 0, {}, {}};
+            xtract_pipeline_stats stats;
+
+            REQUIRE(pipeline != NULL);
+            REQUIRE(xtract_pipeline_run(pipeline, read_signal, collect_frame, &job) == XTRACT_SUCCESS);
+
+            THEN("the features match")
+            {
+                REQUIRE(job.centroid.size() == centroid.size());
+
+                for(size_t f = 0; f < centroid.size(); ++f)
+                {
+                    REQUIRE(job.centroid[f] == centroid[f]);
+                    REQUIRE(job.crest[f] == crest[f]);
+                }
+            }
+
+            THEN("the queues report every slot filled")
+            {
+                REQUIRE(xtract_pipeline_get_stats(pipeline, XTRACT_PIPELINE_SPECTRA, &stats) == XTRACT_SUCCESS);
+                REQUIRE(stats.capacity == 4);
+                REQUIRE(stats.pushes == (long)centroid.size() + 1);
+                REQUIRE(stats.max_depth <= 4);
+                REQUIRE(stats.mean_depth >= 1.0);
+
+                REQUIRE(xtract_pipeline_get_stats(pipeline, XTRACT_PIPELINE_SAMPLES, &stats) == XTRACT_SUCCESS);
+                REQUIRE(stats.pushes == job.reads);
+                REQUIRE(xtract_pipeline_get_stats(pipeline, XTRACT_PIPELINE_QUEUES, &stats) == XTRACT_BAD_ARGV);
+            }
+
+            xtract_pipeline_delete(pipeline);
+        }
+
+        xtract_plan_delete(plan);
+    }
+
+    GIVEN("a plan reading audio samples")
+    {
+        xtract_plan *plan = xtract_plan_new(N);
+        REQUIRE(plan != NULL);
+        REQUIRE(xtract_plan_add(plan, XTRACT_SPECTRAL_CENTROID, NULL) == XTRACT_SUCCESS);
+        REQUIRE(xtract_plan_compile(plan) == XTRACT_SUCCESS);
+
+        THEN("no pipeline is made")
+        {
+            REQUIRE(xtract_pipeline_new(plan, hop, XTRACT_HANN, spectrum_argv, 4) == NULL);
+        }
+
+        xtract_plan_delete(plan);
+    }
+}
+
+TEST_CASE("A pipeline ends the stream at a frame it can't transform", "[pipeline]")
+{
+    /* The FFT needs an even frame size, which the plan doesn't */
+    const int N = 511;
+    const int hop = 64;
+    double spectrum_argv[] = {44100.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+    std::vector<double> signal(20000);
+    xtract_pipeline_stats stats;
+
+    xttest_gen_sawtooth(&signal[0], (int)signal.size(), 44100, 440, 0.8);
+
+    xtract_plan *plan = xtract_plan_new(N);
+    REQUIRE(plan != NULL);
+    REQUIRE(xtract_plan_set_input(plan, XTRACT_SPECTRAL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_SPECTRAL_CENTROID, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_CREST, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_compile(plan) == XTRACT_SUCCESS);
+
+    xtract_pipeline *pipeline = xtract_pipeline_new(plan, hop, XTRACT_HANN, spectrum_argv, 2);
+    pipeline_job job = {&signal, 0, 0, {}, {}};
+
+    REQUIRE(pipeline != NULL);
+    REQUIRE(xtract_pipeline_run(pipeline, read_signal, collect_frame, &job) == XTRACT_ARGUMENT_ERROR);
+    REQUIRE(job.centroid.empty());
+    REQUIRE(job.offset < signal.size());
+
+    /* Only the end of the stream was pushed */
+    REQUIRE(xtract_pipeline_get_stats(pipeline, XTRACT_PIPELINE_SPECTRA, &stats) == XTRACT_SUCCESS);
+    REQUIRE(stats.pushes == 1);
+
+    xtract_pipeline_delete(pipeline);
+    xtract_plan_delete(plan);
+}
+
+TEST_CASE("A plan reading spectra rejects features of audio samples", "[plan]")
+{
+    xtract_plan *plan = xtract_plan_new(512);
+
+    REQUIRE(plan != NULL);
+    REQUIRE(xtract_plan_set_input(plan, XTRACT_MEL_COEFFS) == XTRACT_BAD_ARGV);
+    REQUIRE(xtract_plan_set_input(plan, XTRACT_SPECTRAL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_ZCR, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_compile(plan) == XTRACT_FEATURE_NOT_IMPLEMENTED);
+
+    xtract_plan_delete(plan);
+}
@@ -0,0 +1,136 @@
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_plan.h"
+#include "xttest_util.hpp"
+
+/*
+ * Unit tests for xtract_plan.
+ *
+ * A plan must give the results of calling the features by hand, with each
+ * argv filled in from the donors named by the descriptors.
+ */
+
+TEST_CASE("xtract_plan matches hand ordered calls", "[plan]")
+{
+    const int N = 1024;
+    double data[1024];
+    double spectrum[1024];
+    double spectrum_argv[] = {44100.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+    double rolloff_argv[] = {44100.0 / N, 85.0};
+    double mean, variance, sd, skewness, centroid, highest, magnitude_mean, crest, rolloff;
+    double argv[2];
+    int size = 0;
+
+    xttest_gen_sawtooth(data, N, 44100, 344.53125, 0.8);
+
+    xtract_init_fft(N, XTRACT_SPECTRUM);
+    xtract_spectrum(data, N, spectrum_argv, spectrum);
+    xtract_free_fft();
+
+    xtract_mean(data, N, NULL, &mean);
+    xtract_variance(data, N, &mean, &variance);
+    xtract_standard_deviation(data, N, &variance, &sd);
+    argv[0] = mean;
+    argv[1] = sd;
+    xtract_skewness(data, N, argv, &skewness);
+    xtract_spectral_centroid(spectrum, N, NULL, &centroid);
+    xtract_highest_value(spectrum, N / 2, NULL, &highest);
+    xtract_mean(spectrum, N / 2, NULL, &magnitude_mean);
+    argv[0] = highest;
+    argv[1] = magnitude_mean;
+    xtract_crest(spectrum, N / 2, argv, &crest);
+    xtract_rolloff(spectrum, N / 2, rolloff_argv, &rolloff);
+
+    xtract_plan *plan = xtract_plan_new(N);
+    REQUIRE(plan != NULL);
+
+    REQUIRE(xtract_plan_add(plan, XTRACT_SKEWNESS, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_SPECTRAL_CENTROID, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_CREST, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_ROLLOFF, rolloff_argv) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_MEAN, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_SPECTRUM, spectrum_argv) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_compile(plan) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_ZCR, NULL) == XTRACT_BAD_ARGV);
+
+    /* Run twice to check that nothing carries over from one frame */
+    for(int frame = 0; frame < 2; ++frame)
+    {
+        REQUIRE(xtract_plan_compute(plan, data) == XTRACT_SUCCESS);
+
+        REQUIRE(*xtract_plan_result(plan, XTRACT_SKEWNESS, &size) == Approx(skewness));
+        REQUIRE(size == 1);
+        REQUIRE(*xtract_plan_result(plan, XTRACT_MEAN, NULL) == mean);
+        REQUIRE(*xtract_plan_result(plan, XTRACT_SPECTRAL_CENTROID, NULL) == Approx(centroid));
+        REQUIRE(*xtract_plan_result(plan, XTRACT_CREST, NULL) == Approx(crest));
+        REQUIRE(*xtract_plan_result(plan, XTRACT_ROLLOFF, NULL) == rolloff);
+
+        const double *planned_spectrum = xtract_plan_result(plan, XTRACT_SPECTRUM, &size);
+        REQUIRE(size == N);
+        for(int n = 0; n < N; ++n)
+            REQUIRE(planned_spectrum[n] == Approx(spectrum[n]).margin(1e-12));
+    }
+
+    REQUIRE(xtract_plan_result(plan, XTRACT_VARIANCE, NULL) == NULL);
+
+    xtract_plan_delete(plan);
+}
+
+TEST_CASE("xtract_plan sets the default bin width from its frame size", "[plan]")
+{
+    const int N = 2048;
+    double data[2048];
+    double spectrum[2048];
+    double spectrum_argv[] = {44100.0 / N, 0.0, 0.0, 0.0};
+    double rolloff_argv[] = {44100.0 / N, 95.0};
+    double centroid, rolloff;
+
+    xttest_gen_sawtooth(data, N, 44100, 344.53125, 0.8);
+
+    xtract_init_fft(N, XTRACT_SPECTRUM);
+    xtract_spectrum(data, N, spectrum_argv, spectrum);
+    xtract_free_fft();
+
+    xtract_spectral_centroid(spectrum, N, NULL, &centroid);
+    xtract_rolloff(spectrum, N >> 1, rolloff_argv, &rolloff);
+
+    xtract_plan *plan = xtract_plan_new(N);
+    REQUIRE(plan != NULL);
+    REQUIRE(xtract_plan_add(plan, XTRACT_SPECTRAL_CENTROID, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_add(plan, XTRACT_ROLLOFF, NULL) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_compile(plan) == XTRACT_SUCCESS);
+    REQUIRE(xtract_plan_compute(plan, data) == XTRACT_SUCCESS);
+
+    REQUIRE(*xtract_plan_result(plan, XTRACT_SPECTRAL_CENTROID, NULL) == Approx(centroid));
+    REQUIRE(*xtract_plan_result(plan, XTRACT_ROLLOFF, NULL) == rolloff);
+
+    xtract_plan_delete(plan);
+}
+
+TEST_CASE("xtract_plan rejects features it can't schedule", "[plan]")
+{
+    xtract_plan *plan = xtract_plan_new(512);
+    REQUIRE(plan != NULL);
+
+    SECTION("a filterbank feature without its filterbank")
+    {
+        REQUIRE(xtract_plan_add(plan, XTRACT_MFCC, NULL) == XTRACT_SUCCESS);
+        REQUIRE(xtract_plan_compile(plan) == XTRACT_BAD_ARGV);
+    }
+
+    SECTION("a delta feature")
+    {
+        REQUIRE(xtract_plan_add(plan, XTRACT_FLUX, NULL) == XTRACT_SUCCESS);
+        REQUIRE(xtract_plan_compile(plan) == XTRACT_FEATURE_NOT_IMPLEMENTED);
+    }
+
+    SECTION("a feature out of range")
+    {
+        REQUIRE(xtract_plan_add(plan, XTRACT_FEATURES, NULL) == XTRACT_BAD_ARGV);
+    }
+
+    REQUIRE(xtract_plan_compute(plan, NULL) == XTRACT_BAD_STATE);
+
+    xtract_plan_delete(plan);
+}
@@ -3,6 +3,7 @@
 
 #include "xtract/xtract_scalar.h"
 #include "xtract/libxtract.h"
+#include "xtract/xtract_context.h"
 
 #include "catch.hpp"
 
@@ -1996,6 +1997,135 @@ SCENARIO( "McLeod F0 detects pitch where xtract_f0 fails", "[xtract_mcleod_f0][x
     }
 }
 
+SCENARIO( "McLeod F0 with a lag bound matches the full search", "[xtract_mcleod_f0]" )
+{
+    GIVEN( "a 4096 sample block of a 220.5 Hz sawtooth with a sample rate of 44100" )
+    {
+        const int blocksize = 4096;
+        double table[blocksize];
+        double result_full = -1.0;
+        double result_bounded = -1.0;
+        double argv[2] = {44100.0, 0.0};
+
+        xttest_gen_sawtooth(table, blocksize, 44100.0, 220.5, 1.0);
+
+        xtract_context *ctx = xtract_context_new();
+
+        WHEN( "the lowest f0 is below the pitch" )
+        {
+            REQUIRE( xtract_mcleod_f0_ctx(ctx, table, blocksize, argv, &result_full) == XTRACT_SUCCESS );
+            argv[1] = 80.0;
+            REQUIRE( xtract_mcleod_f0_ctx(ctx, table, blocksize, argv, &result_bounded) == XTRACT_SUCCESS );
+
+            THEN( "both searches find the same pitch" )
+            {
+                REQUIRE( xttest_ftom(result_full) == xttest_ftom(220.5) );
+                REQUIRE( result_bounded == Approx(result_full).epsilon(1e-9) );
+            }
+        }
+
+        WHEN( "the lowest f0 is above the pitch" )
+        {
+            argv[1] = 300.0;
+            int rv = xtract_mcleod_f0_ctx(ctx, table, blocksize, argv, &result_bounded);
+
+            THEN( "the pitch is not found" )
+            {
+                REQUIRE( (rv == XTRACT_NO_RESULT || xttest_ftom(result_bounded) != xttest_ftom(220.5)) );
+            }
+        }
+
+        xtract_context_delete(ctx);
+    }
+}
+
+SCENARIO( "YIN F0 is computed for an audio signal", "[xtract_yin_f0]" )
+{
+    GIVEN( "a 2048 sample block with a sample rate of 44100" )
+    {
+        const int blocksize = 2048;
+        double samplerate = 44100.0;
+        double table[blocksize];
+        double result = -1.0;
+
+        WHEN( "the frequency is 220.5 Hz and the signal is a sine" )
+        {
+            xttest_gen_sine(table, blocksize, samplerate, 220.5, 1.0);
+            int rv = xtract_yin_f0(table, blocksize, &samplerate, &result);
+
+            THEN( "the detected F0 is within a cent of 220.5 Hz" )
+            {
+                REQUIRE( rv == XTRACT_SUCCESS );
+                REQUIRE( result == Approx(220.5).epsilon(0.0006) );
+            }
+        }
+
+        WHEN( "the frequency is 86.1328125 Hz and the signal is a sawtooth" )
+        {
+            xttest_gen_sawtooth(table, blocksize, samplerate, 86.1328125, 1.0);
+            int rv = xtract_yin_f0(table, blocksize, &samplerate, &result);
+
+            THEN( "the detected F0 is within a cent of 86.1328125 Hz" )
+            {
+                REQUIRE( rv == XTRACT_SUCCESS );
+                REQUIRE( result == Approx(86.1328125).epsilon(0.0006) );
+            }
+        }
+
+        WHEN( "the frequency is 1378.125 Hz and the signal is a sawtooth" )
+        {
+            xttest_gen_sawtooth(table, blocksize, samplerate, 1378.125, 1.0);
+            int rv = xtract_yin_f0(table, blocksize, &samplerate, &result);
+
+            THEN( "the detected F0 is within a cent of 1378.125 Hz" )
+            {
+                REQUIRE( rv == XTRACT_SUCCESS );
+                REQUIRE( result == Approx(1378.125).epsilon(0.0006) );
+            }
+        }
+
+        WHEN( "the signal is silence" )
+        {
+            memset(table, 0, sizeof(table));
+            int rv = xtract_yin_f0(table, blocksize, &samplerate, &result);
+
+            THEN( "no F0 is found" )
+            {
+                REQUIRE( rv == XTRACT_NO_RESULT );
+                REQUIRE( result == 0.0 );
+            }
+        }
+    }
+
+    GIVEN( "a context and blocks of several sizes" )
+    {
+        double argv[2] = {44100.0, 0.0};
+        double table[3001];
+        double result = -1.0;
+        const int sizes[] = {1024, 3001, 512, 2048};
+
+        xtract_context *ctx = xtract_context_new();
+
+        WHEN( "consecutive frames change size" )
+        {
+            THEN( "each frame finds the pitch" )
+            {
+                for (int frame = 0; frame < 2; ++frame)
+                {
+                    for (int size : sizes)
+                    {
+                        xttest_gen_sawtooth(table, size, argv[0], 344.53125, 1.0);
+                        REQUIRE( xtract_yin_f0_ctx(ctx, table, size, argv, &result) == XTRACT_SUCCESS );
+                        REQUIRE( result == Approx(344.53125).epsilon(0.0006) );
+                    }
+                }
+            }
+        }
+
+        xtract_context_delete(ctx);
+    }
+}
+
 TEST_CASE("xtract_flatness numerical stability", "[scalar]")
 {
     double result = 0.0;
@@ -2054,3 +2184,210 @@ TEST_CASE("xtract_flatness numerical stability", "[scalar]")
         REQUIRE(rv == XTRACT_NO_RESULT);
     }
 }
+
+SCENARIO( "Scalar reductions match a plain loop for any block size", "[xtract_mean][xtract_variance][xtract_zcr]" )
+{
+    GIVEN( "blocks whose size is not a multiple of the number of SIMD lanes" )
+    {
+        const int sizes[] = {1, 3, 17, 1001};
+
+        for(int s = 0; s < 4; ++s)
+        {
+            const int N = sizes[s];
+            double data[1001];
+            double mean = 0.0, variance = 0.0, sum = 0.0, irregularity = 0.0;
+            double highest = -1.0, lowest = 2.0;
+            int crossings = 0, nonzero = 0;
+            double result = -1.0;
+
+            /* Deterministic values in [-0.5, 0.5] with some exact zeros */
+            for(int n = 0; n < N; ++n)
+                data[n] = n % 7 == 3 ? 0.0 : std::sin(n * 12.9898) * 0.5;
+
+            for(int n = 0; n < N; ++n)
+            {
+                sum += data[n];
+                highest = n == 0 || data[n] > highest ? data[n] : highest;
+                if(data[n] > 0.0 && data[n] < lowest)
+                    lowest = data[n];
+                if(data[n] != 0.0)
+                    ++nonzero;
+                if(n > 0 && data[n] * data[n - 1] < 0.0)
+                    ++crossings;
+                if(n > 0 && n < N - 1)
+                    irregularity += std::fabs(data[n] - (data[n - 1] + data[n] + data[n + 1]) / 3.0);
+            }
+            mean = sum / N;
+            for(int n = 0; n < N; ++n)
+                variance += (data[n] - mean) * (data[n] - mean);
+
+            WHEN( "the reductions are computed" )
+            {
+                double threshold = 0.0;
+
+                THEN( "they agree with the plain loops" )
+                {
+                    REQUIRE( xtract_sum(data, N, NULL, &result) == XTRACT_SUCCESS );
+                    REQUIRE( result == Approx(sum).margin(1e-12) );
+                    REQUIRE( xtract_mean(data, N, NULL, &result) == XTRACT_SUCCESS );
+                    REQUIRE( result == Approx(mean).margin(1e-12) );
+                    REQUIRE( xtract_highest_value(data, N, NULL, &result) == XTRACT_SUCCESS );
+                    REQUIRE( result == highest );
+                    REQUIRE( xtract_nonzero_count(data, N, NULL, &result) == XTRACT_SUCCESS );
+                    REQUIRE( result == nonzero );
+                    REQUIRE( xtract_zcr(data, N, NULL, &result) == XTRACT_SUCCESS );
+                    REQUIRE( result == Approx((double)crossings / N) );
+
+                    if(lowest < 2.0)
+                    {
+                        REQUIRE( xtract_lowest_value(data, N, &threshold, &result) == XTRACT_SUCCESS );
+                        REQUIRE( result == lowest );
+                    }
+
+                    if(N > 1)
+                    {
+                        REQUIRE( xtract_variance(data, N, &mean, &result) == XTRACT_SUCCESS );
+                        REQUIRE( result == Approx(variance / (N - 1)) );
+                    }
+
+                    if(N > 2)
+                    {
+                        REQUIRE( xtract_irregularity_k(data, N, NULL, &result) == XTRACT_SUCCESS );
+                        REQUIRE( result == Approx(irregularity) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO( "Moments computed together match the chained functions", "[xtract_moments]" )
+{
+    GIVEN( "a 1001 sample block of a sawtooth" )
+    {
+        const int N = 1001;
+        double data[1001];
+        double mean, variance, sd, average_deviation, skewness, kurtosis;
+        double argv[2];
+        xtract_moments_t moments;
+
+        xttest_gen_sawtooth(data, N, 44100.0, 441.0, 1.0);
+        for(int n = 0; n < N; ++n)
+            data[n] = data[n] * data[n] * data[n];
+
+        xtract_mean(data, N, NULL, &mean);
+        xtract_variance(data, N, &mean, &variance);
+        xtract_standard_deviation(data, N, &variance, &sd);
+        xtract_average_deviation(data, N, &mean, &average_deviation);
+        argv[0] = mean;
+        argv[1] = sd;
+        xtract_skewness(data, N, argv, &skewness);
+        xtract_kurtosis(data, N, argv, &kurtosis);
+
+        WHEN( "the moments are computed in one call" )
+        {
+            REQUIRE( xtract_moments(data, N, &moments) == XTRACT_SUCCESS );
+
+            THEN( "each moment matches the chained result" )
+            {
+                REQUIRE( moments.mean == Approx(mean).margin(1e-12) );
+                REQUIRE( moments.variance == Approx(variance) );
+                REQUIRE( moments.standard_deviation == Approx(sd) );
+                REQUIRE( moments.average_deviation == Approx(average_deviation) );
+                REQUIRE( moments.skewness == Approx(skewness).margin(1e-12) );
+                REQUIRE( moments.kurtosis == Approx(kurtosis) );
+            }
+        }
+
+        WHEN( "the block has a large offset" )
+        {
+            double shifted[1001];
+            for(int n = 0; n < N; ++n)
+                shifted[n] = data[n] + 1e8;
+
+            REQUIRE( xtract_moments(shifted, N, &moments) == XTRACT_SUCCESS );
+
+            THEN( "the central moments are unaffected" )
+            {
+                REQUIRE( moments.variance == Approx(variance).epsilon(1e-6) );
+                REQUIRE( moments.kurtosis == Approx(kurtosis).epsilon(1e-4) );
+            }
+        }
+    }
+
+    GIVEN( "a constant block" )
+    {
+        double data[8] = {0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5};
+        xtract_moments_t moments;
+
+        THEN( "the skewness and kurtosis are not defined" )
+        {
+            REQUIRE( xtract_moments(data, 8, &moments) == XTRACT_NO_RESULT );
+            REQUIRE( moments.mean == 0.5 );
+            REQUIRE( moments.variance == 0.0 );
+            REQUIRE( moments.skewness == 0.0 );
+            REQUIRE( moments.kurtosis == 0.0 );
+        }
+    }
+}
+
+SCENARIO( "Spectral shape computed together matches the individual functions", "[xtract_spectral_shape]" )
+{
+    GIVEN( "a 513 bin spectrum with a sample rate of 44100" )
+    {
+        const int bins = 513;
+        const double bin_width = 44100.0 / 1024;
+        double spectrum[2 * 513];
+        double centroid, variance, sd, skewness, kurtosis, slope, rolloff;
+        double argv[2];
+        double rolloff_argv[2] = {bin_width, 85.0};
+        xtract_spectral_shape_t shape;
+
+        for(int n = 0; n < bins; ++n)
+        {
+            spectrum[n] = 1.0 / (1.0 + 0.05 * n) + 0.2 * std::fabs(std::sin(n * 0.37));
+            spectrum[bins + n] = n * bin_width;
+        }
+
+        xtract_spectral_centroid(spectrum, 2 * bins, NULL, &centroid);
+        xtract_spectral_variance(spectrum, 2 * bins, &centroid, &variance);
+        xtract_spectral_standard_deviation(spectrum, 2 * bins, &variance, &sd);
+        argv[0] = centroid;
+        argv[1] = sd;
+        xtract_spectral_skewness(spectrum, 2 * bins, argv, &skewness);
+        xtract_spectral_kurtosis(spectrum, 2 * bins, argv, &kurtosis);
+        xtract_spectral_slope(spectrum, 2 * bins, NULL, &slope);
+        xtract_rolloff(spectrum, bins, rolloff_argv, &rolloff);
+
+        WHEN( "the descriptors are computed in one call" )
+        {
+            REQUIRE( xtract_spectral_shape(spectrum, 2 * bins, rolloff_argv, &shape) == XTRACT_SUCCESS );
+
+            THEN( "each descriptor matches the individual result" )
+            {
+                REQUIRE( shape.centroid == Approx(centroid) );
+                REQUIRE( shape.variance == Approx(variance) );
+                REQUIRE( shape.standard_deviation == Approx(sd) );
+                REQUIRE( shape.skewness == Approx(skewness) );
+                REQUIRE( shape.kurtosis == Approx(kurtosis) );
+                REQUIRE( shape.slope == Approx(slope) );
+                REQUIRE( shape.rolloff == rolloff );
+            }
+        }
+
+        WHEN( "the spectrum is silent" )
+        {
+            for(int n = 0; n < bins; ++n)
+                spectrum[n] = 0.0;
+
+            THEN( "no result is returned and every descriptor is 0" )
+            {
+                REQUIRE( xtract_spectral_shape(spectrum, 2 * bins, rolloff_argv, &shape) == XTRACT_NO_RESULT );
+                REQUIRE( shape.centroid == 0.0 );
+                REQUIRE( shape.kurtosis == 0.0 );
+                REQUIRE( shape.slope == 0.0 );
+                REQUIRE( shape.rolloff == 0.0 );
+            }
+        }
+    }
+}
@@ -0,0 +1,201 @@
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_stateful.h"
+#include "xttest_util.hpp"
+
+#include <algorithm>
+#include <vector>
+
+/*
+ * Unit tests for the running statistics.
+ *
+ * After every block written, each statistic must equal the single frame
+ * feature computed over the values still in the window.
+ */
+
+SCENARIO("Running statistics follow the last values written", "[stateful]")
+{
+    const size_t capacity = 100;
+    const int blocks[] = {1, 7, 64, 0, 150, 33};
+    const int length = 4000;
+    std::vector<double> noise(1024), signal(length);
+
+    xttest_gen_noise(&noise[0], 1024, 0.5);
+
+    /* Loud noise followed by silence */
+    for(int n = 0; n < length; ++n)
+        signal[n] = n < length / 2 ? 1000.0 + noise[n % 1024] : 0.0;
+
+    xtract_running_moments_state *moments = xtract_running_moments_state_new(capacity);
+    xtract_running_extrema_state *extrema = xtract_running_extrema_state_new(capacity);
+    xtract_running_rms_state *rms = xtract_running_rms_state_new(capacity);
+    double result[2];
+
+    REQUIRE(moments != NULL);
+    REQUIRE(extrema != NULL);
+    REQUIRE(rms != NULL);
+
+    GIVEN("no values")
+    {
+        THEN("there is no result")
+        {
+            REQUIRE(xtract_running_moments(moments, NULL, 0, NULL, result) == XTRACT_NO_RESULT);
+            REQUIRE(xtract_running_extrema(extrema, NULL, 0, NULL, result) == XTRACT_NO_RESULT);
+            REQUIRE(xtract_running_rms(rms, NULL, 0, NULL, result) == XTRACT_NO_RESULT);
+            REQUIRE(result[0] == 0.0);
+        }
+    }
+
+    GIVEN("a signal written in uneven blocks")
+    {
+        int offset = 0, block = 0;
+
+        while(offset < length)
+        {
+            int n = std::min(blocks[block++ % 6], length - offset);
+            double expected, mean;
+
+            offset += n;
+
+            const int count = std::min(offset, (int)capacity);
+            const double *window = &signal[offset - count];
+
+            REQUIRE(xtract_running_moments(moments, &signal[offset - n], n, NULL, result) == XTRACT_SUCCESS);
+            xtract_mean(window, count, NULL, &mean);
+            REQUIRE(result[0] == Approx(mean));
+
+            if(count > 1)
+            {
+                xtract_variance(window, count, &mean, &expected);
+                REQUIRE(result[1] == Approx(expected).margin(1e-9));
+            }
+
+            REQUIRE(xtract_running_extrema(extrema, &signal[offset - n], n, NULL, result) == XTRACT_SUCCESS);
+            REQUIRE(result[0] == *std::min_element(window, window + count));
+            REQUIRE(result[1] == *std::max_element(window, window + count));
+
+            REQUIRE(xtract_running_rms(rms, &signal[offset - n], n, NULL, result) == XTRACT_SUCCESS);
+            xtract_rms_amplitude(window, count, NULL, &expected);
+            REQUIRE(result[0] == Approx(expected).margin(1e-9));
+        }
+
+        THEN("the statistics of the final silence are exact")
+        {
+            REQUIRE(xtract_running_moments(moments, NULL, 0, NULL, result) == XTRACT_SUCCESS);
+            REQUIRE(result[0] == 0.0);
+            REQUIRE(result[1] == 0.0);
+            REQUIRE(xtract_running_rms(rms, NULL, 0, NULL, result) == XTRACT_SUCCESS);
+            REQUIRE(result[0] == 0.0);
+        }
+    }
+
+    xtract_running_moments_state_delete(moments);
+    xtract_running_extrema_state_delete(extrema);
+    xtract_running_rms_state_delete(rms);
+}
+
+TEST_CASE("Running statistics need a window of at least one value", "[stateful]")
+{
+    REQUIRE(xtract_running_moments_state_new(0) == NULL);
+    REQUIRE(xtract_running_extrema_state_new(0) == NULL);
+    REQUIRE(xtract_running_rms_state_new(0) == NULL);
+}
+
+SCENARIO("A sliding DFT gives the spectrum of the last frame after every sample", "[stateful]")
+{
+    const int N = 64;
+    const int length = 40 * N + 17;
+    const int types[] = {XTRACT_MAGNITUDE_SPECTRUM, XTRACT_LOG_MAGNITUDE_SPECTRUM, XTRACT_POWER_SPECTRUM,
+                         XTRACT_LOG_POWER_SPECTRUM, XTRACT_SPECTRUM_COEFFICIENTS};
+    std::vector<double> signal(length);
+    double result[N], expected[N];
+
+    xttest_gen_sawtooth(&signal[0], length, 44100, 1234.5, 0.7);
+    xtract_init_fft(N, XTRACT_SPECTRUM);
+
+    GIVEN("every bin tracked")
+    {
+        xtract_sliding_dft_state *state = xtract_sliding_dft_state_new(N, NULL, 0);
+        REQUIRE(state != NULL);
+
+        THEN("each hop matches xtract_spectrum() of the frame")
+        {
+            double argv[] = {44100.0 / N, 0.0, 0.0, 0.0};
+            int offset = 0, hop = 1;
+
+            REQUIRE(xtract_sliding_dft(state, &signal[0], N - 1, argv, result) == XTRACT_NO_RESULT);
+            offset = N - 1;
+
+            while(offset + hop <= length)
+            {
+                REQUIRE(xtract_sliding_dft(state, &signal[offset], hop, argv, result) == XTRACT_SUCCESS);
+                offset += hop;
+
+                for(int type = 0; type < 5; ++type)
+                {
+                    for(int flags = 0; flags < 4; ++flags)
+                    {
+                        argv[1] = types[type];
+                        argv[2] = flags & 1;
+                        argv[3] = flags >> 1;
+
+                        REQUIRE(xtract_sliding_dft(state, NULL, 0, argv, result) == XTRACT_SUCCESS);
+                        xtract_spectrum(&signal[offset - N], N, argv, expected);
+
+                        for(int n = 0; n < N; ++n)
+                            REQUIRE(result[n] == Approx(expected[n]).margin(1e-9));
+                    }
+                }
+
+                hop = hop % 32 + 1;
+            }
+        }
+
+        THEN("a reset drops the frame")
+        {
+            double argv[] = {44100.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+
+            REQUIRE(xtract_sliding_dft(state, &signal[0], N, argv, result) == XTRACT_SUCCESS);
+            xtract_sliding_dft_state_reset(state);
+            REQUIRE(xtract_sliding_dft(state, NULL, 0, argv, result) == XTRACT_NO_RESULT);
+        }
+
+        xtract_sliding_dft_state_delete(state);
+    }
+
+    GIVEN("a few bins tracked")
+    {
+        const int bins[] = {29, 2, 0, 32};
+        double argv[] = {44100.0 / N, (double)XTRACT_POWER_SPECTRUM, 1.0, 0.0};
+        xtract_sliding_dft_state *state = xtract_sliding_dft_state_new(N, bins, 4);
+
+        REQUIRE(state != NULL);
+
+        THEN("the spectrum holds their values, then their frequencies")
+        {
+            REQUIRE(xtract_sliding_dft(state, &signal[0], length, argv, result) == XTRACT_SUCCESS);
+
+            /* With DC, bin k of xtract_spectrum() is at k, but Nyquist isn't kept */
+            xtract_spectrum(&signal[length - N], N, argv, expected);
+            for(int k = 0; k < 3; ++k)
+            {
+                REQUIRE(result[k] == Approx(expected[bins[k]]).margin(1e-12));
+                REQUIRE(result[4 + k] == expected[N / 2 + bins[k]]);
+            }
+
+            argv[2] = 0.0;
+            xtract_spectrum(&signal[length - N], N, argv, expected);
+            REQUIRE(result[3] == Approx(expected[N / 2 - 1]).margin(1e-12));
+            REQUIRE(result[7] == expected[N - 1]);
+        }
+
+        xtract_sliding_dft_state_delete(state);
+    }
+
+    xtract_free_fft();
+
+    const int bad[] = {33};
+    REQUIRE(xtract_sliding_dft_state_new(N, bad, 1) == NULL);
+    REQUIRE(xtract_sliding_dft_state_new(N + 1, NULL, 0) == NULL);
+}
@@ -0,0 +1,122 @@
+#include "catch.hpp"
+
+#include "xtract/libxtract.h"
+#include "xtract/xtract_stream.h"
+#include "xttest_util.hpp"
+
+#include <vector>
+
+/*
+ * Unit tests for xtract_stft_stream.
+ *
+ * Writing a signal in blocks of any size must give the frames of the signal
+ * cut at every hop, including frames that wrap around the ring buffer.
+ */
+
+SCENARIO("An STFT stream frames a signal written in uneven blocks", "[stream]")
+{
+    const int N = 256;
+    const int length = 8192;
+    const int blocks[] = {64, 480, 1, 127, 300, 2000};
+    std::vector<double> signal(length);
+
+    xttest_gen_sawtooth(&signal[0], length, 44100, 441, 0.8);
+
+    GIVEN("a hop of three quarters of a frame and a Hann window")
+    {
+        const int hop = 192;
+        double *window = xtract_init_window(N, XTRACT_HANN);
+        xtract_stft_stream *stream = xtract_stft_stream_new(N, hop, XTRACT_HANN);
+        const double *frame;
+        int offset = 0, block = 0, frames = 0;
+
+        REQUIRE(stream != NULL);
+
+        while(offset < length)
+        {
+            int n = blocks[block++ % 6];
+
+            if(n > length - offset)
+                n = length - offset;
+
+            /* The largest block doesn't fit whole */
+            offset += xtract_stft_stream_write(stream, &signal[offset], n);
+
+            while(xtract_stft_stream_frame(stream, &frame) == XTRACT_SUCCESS)
+            {
+                for(int i = 0; i < N; ++i)
+                    REQUIRE(frame[i] == signal[frames * hop + i] * window[i]);
+
+                ++frames;
+            }
+        }
+
+        THEN("every complete frame is given back once")
+        {
+            REQUIRE(frames == (length - N) / hop + 1);
+        }
+
+        xtract_stft_stream_delete(stream);
+        xtract_free_window(window);
+    }
+
+    GIVEN("a rectangular window and the spectrum of each frame")
+    {
+        const int hop = 128;
+        double argv[] = {44100.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+        double spectrum[256], expected[256];
+        xtract_stft_stream *stream = xtract_stft_stream_new(N, hop, XTRACT_RECTANGULAR);
+        int offset = 0, block = 0, frames = 0;
+
+        REQUIRE(stream != NULL);
+        xtract_init_fft(N, XTRACT_SPECTRUM);
+
+        while(offset < length)
+        {
+            int n = blocks[block++ % 6];
+
+            if(n > length - offset)
+                n = length - offset;
+
+            /* The largest block doesn't fit whole */
+            offset += xtract_stft_stream_write(stream, &signal[offset], n);
+
+            while(xtract_stft_stream_spectrum(stream, argv, spectrum) == XTRACT_SUCCESS)
+            {
+                xtract_spectrum(&signal[frames * hop], N, argv, expected);
+
+                for(int i = 0; i < N; ++i)
+                    REQUIRE(spectrum[i] == Approx(expected[i]).margin(1e-12));
+
+                ++frames;
+            }
+        }
+
+        THEN("every complete frame is given back once")
+        {
+            REQUIRE(frames == (length - N) / hop + 1);
+        }
+
+        xtract_free_fft();
+        xtract_stft_stream_delete(stream);
+    }
+
+    GIVEN("a block larger than the stream holds")
+    {
+        xtract_stft_stream *stream = xtract_stft_stream_new(N, N, XTRACT_HANN);
+        const double *frame;
+
+        REQUIRE(stream != NULL);
+
+        THEN("only the samples that fit are taken")
+        {
+            REQUIRE(xtract_stft_stream_write(stream, &signal[0], length) == 4 * N - 1);
+            REQUIRE(xtract_stft_stream_frame(stream, &frame) == XTRACT_SUCCESS);
+
+            xtract_stft_stream_reset(stream);
+            REQUIRE(xtract_stft_stream_frame(stream, &frame) == XTRACT_NO_RESULT);
+        }
+
+        xtract_stft_stream_delete(stream);
+    }
+}
@@ -13,6 +13,7 @@
 #include "xtract/xtract_delta.h"
 #include "xtract/libxtract.h"
 #include <cstring>
+#include <string>
 #include <cstdlib>
 
 /*
@@ -103,6 +104,81 @@ TEST_CASE("xtract_asdf", "[vector]")
     }
 }
 
+TEST_CASE("lag range variants match the full lag functions", "[vector]")
+{
+    const int N = 1000;
+    double data[N], full[N], range[N];
+    const double ranges[][2] = {{0, N - 1}, {0, 20}, {5, 40}, {100, 900}, {998, 999}};
+
+    for (int n = 0; n < N; ++n)
+        data[n] = sin(0.05 * n) + 0.25 * ((n * 7919) % 101 - 50) / 50.0;
+
+    SECTION("the SIMD kernels of the full functions keep the order of the sums")
+    {
+        /* Compare with naive sums over every 37th lag */
+        xtract_autocorrelation(data, N, NULL, full);
+        for (int lag = 0; lag < N; lag += 37)
+        {
+            double sum = 0.0;
+            for (int i = 0; i < N - lag; ++i)
+                sum += data[i] * data[i + lag];
+            REQUIRE(full[lag] == sum / N);
+        }
+    }
+
+    for (const auto &r : ranges)
+    {
+        const int min_lag = (int)r[0];
+        const int lags = (int)r[1] - min_lag + 1;
+
+        SECTION("autocorrelation over lags " + std::to_string(min_lag) + " to " + std::to_string((int)r[1]))
+        {
+            xtract_autocorrelation(data, N, NULL, full);
+            REQUIRE(xtract_autocorrelation_lags(data, N, r, range) == XTRACT_SUCCESS);
+            for (int k = 0; k < lags; ++k)
+                REQUIRE(range[k] == Approx(full[min_lag + k]).margin(1e-12));
+        }
+
+        SECTION("AMDF over lags " + std::to_string(min_lag) + " to " + std::to_string((int)r[1]))
+        {
+            xtract_amdf(data, N, NULL, full);
+            REQUIRE(xtract_amdf_lags(data, N, r, range) == XTRACT_SUCCESS);
+            for (int k = 0; k < lags; ++k)
+                REQUIRE(range[k] == full[min_lag + k]);
+        }
+
+        SECTION("ASDF over lags " + std::to_string(min_lag) + " to " + std::to_string((int)r[1]))
+        {
+            xtract_asdf(data, N, NULL, full);
+            REQUIRE(xtract_asdf_lags(data, N, r, range) == XTRACT_SUCCESS);
+            for (int k = 0; k < lags; ++k)
+                REQUIRE(range[k] == Approx(full[min_lag + k]).margin(1e-12));
+        }
+    }
+
+    SECTION("the FFT ASDF matches the direct ASDF")
+    {
+        xtract_asdf(data, N, NULL, full);
+        REQUIRE(xtract_asdf_fft(data, N, NULL, range) == XTRACT_SUCCESS);
+        for (int n = 0; n < N; ++n)
+            REQUIRE(range[n] == Approx(full[n]).margin(1e-12));
+    }
+
+    SECTION("invalid lag ranges are rejected")
+    {
+        const double reversed[] = {10, 5};
+        const double too_long[] = {0, N};
+        const double negative[] = {-1, 5};
+        const double not_a_lag[] = {0, NAN};
+
+        REQUIRE(xtract_autocorrelation_lags(data, N, reversed, range) == XTRACT_BAD_ARGV);
+        REQUIRE(xtract_amdf_lags(data, N, too_long, range) == XTRACT_BAD_ARGV);
+        REQUIRE(xtract_asdf_lags(data, N, negative, range) == XTRACT_BAD_ARGV);
+        REQUIRE(xtract_asdf_lags(data, N, NULL, range) == XTRACT_BAD_ARGV);
+        REQUIRE(xtract_autocorrelation_lags(data, N, not_a_lag, range) == XTRACT_BAD_ARGV);
+    }
+}
+
 TEST_CASE("xtract_dct", "[vector]")
 {
     SECTION("DCT of [1, 0, 0, 0] — impulse")
@@ -245,6 +321,50 @@ TEST_CASE("xtract_spectrum of single cosine", "[vector][fft]")
     }
 }
 
+TEST_CASE("xtract_spectrum_batch", "[vector][fft]")
+{
+    const int N = 64;
+    const int hop = N / 2;
+    const int frames = 5;
+    double data[(frames - 1) * hop + N];
+    double batch[frames * N];
+    double single[N];
+
+    for (int n = 0; n < (frames - 1) * hop + N; n++)
+        data[n] = sin(2.0 * M_PI * 3.0 * n / N) + 0.25 * cos(2.0 * M_PI * 11.0 * n / N);
+
+    xtract_init_fft(N, XTRACT_SPECTRUM);
+
+    SECTION("overlapping frames match one xtract_spectrum call per frame")
+    {
+        for (int type = XTRACT_MAGNITUDE_SPECTRUM; type <= XTRACT_SPECTRUM_COEFFICIENTS; type++)
+        {
+            for (int withDC = 0; withDC < 2; withDC++)
+            {
+                double argv[] = {8000.0 / N, (double)type, (double)withDC, 1.0};
+
+                REQUIRE(xtract_spectrum_batch(data, N, frames, hop, argv, batch) == XTRACT_SUCCESS);
+
+                for (int frame = 0; frame < frames; frame++)
+                {
+                    xtract_spectrum(data + frame * hop, N, argv, single);
+
+                    for (int n = 0; n < N; n++)
+                        REQUIRE(batch[frame * N + n] == single[n]);
+                }
+            }
+        }
+    }
+
+    SECTION("zero frames writes nothing")
+    {
+        double argv[] = {8000.0 / N, (double)XTRACT_MAGNITUDE_SPECTRUM, 0.0, 0.0};
+        batch[0] = -1.0;
+        REQUIRE(xtract_spectrum_batch(data, N, 0, hop, argv, batch) == XTRACT_SUCCESS);
+        REQUIRE(batch[0] == -1.0);
+    }
+}
+
 TEST_CASE("xtract_hps", "[scalar][spectral]")
 {
     SECTION("HPS finds fundamental of harmonic signal")
@@ -576,6 +696,47 @@ TEST_CASE("xtract_dct table reallocation", "[vector]")
     }
 }
 
+TEST_CASE("xtract_dct matches the direct sum at any size", "[vector]")
+{
+    /* Powers of two (Ooura), even and odd sizes (FFT based), and a Bluestein size */
+    const int sizes[] = {1, 2, 3, 4, 5, 7, 13, 16, 20, 26, 40, 64, 100, 127, 882, 1024};
+    double data[1024];
+    double result[1024];
+
+    for (int n = 0; n < 1024; ++n)
+        data[n] = sin(0.37 * n) + 0.25 * cos(2.1 * n) + 0.1;
+
+    /* Interleave sizes, each must still match */
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int N : sizes)
+        {
+            CAPTURE(N);
+            REQUIRE(xtract_dct(data, N, NULL, result) == XTRACT_SUCCESS);
+
+            for (int k = 0; k < N; ++k)
+            {
+                double expected = 0.0;
+                for (int m = 0; m < N; ++m)
+                    expected += data[m] * cos(M_PI * k * (m + 0.5) / N);
+
+                REQUIRE(result[k] == Approx(expected).margin(1e-11 * N));
+            }
+        }
+    }
+
+    SECTION("in place")
+    {
+        double copy[40];
+        std::memcpy(copy, data, sizeof(copy));
+        REQUIRE(xtract_dct(copy, 40, NULL, copy) == XTRACT_SUCCESS);
+        REQUIRE(xtract_dct(data, 40, NULL, result) == XTRACT_SUCCESS);
+
+        for (int k = 0; k < 40; ++k)
+            REQUIRE(copy[k] == result[k]);
+    }
+}
+
 TEST_CASE("xtract_odd_even_ratio divide-by-zero", "[scalar][edge-case]")
 {
     double result = 0.0;
@@ -844,6 +1005,148 @@ TEST_CASE("xtract_gfcc and xtract_gammatone_spectrogram", "[vector]")
     }
 }
 
+TEST_CASE("sparse filterbanks match the dense form", "[vector]")
+{
+    const int N = 512;
+    const int n_filters = 20;
+    double spectrum[2 * N];
+    double expected[n_filters];
+    double actual[n_filters];
+
+    /* Magnitudes in the first half, bin frequencies in the second */
+    for(int n = 0; n < N; n++)
+    {
+        spectrum[n] = 1.0 + 0.5 * sin(0.05 * n) + 0.25 * cos(0.31 * n);
+        spectrum[N + n] = n * 22050.0 / N;
+    }
+
+    double **tables = (double **)malloc(n_filters * sizeof(double *));
+    for(int i = 0; i < n_filters; i++)
+        tables[i] = (double *)calloc(N, sizeof(double));
+
+    xtract_mel_filter dense;
+    dense.n_filters = n_filters;
+    dense.filters = tables;
+
+    xtract_mel_filter sparse;
+
+    SECTION("mel")
+    {
+        REQUIRE(xtract_init_mfcc(N, 22050.0, XTRACT_EQUAL_GAIN, 20, 8000, n_filters, tables) == XTRACT_SUCCESS);
+        REQUIRE(xtract_init_mfcc_sparse(N, 22050.0, XTRACT_EQUAL_GAIN, 20, 8000, n_filters, &sparse) == XTRACT_SUCCESS);
+        REQUIRE(sparse.filters == NULL);
+
+        /* Triangular filters only cover a few bins each */
+        int support = 0;
+        for(int i = 0; i < n_filters; i++)
+            support += sparse.length[i];
+        REQUIRE(support < N * n_filters / 8);
+
+        xtract_mel_spectrogram(spectrum, N, &dense, expected);
+        REQUIRE(xtract_mel_spectrogram(spectrum, N, &sparse, actual) == XTRACT_SUCCESS);
+        for(int i = 0; i < n_filters; i++)
+            REQUIRE(actual[i] == Approx(expected[i]).margin(1e-12));
+
+        xtract_mfcc(spectrum, N, &dense, expected);
+        REQUIRE(xtract_mfcc(spectrum, N, &sparse, actual) == XTRACT_SUCCESS);
+        for(int i = 0; i < n_filters; i++)
+            REQUIRE(actual[i] == Approx(expected[i]).margin(1e-10));
+
+        xtract_spectral_subband_centroids(spectrum, N, &dense, expected);
+        REQUIRE(xtract_spectral_subband_centroids(spectrum, N, &sparse, actual) == XTRACT_SUCCESS);
+        for(int i = 0; i < n_filters; i++)
+            REQUIRE(actual[i] == Approx(expected[i]));
+
+        xtract_free_mel_filter(&sparse);
+        REQUIRE(sparse.weights == NULL);
+    }
+
+    SECTION("gammatone")
+    {
+        REQUIRE(xtract_init_gfcc(N, 22050.0, 20, 8000, n_filters, tables) == XTRACT_SUCCESS);
+        REQUIRE(xtract_init_gfcc_sparse(N, 22050.0, 20, 8000, n_filters, &sparse) == XTRACT_SUCCESS);
+
+        xtract_gammatone_spectrogram(spectrum, N, &dense, expected);
+        REQUIRE(xtract_gammatone_spectrogram(spectrum, N, &sparse, actual) == XTRACT_SUCCESS);
+        for(int i = 0; i < n_filters; i++)
+            REQUIRE(actual[i] == Approx(expected[i]).margin(1e-4));
+
+        xtract_free_mel_filter(&sparse);
+    }
+
+    for(int i = 0; i < n_filters; i++)
+        free(tables[i]);
+    free(tables);
+}
+
+TEST_CASE("xtract_cepstrum matches the separate MFCC stages", "[vector]")
+{
+    const int N = 512;
+    const int M = N >> 1;
+    const int n_filters = 24;
+    const int frames = 5;
+    const int hop = 200;
+    const int length = (frames - 1) * hop + N;
+    double data[length];
+    double windowed[N];
+    double spectrum[N];
+    double expected[frames * n_filters];
+    double actual[frames * n_filters];
+
+    for(int n = 0; n < length; n++)
+        data[n] = sin(0.07 * n) + 0.5 * sin(0.61 * n) + 0.1 * cos(1.9 * n);
+
+    double **tables = (double **)malloc(n_filters * sizeof(double *));
+    for(int i = 0; i < n_filters; i++)
+        tables[i] = (double *)calloc(M, sizeof(double));
+
+    xtract_mel_filter dense;
+    dense.n_filters = n_filters;
+    dense.filters = tables;
+    REQUIRE(xtract_init_mfcc(M, 22050.0, XTRACT_EQUAL_GAIN, 20, 10000, n_filters, tables) == XTRACT_SUCCESS);
+
+    const int spectrum_types[] = {XTRACT_MAGNITUDE_SPECTRUM, XTRACT_POWER_SPECTRUM};
+
+    for(int type : spectrum_types)
+    {
+        CAPTURE(type);
+        double argv[] = {44100.0 / N, (double)type, 0.0, 0.0};
+        double *window = xtract_init_window(N, XTRACT_HANN);
+
+        REQUIRE(xtract_init_fft(N, XTRACT_SPECTRUM) == XTRACT_SUCCESS);
+
+        for(int f = 0; f < frames; f++)
+        {
+            xtract_windowed(data + f * hop, N, window, windowed);
+            xtract_spectrum(windowed, N, argv, spectrum);
+            xtract_mfcc(spectrum, M, &dense, expected + f * n_filters);
+        }
+
+        xtract_cepstrum_state *state = xtract_cepstrum_state_new(N, XTRACT_HANN, type, &dense);
+        REQUIRE(state != NULL);
+
+        REQUIRE(xtract_cepstrum_batch(state, data, N, frames, hop, NULL, actual) == XTRACT_SUCCESS);
+        for(int i = 0; i < frames * n_filters; i++)
+            REQUIRE(actual[i] == Approx(expected[i]).margin(1e-9));
+
+        REQUIRE(xtract_cepstrum(state, data + hop, N, NULL, actual) == XTRACT_SUCCESS);
+        for(int i = 0; i < n_filters; i++)
+            REQUIRE(actual[i] == Approx(expected[n_filters + i]).margin(1e-9));
+
+        REQUIRE(xtract_cepstrum(state, data, N / 2, NULL, actual) == XTRACT_BAD_STATE);
+
+        xtract_cepstrum_state_delete(state);
+        xtract_free_window(window);
+    }
+
+    REQUIRE(xtract_cepstrum_state_new(N + 1, XTRACT_HANN, XTRACT_MAGNITUDE_SPECTRUM, &dense) == NULL);
+
+    xtract_free_fft();
+    for(int i = 0; i < n_filters; i++)
+        free(tables[i]);
+    free(tables);
+}
+
 TEST_CASE("xtract_init_fft DCT does not clobber MFCC", "[init]")
 {
     SECTION("initing DCT with size 4 should not reinit MFCC")